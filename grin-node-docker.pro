@@ -4,27 +4,76 @@ CONFIG += c++11
 
 INCLUDEPATH += \
     src \
+    src/chain \
     src/geo \
     src/config \
     src/grinnodemanager \
-    src/priceanalysis
+    src/logs \
+    src/polling \
+    src/pool \
+    src/priceanalysis \
+    src/utxo
 
 SOURCES += \
+    src/chain/chaincache.cpp \
+    src/chain/chainrpc.cpp \
+    src/chain/chaintimelinemodel.cpp \
+    src/chain/jsonrpcbatcher.cpp \
+    src/chain/kernelindex.cpp \
+    src/chain/ownerrpc.cpp \
+    src/chain/pmmrindexmap.cpp \
     src/config/config.cpp \
+    src/config/tomldocument.cpp \
+    src/grinnodemanager/eventstream.cpp \
     src/grinnodemanager/grinnodemanager.cpp \
+    src/grinnodemanager/logtailstream.cpp \
+    src/grinnodemanager/sseparser.cpp \
+    src/logs/logmodel.cpp \
+    src/polling/pollscheduler.cpp \
+    src/pool/poolmodel.cpp \
+    src/priceanalysis/candlemodel.cpp \
     src/priceanalysis/priceanalysismanager.cpp \
+    src/priceanalysis/seriespyramid.cpp \
+    src/priceanalysis/timeseries.cpp \
+    src/storage/appendlogstore.cpp \
+    src/utxo/utxomirror.cpp \
+    src/utxo/utxomodel.cpp \
     src/main.cpp \
-    src/geo/geolookup.cpp
+    src/geo/geocache.cpp \
+    src/geo/geolookup.cpp \
+    src/geo/georangetable.cpp
 
 wasm {
     QMAKE_LFLAGS += -s WASM=1
 }
 
 HEADERS += \
+    src/chain/chaincache.h \
+    src/chain/chainrpc.h \
+    src/chain/chaintimelinemodel.h \
+    src/chain/jsonrpcbatcher.h \
+    src/chain/kernelindex.h \
+    src/chain/ownerrpc.h \
+    src/chain/pmmrindexmap.h \
     src/config/config.h \
+    src/config/tomldocument.h \
+    src/geo/geocache.h \
     src/geo/geolookup.h \
+    src/geo/georangetable.h \
+    src/grinnodemanager/eventstream.h \
     src/grinnodemanager/grinnodemanager.h \
-    src/priceanalysis/priceanalysismanager.h
+    src/grinnodemanager/logtailstream.h \
+    src/grinnodemanager/sseparser.h \
+    src/logs/logmodel.h \
+    src/polling/pollscheduler.h \
+    src/pool/poolmodel.h \
+    src/priceanalysis/candlemodel.h \
+    src/priceanalysis/priceanalysismanager.h \
+    src/priceanalysis/seriespyramid.h \
+    src/priceanalysis/timeseries.h \
+    src/storage/appendlogstore.h \
+    src/utxo/utxomirror.h \
+    src/utxo/utxomodel.h
 
 
 
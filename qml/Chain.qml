@@ -1,6 +1,7 @@
 ﻿import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Grin 1.0   // ChainTimelineModel
 
 Item {
     id: root
@@ -19,15 +20,22 @@ Item {
 
     // Foreign API (set in main.cpp as nodeForeignApi context property)
     readonly property var foreignApi: nodeForeignApi
+    // Header paging / block bodies (set in main.cpp as chainRpc context property)
+    readonly property var chainApi: (typeof chainRpc !== "undefined") ? chainRpc : null
+    // Shared poll scheduler (set in main.cpp as pollScheduler context property)
+    readonly property var scheduler: (typeof pollScheduler !== "undefined") ? pollScheduler : null
 
     // Settings
-    property int lastCount: 100
     property int refreshIntervalMs: 5000
+    // With the controller event stream up, new blocks arrive as tip events and
+    // polling only acts as a safety net
+    readonly property bool eventsConnected: !!(nodeManager && nodeManager.eventsConnected)
+    readonly property int tipPollIntervalMs: eventsConnected ? 60000 : refreshIntervalMs
+    // tip event while hidden: refresh once the page is shown again
+    property bool tipStale: false
 
     // Chain state
     property var tip: ({ height: 0, lastBlockPushed: "", prevBlockToLast: "", totalDifficulty: 0 })
-    property var blocksRaw: []        // full objects including inputs/outputs/kernels
-    property var blocks: []           // simplified tile data (height/hash/tx counts)
 
     // Selection / details
     property int selectedIndex: -1
@@ -40,11 +48,14 @@ Item {
     readonly property int detailsMinimumHeight: compactLayout ? 520 : 320
     property string blockSearchText: ""
     property int pendingSearchHeight: -1
-    property bool pendingScrollToLeft: false
     property bool dummySelected: false
     property int detailsTabIndex: 0
     property bool awaitingTipUpdate: false
-    property bool awaitingBlocksUpdate: false
+    property int tipRequestId: -1
+    // chainRpc is shared with other pages; only our body fetch counts
+    property int bodyRequestId: -1
+    // Newest headers fetched together with the tip (one round trip)
+    readonly property int tipHeaderCount: 4
     property bool awaitingBlockLookup: false
     property int blockCadenceMs: 60000
     property double nowMs: Date.now()
@@ -100,7 +111,7 @@ Item {
         id: dummyCycleTimer
         interval: 33
         repeat: true
-        running: true
+        running: root.visible
         onTriggered: root.nowMs = Date.now()
     }
     function copyToClipboard(text) {
@@ -127,14 +138,16 @@ Item {
         selectedBlockHash = ""
         selectedBlockHeight = -1
     }
-    function selectRawIndex(rawIndex, resetTab) {
-        if (rawIndex < 0 || rawIndex >= blocksRaw.length)
+    function selectRow(row, resetTab) {
+        var raw = timeline.blockAt(row)
+        if (!raw)
             return
         hasUserSelection = true
         dummySelected = false
-        selectedIndex = rawIndex
-        detailsRaw = blocksRaw[rawIndex]
-        rememberSelection(blocksRaw[rawIndex])
+        selectedIndex = row
+        detailsRaw = raw
+        rememberSelection(raw)
+        timeline.requestBody(row)
         if (resetTab)
             setDetailsTab(0)
     }
@@ -172,38 +185,6 @@ Item {
         return text
     }
 
-    // ---------------------------------------------------
-    // Mapping: full block -> row tile
-    // ---------------------------------------------------
-    function simplifyBlockForRow(rb) {
-        var h = headerOf(rb)
-        function count(x){ return Array.isArray(x) ? x.length : (x && typeof x.length === "number" ? x.length : 0) }
-        return {
-            isDummy: false,
-            height: toNum(get(h,"height",0)),
-            hash: String(get(h,"hash","")),
-            timestamp: toTs(get(h,"timestamp",0)),
-            inputs: count(get(rb,"inputs",[])),
-            outputs: count(get(rb,"outputs",[])),
-            kernels: count(get(rb,"kernels",[])),
-            difficulty: toNum(get(h,"total_difficulty", get(h,"totalDifficulty",0)))
-        }
-    }
-
-    function latestDummyBlock() {
-        return {
-            isDummy: true,
-            rawIndex: -1,
-            height: tip.height > 0 ? (tip.height + 1) : 0,
-            hash: "",
-            timestamp: 0,
-            inputs: 0,
-            outputs: 0,
-            kernels: 0,
-            difficulty: 0
-        }
-    }
-
     function mapHeaderFromRaw(rb) {
         var h = headerOf(rb)
         return {
@@ -242,11 +223,12 @@ Item {
         return out
     }
 
-    function findSelectedIndex(rawBlocks, previousRaw) {
-        if (!rawBlocks || rawBlocks.length === 0)
+    function findSelectedIndex(previousRaw) {
+        if (timeline.count === 0)
             return -1
+        var firstRow = timeline.isLoaded(1) ? 1 : -1
         if (selectedBlockHash.length === 0 && selectedBlockHeight < 0 && !previousRaw)
-            return hasUserSelection ? -1 : 0
+            return hasUserSelection ? -1 : firstRow
 
         var previousHash = selectedBlockHash
         var previousHeight = selectedBlockHeight
@@ -259,61 +241,48 @@ Item {
                 previousHeight = toNum(get(previousHeader, "height", 0))
         }
 
-        for (var i = 0; i < rawBlocks.length; ++i) {
-            var candidateHeader = headerOf(rawBlocks[i])
-            if (previousHash.length > 0 && String(get(candidateHeader, "hash", "")) === previousHash)
-                return i
-        }
+        var row = previousHash.length > 0 ? timeline.indexOfHash(previousHash) : -1
+        if (row < 0 && previousHeight >= 0 && timeline.isLoaded(timeline.indexOfHeight(previousHeight)))
+            row = timeline.indexOfHeight(previousHeight)
+        if (row >= 0)
+            return row
 
-        for (var j = 0; j < rawBlocks.length; ++j) {
-            var header = headerOf(rawBlocks[j])
-            if (toNum(get(header, "height", 0)) === previousHeight)
-                return j
-        }
-
-        return hasUserSelection ? -1 : 0
+        return hasUserSelection ? -1 : firstRow
     }
 
     function findVisibleBlockIndex(query) {
-        var text = String(query || "").trim().toLowerCase()
-        if (!text)
-            return -1
-
-        var numericHeight = /^[0-9]+$/.test(text) ? Number(text) : -1
-        for (var i = 0; i < root.blocks.length; ++i) {
-            var blk = root.blocks[i]
-            var hash = String(blk.hash || "").toLowerCase()
-            if ((numericHeight >= 0 && blk.height === numericHeight)
-                    || (hash.length > 0 && (hash === text || hash.indexOf(text) === 0))) {
-                return i
-            }
-        }
-        return -1
+        return timeline.find(String(query || ""))
     }
 
     function scrollToVisibleIndex(visibleIndex) {
         if (visibleIndex < 0)
             return
-        var itemX = visibleIndex * (chainNodeWidth + chainConnectorWidth)
-        var targetX = Math.max(0, itemX - Math.max(16, Math.floor((flick.width - chainNodeWidth) / 2)))
-        flick.contentX = Math.min(targetX, Math.max(0, flick.contentWidth - flick.width))
+        chainList.positionViewAtIndex(visibleIndex, ListView.Center)
+        updateViewport()
     }
 
-    function loadBlocksAroundHeight(centerHeight) {
-        if (!foreignApi || centerHeight < 0)
+    // Visible rows -> timeline; pages load as the viewport approaches them
+    function updateViewport() {
+        if (timeline.count === 0)
             return
+        var y = chainList.height / 2
+        var first = chainList.indexAt(chainList.contentX + 1, y)
+        var last = chainList.indexAt(chainList.contentX + chainList.width - 1, y)
+        if (first < 0)
+            first = 0
+        if (last < 0)
+            last = Math.min(timeline.count - 1,
+                            first + Math.ceil(chainList.width / (chainNodeWidth + chainConnectorWidth)))
+        timeline.setViewport(first, last)
+    }
 
-        var halfWindow = Math.floor(lastCount / 2)
-        var start = Math.max(0, centerHeight - halfWindow)
-        var end = start + lastCount - 1
-
-        if (tip.height > 0 && end > tip.height) {
-            end = tip.height
-            start = Math.max(0, end - lastCount + 1)
-        }
+    function loadBlocksAroundHeight(centerHeight) {
+        if (centerHeight < 0)
+            return
 
-        awaitingBlocksUpdate = true
-        foreignApi.getBlocksAsync(start, end, lastCount, false)
+        // jumping there is enough: the page loads once it is in view
+        scrollToVisibleIndex(timeline.indexOfHeight(centerHeight))
+        Qt.callLater(finishBlocksUpdate)
     }
 
     function searchBlock() {
@@ -325,6 +294,13 @@ Item {
         }
 
         var visibleIndex = findVisibleBlockIndex(query)
+        if (visibleIndex >= 0 && !timeline.isLoaded(visibleIndex)) {
+            pendingSearchHeight = timeline.heightAt(visibleIndex)
+            root.hasUserSelection = true
+            loadBlocksAroundHeight(pendingSearchHeight)
+            status.show(tr("chain_search_loading", "Loading block..."))
+            return
+        }
         if (visibleIndex < 0) {
             if (/^[0-9]+$/.test(query)) {
                 pendingSearchHeight = Number(query)
@@ -348,7 +324,7 @@ Item {
         }
 
         root.hasUserSelection = true
-        root.selectRawIndex(root.blocks[visibleIndex].rawIndex, true)
+        root.selectRow(visibleIndex, true)
         setDetailsTab(0)
         Qt.callLater(function() { scrollToVisibleIndex(visibleIndex) })
         status.show(tr("chain_search_found", "Block selected."))
@@ -356,15 +332,15 @@ Item {
 
     function showLatestBlocks() {
         pendingSearchHeight = -1
-        pendingScrollToLeft = true
         hasUserSelection = false
         selectedIndex = -1
         dummySelected = true
         detailsRaw = null
         clearRememberedSelection()
         setDetailsTab(0)
-        if (tip.height > 0)
-            loadBlocksForTip(tip.height)
+        chainList.positionViewAtBeginning()
+        updateViewport()
+        Qt.callLater(finishBlocksUpdate)
     }
 
     function mapOutputsFromRaw(rb) {
@@ -415,8 +391,7 @@ Item {
     // ---------------------------------------------------
     function clearChainView() {
         tip = { height: 0, lastBlockPushed: "", prevBlockToLast: "", totalDifficulty: 0 }
-        blocksRaw = []
-        blocks = []
+        timeline.clear()
         selectedIndex = -1
         hasUserSelection = false
         dummySelected = false
@@ -437,50 +412,162 @@ Item {
             status.showError(tr("chain_err_foreign_api", "Foreign API not set."))
             return
         }
+        if (scheduler)
+            scheduler.markFresh("foreign.tip")
+        tipStale = false
         try {
             awaitingTipUpdate = true
-            foreignApi.getTipAsync()
+            if (chainApi)
+                tipRequestId = chainApi.refreshTipAsync(tipHeaderCount)
+            else
+                foreignApi.getTipAsync()
         } catch(e) {
             awaitingTipUpdate = false
             status.showError(tr("chain_err_get_tip", "getTipAsync failed: %1").replace("%1", e))
         }
     }
 
-    function loadBlocksForTip(h) {
-        if (!foreignApi) return
-        var start = Math.max(0, h - (lastCount - 1))
-        try {
-            awaitingBlocksUpdate = true
-            foreignApi.getBlocksAsync(start, h, lastCount, false)
-        } catch(e) {
-            awaitingBlocksUpdate = false
-            status.showError(tr("chain_err_get_blocks", "getBlocksAsync failed: %1").replace("%1", e))
+    // Tip plus the newest headers from the same round trip (headers may be empty)
+    function applyTip(payload, headers) {
+        var t = payload || {}
+        var h  = get(t,"height",0)
+        var lb = get(t,"lastBlockPushed", get(t,"last_block_pushed",""))
+        var pv = get(t,"prevBlockToLast", get(t,"prev_block_to_last",""))
+        var td = get(t,"totalDifficulty", get(t,"total_difficulty",0))
+        tip = {
+            height: toNum(h),
+            lastBlockPushed: String(lb || ""),
+            prevBlockToLast: String(pv || ""),
+            totalDifficulty: toNum(td)
+        }
+
+        if (tip.height > 0) {
+            timeline.applyTip(tip, headers || [])
+        } else {
+            timeline.clear()
+            selectedIndex = -1
+        }
+    }
+
+    // Called by the timeline for the missing heights of a page
+    function fetchPage(start, end) {
+        if (!chainApi) {
+            timeline.pageFailed(start, end)
+            return
+        }
+        chainApi.getHeadersAsync(start, end)
+    }
+
+    // Selection / search state after pages arrived or the tip moved
+    function finishBlocksUpdate() {
+        if (pendingSearchHeight >= 0) {
+            var searchedIndex = timeline.indexOfHeight(pendingSearchHeight)
+            if (searchedIndex >= 0 && timeline.isLoaded(searchedIndex)) {
+                selectRow(searchedIndex, true)
+                setDetailsTab(0)
+                scrollToVisibleIndex(searchedIndex)
+                status.show(tr("chain_search_found", "Block selected."))
+                pendingSearchHeight = -1
+            } else if (searchedIndex < 0 || !timeline.fetching) {
+                selectedIndex = findSelectedIndex(selectedRaw)
+                status.showError(tr("chain_search_not_found", "Block not found in the loaded range."))
+                pendingSearchHeight = -1
+            }
+        } else {
+            selectedIndex = findSelectedIndex(selectedRaw)
+        }
+    }
+
+    // Paged timeline over heights 0..tip: headers per page, bodies on selection
+    ChainTimelineModel {
+        id: timeline
+        onPageRequested: function(start, end) { root.fetchPage(start, end) }
+        onPageCancelled: function(start, end) {
+            if (root.chainApi)
+                root.chainApi.abortHeaders(start, end)
+        }
+        onRangeLoaded: Qt.callLater(root.finishBlocksUpdate)
+        onFetchingChanged: if (!fetching) Qt.callLater(root.finishBlocksUpdate)
+        onCountChanged: {
+            Qt.callLater(root.updateViewport)
+            Qt.callLater(root.finishBlocksUpdate)
+        }
+        onBodyRequested: function(start, end) {
+            if (root.chainApi)
+                root.bodyRequestId = root.chainApi.getBlocksAsync(start, end)
+            else
+                timeline.bodyFetchFailed()
+        }
+        onBodyAvailable: function(hash) {
+            if (hash !== root.selectedBlockHash.toLowerCase())
+                return
+            var row = timeline.indexOfHash(hash)
+            if (row >= 0)
+                root.detailsRaw = timeline.blockAt(row)
         }
     }
 
     // ---------------------------------------------------
     // Lifecycle / timers
     // ---------------------------------------------------
-    Component.onCompleted: if (nodeRunning && foreignApi) refreshTip()
-    onForeignApiChanged: if (foreignApi && nodeRunning) refreshTip()
+    // Tip polling through the shared scheduler; paused while the page is hidden.
+    // A new or re-shown subscription with stale data is polled right away.
+    readonly property bool tipPollingActive: nodeRunning && !!foreignApi
+    function updateTipPolling() {
+        if (!scheduler)
+            return
+        if (tipPollingActive)
+            scheduler.subscribe("foreign.tip", root, tipPollIntervalMs, root.visible)
+        else
+            scheduler.unsubscribe("foreign.tip", root)
+    }
 
-    Timer {
-        id: autoTimer
-        interval: refreshIntervalMs
-        repeat: true
-        running: nodeRunning && !!foreignApi
-        onTriggered: if (nodeRunning) refreshTip()
+    Component.onCompleted: updateTipPolling()
+    onTipPollingActiveChanged: updateTipPolling()
+    onVisibleChanged: {
+        if (visible && tipStale && tipPollingActive)
+            refreshTip()
+        updateTipPolling()
     }
+    onTipPollIntervalMsChanged: updateTipPolling()
 
     onNodeRunningChanged: {
-        if (nodeRunning && foreignApi) {
-            refreshTip()
-        } else {
+        if (!nodeRunning) {
             // Node aus -> UI leeren
             clearChainView()
         }
     }
 
+    Connections {
+        target: root.scheduler
+        ignoreUnknownSignals: true
+
+        function onPoll(topic) {
+            if (topic === "foreign.tip" && nodeRunning)
+                refreshTip()
+        }
+    }
+
+    Connections {
+        target: root.nodeManager
+        ignoreUnknownSignals: true
+
+        function onTipChanged(tip) {
+            if (!root.tipPollingActive)
+                return
+            if (root.visible)
+                refreshTip()
+            else
+                root.tipStale = true
+        }
+
+        function onEventsResynced() {
+            root.tipStale = true
+            if (root.visible && root.tipPollingActive)
+                refreshTip()
+        }
+    }
+
     // ---------------------------------------------------
     // Signals from foreign API
     // ---------------------------------------------------
@@ -488,78 +575,12 @@ Item {
         target: (typeof foreignApi === "object" && foreignApi) ? foreignApi : null
         ignoreUnknownSignals: true
 
+        // Only without chainRpc; otherwise the tip arrives via onTipRefreshed
         function onTipUpdated(payload) {
-            if (!awaitingTipUpdate)
+            if (!awaitingTipUpdate || root.chainApi)
                 return
             awaitingTipUpdate = false
-            var t = payload || {}
-            var h  = get(t,"height",0)
-            var lb = get(t,"lastBlockPushed", get(t,"last_block_pushed",""))
-            var pv = get(t,"prevBlockToLast", get(t,"prev_block_to_last",""))
-            var td = get(t,"totalDifficulty", get(t,"total_difficulty",0))
-            tip = {
-                height: toNum(h),
-                lastBlockPushed: String(lb || ""),
-                prevBlockToLast: String(pv || ""),
-                totalDifficulty: toNum(td)
-            }
-
-            if (tip.height > 0) {
-                Qt.callLater(function() {
-                    loadBlocksForTip(tip.height)
-                })
-            } else {
-                blocksRaw = []
-                blocks = []
-                    selectedIndex = -1
-                }
-        }
-
-        function onBlocksUpdated(blockList, lastRetrievedHeight) {
-            if (!awaitingBlocksUpdate)
-                return
-            awaitingBlocksUpdate = false
-            var previousRaw = selectedRaw
-
-            blocksRaw = blockList || []
-
-            var simple = []
-            for (var i = 0; i < blocksRaw.length; ++i) {
-                var s = simplifyBlockForRow(blocksRaw[i])
-                s.rawIndex = i
-                simple.push(s)
-            }
-            simple.sort(function(a,b){ return b.height - a.height })
-            root.blocks = [latestDummyBlock()].concat(simple)
-
-            Qt.callLater(function() {
-                if (pendingSearchHeight >= 0) {
-                    var searchedIndex = -1
-                    for (var i = 0; i < root.blocks.length; ++i) {
-                        if (root.blocks[i].height === pendingSearchHeight) {
-                            searchedIndex = i
-                            break
-                        }
-                    }
-
-                    if (searchedIndex >= 0) {
-                        selectRawIndex(root.blocks[searchedIndex].rawIndex, true)
-                        setDetailsTab(0)
-                        scrollToVisibleIndex(searchedIndex)
-                        status.show(tr("chain_search_found", "Block selected."))
-                    } else {
-                        selectedIndex = findSelectedIndex(blocksRaw, previousRaw)
-                        status.showError(tr("chain_search_not_found", "Block not found in the loaded range."))
-                    }
-                    pendingSearchHeight = -1
-                } else {
-                    selectedIndex = findSelectedIndex(blocksRaw, previousRaw)
-                }
-                if (pendingScrollToLeft) {
-                    flick.contentX = 0
-                    pendingScrollToLeft = false
-                }
-            })
+            root.applyTip(payload, [])
         }
 
         function onBlockUpdated(block) {
@@ -587,6 +608,51 @@ Item {
         }
     }
 
+    // ---------------------------------------------------
+    // Signals from chainRpc (headers / bodies)
+    // ---------------------------------------------------
+    Connections {
+        target: root.chainApi
+        ignoreUnknownSignals: true
+
+        function onTipRefreshed(requestId, tipMap, headers) {
+            if (requestId !== root.tipRequestId)
+                return
+            root.awaitingTipUpdate = false
+            root.applyTip(tipMap, headers)
+        }
+
+        function onTipRefreshFailed(requestId, message) {
+            if (requestId !== root.tipRequestId)
+                return
+            root.awaitingTipUpdate = false
+            status.showError(tr("chain_err_get_tip", "getTipAsync failed: %1").replace("%1", message))
+        }
+
+        function onHeadersUpdated(start, end, headers) {
+            timeline.applyHeaders(start, end, headers || [])
+        }
+
+        function onHeadersLookupFailed(start, end, message) {
+            timeline.pageFailed(start, end)
+            status.showError(tr("chain_err_get_blocks", "getBlocksAsync failed: %1").replace("%1", message))
+        }
+
+        function onBlocksUpdated(requestId, blockList, lastRetrievedHeight) {
+            if (requestId !== root.bodyRequestId)
+                return
+            root.bodyRequestId = -1
+            timeline.applyBodies(blockList || [])
+        }
+
+        function onBlocksLookupFailed(requestId, message) {
+            if (requestId !== root.bodyRequestId)
+                return
+            root.bodyRequestId = -1
+            timeline.bodyFetchFailed()
+        }
+    }
+
     // ---------------------------------------------------
     // UI layout
     // ---------------------------------------------------
@@ -659,7 +725,7 @@ Item {
                     }
 
                     Label {
-                        text: blocks.length
+                        text: timeline.tipHeight > 0 ? timeline.tipHeight + 1 : 0
                         color: "white"
                         font.bold: true
                     }
@@ -703,52 +769,39 @@ Item {
                 border.color: "transparent"
             }
 
-            Flickable {
-                id: flick
+            // Only the delegates in view (plus cacheBuffer) exist; rows
+            // outside loaded pages show their height until the page arrives.
+            ListView {
+                id: chainList
                 anchors.fill: parent
                 clip: true
+                orientation: ListView.Horizontal
                 boundsBehavior: Flickable.StopAtBounds
-                interactive: true
-
-                contentWidth: Math.max(chainContent.width, width)
-                contentHeight: height
-
-                Item {
-                    id: chainContent
-                    width: Array.isArray(root.blocks) && root.blocks.length > 0
-                           ? (root.blocks.length * root.chainNodeWidth)
-                             + ((root.blocks.length - 1) * root.chainConnectorWidth)
-                           : flick.width
-                    height: parent.height
-
-                    Row {
-                        id: chainRow
-                        spacing: 0
-                        height: parent.height
-
-                        Repeater {
-                            model: Array.isArray(root.blocks) ? root.blocks.length : 0
-                            delegate: ChainNode {
-                                nodeWidth: root.chainNodeWidth
-                                nodeHeight: 120
-                                connectorWidth: root.chainConnectorWidth
-                                depthProgress: root.blocks.length > 1
-                                               ? (index / Math.max(1, root.blocks.length - 1))
-                                               : 0
-                                blk: root.blocks[index]
-                                showConnector: index < (root.blocks.length - 1)
-                                onClickedBlock: {
-                                    if (blk.isDummy) {
-                                        showLatestBlocks()
-                                    } else {
-                                        root.selectRawIndex(blk.rawIndex, false)
-                                    }
-                                }
-                            }
+                cacheBuffer: 2 * (root.chainNodeWidth + root.chainConnectorWidth)
+                reuseItems: true
+                model: timeline
+
+                delegate: ChainNode {
+                    nodeWidth: root.chainNodeWidth
+                    nodeHeight: 120
+                    connectorWidth: root.chainConnectorWidth
+                    depthProgress: chainList.width > 0
+                                   ? Math.max(0, Math.min(1, (x - chainList.contentX) / chainList.width))
+                                   : 0
+                    blk: model
+                    showConnector: index < (timeline.count - 1)
+                    onClickedBlock: {
+                        if (blk.isDummy) {
+                            showLatestBlocks()
+                        } else if (blk.loaded) {
+                            root.selectRow(index, false)
                         }
                     }
                 }
 
+                onContentXChanged: Qt.callLater(root.updateViewport)
+                onWidthChanged: Qt.callLater(root.updateViewport)
+
                 ScrollBar.horizontal: ScrollBar { policy: ScrollBar.AsNeeded }
             }
         }
@@ -1116,7 +1169,7 @@ Item {
 
         // Loading hint at startup
         Label {
-            visible: blocks.length === 0 && tip.height === 0
+            visible: timeline.count === 0 && tip.height === 0
             text: tr("chain_loading_tip", "Loading tip...")
             color: "#888"
             horizontalAlignment: Text.AlignHCenter
@@ -1532,9 +1585,9 @@ Item {
                       ? tr("chain_dummy_info", "Click to return to latest blocks")
                       : (blk
                       ? (tr("chain_tile_stats", "In:%1  Out:%2  Ker:%3")
-                         .replace("%1", blk.inputs)
-                         .replace("%2", blk.outputs)
-                         .replace("%3", blk.kernels))
+                         .replace("%1", blk.inputs < 0 ? "?" : blk.inputs)
+                         .replace("%2", blk.outputs < 0 ? "?" : blk.outputs)
+                         .replace("%3", blk.kernels < 0 ? "?" : blk.kernels))
                       : ""
 )
                 color: "#dddddd"
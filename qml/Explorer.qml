@@ -10,10 +10,15 @@ Item {
     property bool compactLayout: false
     property var i18n: null
     readonly property var foreignApi: nodeForeignApi
+    // Block/header lookups with persistent cache (set in main.cpp as chainRpc context property)
+    readonly property var chainApi: (typeof chainRpc !== "undefined") ? chainRpc : null
+    readonly property var lookupApi: chainApi ? chainApi : foreignApi
 
     property int modeIndex: 0
     property bool loading: false
     property bool loadingDefaults: false
+    property int defaultsRequestId: -1
+    property int kernelRequestId: -1
     property string errorText: ""
     property var blockResult: null
     property var headerResult: null
@@ -167,7 +172,10 @@ Item {
                 errorText = tr("explorer_err_block_input", "Enter a block height or block hash.")
                 return
             }
-            foreignApi.getBlockAsync(blockHeight, hashText, "")
+            if (chainApi)
+                chainApi.getBlockAsync(blockHeight, hashText)
+            else
+                foreignApi.getBlockAsync(blockHeight, hashText, "")
             return
         }
 
@@ -178,7 +186,10 @@ Item {
                 errorText = tr("explorer_err_header_input", "Enter a header height or header hash.")
                 return
             }
-            foreignApi.getHeaderAsync(headerHeight, hashText, "")
+            if (chainApi)
+                chainApi.getHeaderAsync(headerHeight, hashText)
+            else
+                foreignApi.getHeaderAsync(headerHeight, hashText, "")
             return
         }
 
@@ -191,12 +202,17 @@ Item {
         if (maxHeight > 0 && maxHeight < minHeight)
             maxHeight = minHeight
 
-        foreignApi.getKernelAsync(excessText, minHeight, maxHeight)
+        // chainRpc answers known kernels with a one-block query and skips the indexed range
+        if (chainApi && typeof chainApi.findKernelAsync === "function")
+            kernelRequestId = chainApi.findKernelAsync(excessText, minHeight, maxHeight)
+        else
+            foreignApi.getKernelAsync(excessText, minHeight, maxHeight)
     }
 
     Connections {
-        target: foreignApi
-        enabled: !!foreignApi
+        target: lookupApi
+        enabled: !!lookupApi
+        ignoreUnknownSignals: true
 
         function onBlockUpdated(block) {
             if (loadingDefaults) {
@@ -227,12 +243,21 @@ Item {
             headerResult = header
         }
 
+        function onHeaderUpdated(header) {
+            onHeaderUpdatedQml(header)
+        }
+
         function onHeaderLookupFailed(message) {
             loading = false
             errorText = message && String(message).length > 0
                     ? String(message)
                     : tr("explorer_err_header_failed", "Header lookup failed.")
         }
+    }
+
+    Connections {
+        target: foreignApi
+        enabled: !!foreignApi
 
         function onKernelUpdatedQml(kernel) {
             loading = false
@@ -247,16 +272,62 @@ Item {
                     : tr("explorer_err_kernel_failed", "Kernel lookup failed.")
         }
 
+        // Only without chainRpc; otherwise tip and block arrive together via onTipRefreshed
         function onTipUpdated(tip) {
-            if (!foreignApi || !tip || Number(tip.height || 0) <= 0)
+            if (chainApi || !tip || Number(tip.height || 0) <= 0)
                 return
             loadingDefaults = true
             foreignApi.getBlockAsync(Number(tip.height || 0), "", "")
         }
     }
 
+    Connections {
+        target: chainApi
+        enabled: !!chainApi
+        ignoreUnknownSignals: true
+
+        function onTipRefreshed(requestId, tip, blocks) {
+            if (requestId !== defaultsRequestId)
+                return
+            defaultsRequestId = -1
+            if (!tip || Number(tip.height || 0) <= 0)
+                return
+            if (blocks && blocks.length > 0) {
+                latestBlockData = blocks[blocks.length - 1]
+                applyDefaultsFromLatestBlock()
+            } else {
+                loadingDefaults = true
+                chainApi.getBlockAsync(Number(tip.height || 0), "")
+            }
+        }
+
+        function onTipRefreshFailed(requestId, message) {
+            if (requestId === defaultsRequestId)
+                defaultsRequestId = -1
+        }
+
+        function onKernelUpdated(requestId, kernel) {
+            if (requestId !== kernelRequestId)
+                return
+            loading = false
+            errorText = ""
+            kernelResult = kernel
+        }
+
+        function onKernelLookupFailed(requestId, message) {
+            if (requestId !== kernelRequestId)
+                return
+            loading = false
+            errorText = message && String(message).length > 0
+                    ? String(message)
+                    : tr("explorer_err_kernel_failed", "Kernel lookup failed.")
+        }
+    }
+
     Component.onCompleted: {
-        if (foreignApi)
+        if (chainApi)
+            defaultsRequestId = chainApi.refreshTipAsync(1, true)
+        else if (foreignApi)
             foreignApi.getTipAsync()
     }
 
@@ -371,6 +442,26 @@ Item {
                             onClicked: root.triggerSearch()
                         }
 
+                        CheckBox {
+                            visible: root.modeIndex === 2 && !!root.chainApi
+                            text: tr("explorer_kernel_backfill", "Index kernels in background")
+                            checked: root.chainApi ? root.chainApi.kernelBackfill : false
+                            onToggled: if (root.chainApi) root.chainApi.kernelBackfill = checked
+                        }
+
+                        Label {
+                            Layout.fillWidth: true
+                            visible: root.modeIndex === 2 && !!root.chainApi && root.chainApi.kernelIndexLow >= 0
+                            text: root.chainApi
+                                  ? tr("explorer_kernel_index", "%1 kernels indexed, heights %2-%3")
+                                    .replace("%1", root.chainApi.kernelIndexSize)
+                                    .replace("%2", root.chainApi.kernelIndexLow)
+                                    .replace("%3", root.chainApi.kernelIndexHigh)
+                                  : ""
+                            color: "#8c8c8c"
+                            elide: Text.ElideRight
+                        }
+
                         BusyIndicator {
                             running: root.loading
                             visible: root.loading
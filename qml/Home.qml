@@ -7,7 +7,7 @@ import Grin 1.0   // GrinNodeManager
 // Home page (Dashboard)
 // - shows node start/stop controls
 // - shows uptime and basic status
-// - drives polling for status/peers (via nodeOwnerApi)
+// - drives polling for status/peers (via ownerRpc)
 // - fully language-aware via i18n.t(...)
 // =====================================================================
 Item {
@@ -97,6 +97,20 @@ Item {
     property bool   peersPollingActive: false
     property bool   initialOwnerApiCheckStarted: false
 
+    // Shared poll scheduler (set in main.cpp as pollScheduler context property)
+    readonly property var scheduler: (typeof pollScheduler !== "undefined") ? pollScheduler : null
+    // Owner status drives nodeRunning for all pages, so it keeps polling while
+    // Home is hidden; connected peers only while Home (or the map) is shown.
+    // With the controller event stream up, tip and peer events trigger the
+    // refresh and the intervals only act as a safety net.
+    readonly property bool eventsConnected: !!(mgr && mgr.eventsConnected)
+    property int ownerStatusIntervalMs: eventsConnected ? 30000 : 10000
+    property int connectedPeersIntervalMs: eventsConnected ? 60000 : 5000
+    // Owner calls go through ownerRpc (batched per poll tick, see main.cpp)
+    readonly property var ownerSource: (typeof ownerRpc !== "undefined") ? ownerRpc : null
+    readonly property bool schedulerStatusPolling: scheduler !== null && ownerSource !== null
+    readonly property bool schedulerPeersPolling: scheduler !== null && ownerSource !== null
+
     // Uptime label and seconds (for the currently running node)
     property string nodeUptimeLabel: ""
     property int    nodeUptimeSeconds: -1
@@ -181,18 +195,19 @@ Item {
         if (controllerStatusPollingActive || !mgr)
             return
         mgr.startStatusPolling(10000)
+        if (typeof mgr.startEvents === "function")
+            mgr.startEvents()
         controllerStatusPollingActive = true
     }
 
     function ensureNodeOwnerStatusPolling(forceNow) {
-        if (typeof nodeOwnerApi !== "undefined" && nodeOwnerApi) {
-            if (!nodeOwnerStatusPollingActive
-                    && typeof nodeOwnerApi.startStatusPolling === "function") {
-                nodeOwnerApi.startStatusPolling(10000)
-                nodeOwnerStatusPollingActive = true
-            } else if (forceNow && typeof nodeOwnerApi.getStatusAsync === "function") {
-                nodeOwnerApi.getStatusAsync()
-            }
+        if (!schedulerStatusPolling)
+            return
+        if (!nodeOwnerStatusPollingActive) {
+            scheduler.subscribe("owner.status", homeRoot, ownerStatusIntervalMs, true)
+            nodeOwnerStatusPollingActive = true
+        } else if (forceNow) {
+            scheduler.pollNow("owner.status")
         }
     }
 
@@ -209,30 +224,40 @@ Item {
 
     function startDirectNodeApiPolling() {
         ensureNodeOwnerStatusPolling(false)
-        if (typeof nodeOwnerApi !== "undefined" && nodeOwnerApi) {
-            if (!peersPollingActive
-                    && typeof nodeOwnerApi.startConnectedPeersPolling === "function") {
-                nodeOwnerApi.startConnectedPeersPolling(5000)
-                peersPollingActive = true
-            }
+        if (peersPollingActive)
+            return
+        if (schedulerPeersPolling) {
+            scheduler.subscribe("owner.connectedPeers", homeRoot, connectedPeersIntervalMs, homeRoot.visible)
+            peersPollingActive = true
         }
     }
 
     function stopStatusAndPeersPolling() {
-        if (typeof nodeOwnerApi !== "undefined" && nodeOwnerApi) {
-            if (nodeOwnerStatusPollingActive
-                    && typeof nodeOwnerApi.stopStatusPolling === "function") {
-                nodeOwnerApi.stopStatusPolling()
-                nodeOwnerStatusPollingActive = false
-            }
-            if (peersPollingActive
-                    && typeof nodeOwnerApi.stopConnectedPeersPolling === "function") {
-                nodeOwnerApi.stopConnectedPeersPolling()
-                peersPollingActive = false
-            }
+        if (nodeOwnerStatusPollingActive) {
+            scheduler.unsubscribe("owner.status", homeRoot)
+            nodeOwnerStatusPollingActive = false
+        }
+        if (peersPollingActive) {
+            scheduler.unsubscribe("owner.connectedPeers", homeRoot)
+            peersPollingActive = false
         }
     }
 
+    onVisibleChanged: {
+        if (peersPollingActive && schedulerPeersPolling)
+            scheduler.setVisible("owner.connectedPeers", homeRoot, homeRoot.visible)
+    }
+
+    onOwnerStatusIntervalMsChanged: {
+        if (nodeOwnerStatusPollingActive && schedulerStatusPolling)
+            scheduler.subscribe("owner.status", homeRoot, ownerStatusIntervalMs, true)
+    }
+
+    onConnectedPeersIntervalMsChanged: {
+        if (peersPollingActive && schedulerPeersPolling)
+            scheduler.subscribe("owner.connectedPeers", homeRoot, connectedPeersIntervalMs, homeRoot.visible)
+    }
+
     // -----------------------------------------------------------------
     // Apply controller status payload
     // -----------------------------------------------------------------
@@ -345,6 +370,12 @@ Item {
         controllerError = false
         controllerErrorOverlay.visible = false
 
+        // Controller-Polling beschleunigt sich, solange der Node synchronisiert
+        if (mgr) {
+            var syncStatus = normalized.sync_status || normalized.syncStatus || ""
+            mgr.nodeSyncing = syncStatus !== "" && syncStatus !== "no_sync"
+        }
+
         if (nodeState === "none" || nodeState === "rustStarting" || nodeState === "grinppStarting") {
             nodeState = "external"
             requestInFlight = false
@@ -615,6 +646,16 @@ Item {
                         i18n: homeRoot.i18n
                         nodeManager: homeRoot.mgr
                     }
+
+                    LogView {
+                        Layout.fillWidth: true
+                        Layout.preferredHeight: 420
+                        Layout.minimumHeight: 280
+                        visible: homeRoot.isRustRunning() || homeRoot.isGrinppRunning()
+                        i18n: homeRoot.i18n
+                        nodeManager: homeRoot.mgr
+                        nodeKind: visible ? homeRoot.nodeState : "none"
+                    }
                 }
             }
         }
@@ -689,6 +730,23 @@ Item {
             applyControllerStatus(statusObj)
         }
 
+        // Pushed events: refresh right away instead of waiting for the next poll
+        function onTipChanged(tip) {
+            if (homeRoot.nodeOwnerStatusPollingActive && homeRoot.schedulerStatusPolling)
+                homeRoot.scheduler.pollNow("owner.status")
+        }
+
+        function onPeerChanged(peer) {
+            if (homeRoot.peersPollingActive && homeRoot.schedulerPeersPolling
+                    && homeRoot.scheduler.intervalOf("owner.connectedPeers") > 0)
+                homeRoot.scheduler.pollNow("owner.connectedPeers")
+        }
+
+        function onEventsResynced() {
+            if (homeRoot.nodeOwnerStatusPollingActive && homeRoot.schedulerStatusPolling)
+                homeRoot.scheduler.pollNow("owner.status")
+        }
+
         function onErrorOccurred(msg) {
             if (homeRoot.directNodeApiReachable)
                 return
@@ -721,10 +779,23 @@ Item {
     }
 
     Connections {
-        target: nodeOwnerApi
+        target: homeRoot.ownerSource
+        ignoreUnknownSignals: true
 
         function onStatusUpdated(statusObj) {
             applyDirectNodeApiStatus(statusObj)
         }
     }
+
+    Connections {
+        target: homeRoot.scheduler
+        ignoreUnknownSignals: true
+
+        function onPoll(topic) {
+            if (topic === "owner.status" && homeRoot.nodeOwnerStatusPollingActive)
+                homeRoot.ownerSource.getStatusAsync()
+            else if (topic === "owner.connectedPeers" && homeRoot.peersPollingActive)
+                homeRoot.ownerSource.getConnectedPeersAsync()
+        }
+    }
 }
@@ -0,0 +1,208 @@
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Layouts 1.15
+import Grin 1.0   // GrinNodeManager, LogModel
+
+// ----------------------------------------------------------------------
+// LogView
+// Live tail of the node log. Lines are kept in a C++ ring buffer
+// (LogModel) and rendered by a recycling ListView, so only the visible
+// rows exist as QML items. Level/module filter and search run in C++.
+// ----------------------------------------------------------------------
+Rectangle {
+    id: root
+    color: "#2b2b2b"
+    radius: 6
+    border.color: "#555"
+    border.width: 1
+
+    // ------------------------------------------------------------------
+    // Public API
+    // ------------------------------------------------------------------
+    property var i18n: null         // injected from Main.qml
+    property var nodeManager: null  // GrinNodeManager
+    property string nodeKind: "none" // "rust" | "grinpp" | other = no tail
+    property int maxLines: 100000
+
+    // Follow the end of the log while new lines arrive
+    property bool follow: true
+
+    property int headingFontSize: root.width < 640 ? 16 : 20
+    property int dataFontSize:    root.width < 640 ? 11 : 13
+
+    function tr(key, fallback) {
+        if (!i18n || typeof i18n.t !== "function")
+            return fallback || key
+
+        var _ = i18n.language
+        return i18n.t(key)
+    }
+
+    function levelColor(level) {
+        if (level === "ERROR")
+            return "#ff6b6b"
+        if (level === "WARN")
+            return "#ffcc66"
+        if (level === "DEBUG" || level === "TRACE")
+            return "#888888"
+        return "#dddddd"
+    }
+
+    // ------------------------------------------------------------------
+    // Tail lifecycle: restart the stream whenever the running node changes
+    // ------------------------------------------------------------------
+    function restartTail() {
+        if (!nodeManager)
+            return
+        nodeManager.stopLogTail()
+        logModel.clear()
+        if (nodeKind === "rust")
+            nodeManager.tailLogsRust(-1, 500)
+        else if (nodeKind === "grinpp")
+            nodeManager.tailLogsGrinPP(-1, 500)
+    }
+
+    onNodeKindChanged: restartTail()
+    onNodeManagerChanged: restartTail()
+    Component.onDestruction: {
+        if (nodeManager)
+            nodeManager.stopLogTail()
+    }
+
+    LogModel {
+        id: logModel
+        capacity: root.maxLines
+    }
+
+    Connections {
+        target: nodeManager
+
+        function onLogLinesAppended(kind, lines, cursor) {
+            logModel.appendLines(lines)
+        }
+
+        // getLogs() replies requested elsewhere would replace the live tail
+        function onLogsReceived(text) {
+            if (nodeManager.logTailActive)
+                return
+            logModel.setText(text)
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Main content layout
+    // ------------------------------------------------------------------
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: 16
+        spacing: 12
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 8
+
+            Label {
+                text: tr("logview_title", "Node Log")
+                font.pixelSize: headingFontSize
+                font.bold: true
+                color: "white"
+            }
+
+            Item { Layout.fillWidth: true }
+
+            Label {
+                text: logModel.count + " / " + logModel.totalLines
+                font.pixelSize: dataFontSize
+                color: "#aaaaaa"
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 8
+
+            ComboBox {
+                id: levelBox
+                Layout.preferredWidth: 120
+                // LogModel.Level: 0 = all, 3 = INFO, 4 = WARN, 5 = ERROR
+                model: [
+                    { text: tr("logview_level_all", "All levels"), value: 0 },
+                    { text: "INFO+", value: 3 },
+                    { text: "WARN+", value: 4 },
+                    { text: "ERROR", value: 5 }
+                ]
+                textRole: "text"
+                valueRole: "value"
+                onActivated: logModel.minLevel = currentValue
+            }
+
+            ComboBox {
+                id: moduleBox
+                Layout.preferredWidth: 220
+                model: [tr("logview_module_all", "All modules")].concat(logModel.modules)
+                onActivated: logModel.moduleFilter = (currentIndex <= 0) ? "" : currentText
+            }
+
+            TextField {
+                id: searchField
+                Layout.fillWidth: true
+                placeholderText: tr("logview_search", "Search...")
+                color: "white"
+                onTextChanged: searchDebounce.restart()
+
+                Timer {
+                    id: searchDebounce
+                    interval: 200
+                    onTriggered: logModel.searchText = searchField.text
+                }
+            }
+
+            CheckBox {
+                text: tr("logview_follow", "Follow")
+                checked: root.follow
+                onToggled: root.follow = checked
+                contentItem: Text {
+                    text: parent.text
+                    color: "white"
+                    leftPadding: parent.indicator.width + parent.spacing
+                    verticalAlignment: Text.AlignVCenter
+                }
+            }
+        }
+
+        Rectangle {
+            height: 1
+            color: "#555"
+            Layout.fillWidth: true
+        }
+
+        ListView {
+            id: logList
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            clip: true
+            model: logModel
+            reuseItems: true
+            boundsBehavior: Flickable.StopAtBounds
+
+            ScrollBar.vertical: ScrollBar { policy: ScrollBar.AsNeeded }
+
+            // Scrolling up pauses follow mode, returning to the end resumes it
+            onMovementEnded: root.follow = atYEnd
+            onCountChanged: {
+                if (root.follow)
+                    Qt.callLater(logList.positionViewAtEnd)
+            }
+
+            delegate: Text {
+                width: logList.width
+                text: model.text
+                color: root.levelColor(model.level)
+                font.family: "monospace"
+                font.pixelSize: root.dataFontSize
+                elide: Text.ElideRight
+                textFormat: Text.PlainText
+            }
+        }
+    }
+}
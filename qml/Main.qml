@@ -134,6 +134,14 @@ ApplicationWindow {
             nodeForeignApi.apiUrl = controllerEndpoint("v2/foreign")
             nodeForeignApi.apiKey = controllerApiAuthHeader
         }
+        if (typeof ownerRpc !== "undefined" && ownerRpc) {
+            ownerRpc.url = controllerEndpoint("v2/owner")
+            ownerRpc.authHeader = controllerApiAuthHeader
+        }
+        if (typeof chainRpc !== "undefined" && chainRpc) {
+            chainRpc.url = controllerEndpoint("v2/foreign")
+            chainRpc.authHeader = controllerApiAuthHeader
+        }
         controllerApiUrlsReady = controllerApiUrl.toString() !== ""
     }
 
@@ -195,6 +203,11 @@ ApplicationWindow {
         username: appSettings.controllerUsername
         password: appSettings.controllerPassword
 
+        // Pushed tips let the UTXO mirror catch up without waiting for its poll
+        onTipChanged: function(tip) {
+            if (typeof utxoMirror !== "undefined" && utxoMirror)
+                utxoMirror.notifyTip(Number(tip.height || 0))
+        }
     }
 
     // -----------------------------------------------------------------
@@ -20,6 +20,17 @@ Item {
     // Node manager from C++ (GrinNodeManager)
     property var nodeManager: null
 
+    // Shared poll scheduler (set in main.cpp as pollScheduler context property).
+    // Home.qml serves the connected peers topic; the map only asks for a slower
+    // refresh while it is shown, so the topic keeps running when Home is hidden.
+    readonly property var scheduler: (typeof pollScheduler !== "undefined") ? pollScheduler : null
+    property int peersRefreshIntervalMs: 30000
+
+    onVisibleChanged: {
+        if (scheduler)
+            scheduler.subscribe("owner.connectedPeers", peersRoot, peersRefreshIntervalMs, visible)
+    }
+
     // draw above background image in Main.qml
     z: 1000
 
@@ -43,30 +54,69 @@ Item {
         return i18n ? i18n.t(key) : fallback
     }
 
+    // Resolved positions by IP: ip -> { lat, lon }
+    // Only the current peers are kept; GeoLookup has the persistent cache.
+    property var geoByIp: ({})
+
+    // Drop positions of IPs that are no longer connected
+    function pruneGeoByIp() {
+        var kept = {}
+        for (var i = 0; i < ipList.length; ++i) {
+            var p = geoByIp[ipList[i]]
+            if (p)
+                kept[ipList[i]] = p
+        }
+        geoByIp = kept
+    }
+
+    // Project all known positions of the current ipList to markers
+    function rebuildMarkers() {
+        var markers = []
+        var tileCount = Math.pow(2, peersRoot.zoomLevel)
+        for (var i = 0; i < ipList.length; ++i) {
+            var p = geoByIp[ipList[i]]
+            if (!p)
+                continue
+
+            var lat = p.lat
+            var lon = p.lon
+
+            // Web Mercator projection → tile pixel coordinates
+            var x = (lon + 180.0) / 360.0 * tileCount * peersRoot.tileSize
+            var y = (1.0 - Math.log(Math.tan(lat * Math.PI / 180.0)
+                      + 1.0 / Math.cos(lat * Math.PI / 180.0)) / Math.PI)
+                      / 2.0 * tileCount * peersRoot.tileSize
+
+            markers.push({ "ip": ipList[i], "x": x, "y": y })
+        }
+        peersRoot.peerMarkers = markers
+    }
+
     // -----------------------------------------------------------------
     // Geo lookup: converts IPs to lat/lon (C++ backend)
     // -----------------------------------------------------------------
     GeoLookup {
         id: geoLookup
 
-        // C++ finished with coordinates
-        onLookupFinished: function(coords) {
-            var markers = []
-            for (var i = 0; i < coords.length; ++i) {
-                var lat = coords[i].lat
-                var lon = coords[i].lon
-
-                var tileCount = Math.pow(2, peersRoot.zoomLevel)
-
-                // Web Mercator projection → tile pixel coordinates
-                var x = (lon + 180.0) / 360.0 * tileCount * peersRoot.tileSize
-                var y = (1.0 - Math.log(Math.tan(lat * Math.PI / 180.0)
-                          + 1.0 / Math.cos(lat * Math.PI / 180.0)) / Math.PI)
-                          / 2.0 * tileCount * peersRoot.tileSize
-
-                markers.push({ "x": x, "y": y })
+        // Partial results arrive per chunk → markers appear incrementally
+        onResultsReady: function(results) {
+            var changed = false
+            for (var ip in results) {
+                var r = results[ip]
+                if (r.status === "success") {
+                    peersRoot.geoByIp[ip] = { "lat": r.lat, "lon": r.lon }
+                    changed = true
+                }
             }
-            peersRoot.peerMarkers = markers
+            if (changed)
+                peersRoot.rebuildMarkers()
+        }
+
+        // C++ finished with coordinates ({ ip, lat, lon })
+        onLookupFinished: function(coords) {
+            for (var i = 0; i < coords.length; ++i)
+                peersRoot.geoByIp[coords[i].ip] = { "lat": coords[i].lat, "lon": coords[i].lon }
+            peersRoot.rebuildMarkers()
         }
     }
 
@@ -162,10 +212,11 @@ Item {
     }
 
     // -----------------------------------------------------------------
-    // Connection to nodeOwnerApi: transform peers → IPs → geo lookup
+    // Connection to ownerRpc: transform peers → IPs → geo lookup
     // -----------------------------------------------------------------
     Connections {
-        target: nodeOwnerApi
+        target: typeof ownerRpc !== "undefined" ? ownerRpc : null
+        ignoreUnknownSignals: true
 
         function onConnectedPeersUpdated(peersArray) {
             // Lookup-Tabelle neu aufbauen
@@ -184,6 +235,7 @@ Item {
             }
 
             peersRoot.ipList = tmp
+            peersRoot.pruneGeoByIp()
 
             if (peersRoot.ipList.length > 0) {
                 geoLookup.lookupIPs(peersRoot.ipList)
@@ -201,12 +253,14 @@ Item {
 
         function onNodeStopped(kind) {
             peersRoot.ipList = []
+            peersRoot.geoByIp = ({})
             peersRoot.peerMarkers = []
         }
 
 
         function onNodeRestarted(kind) {
             peersRoot.ipList = []
+            peersRoot.geoByIp = ({})
             peersRoot.peerMarkers = []
         }
     }
@@ -379,7 +379,8 @@ Rectangle {
     // Backend connection: updates table content + lastUpdated label
     // ------------------------------------------------------------------
     Connections {
-        target: nodeOwnerApi
+        target: typeof ownerRpc !== "undefined" ? ownerRpc : null
+        ignoreUnknownSignals: true
 
         // Emitted by backend with full array of connected peers
         function onConnectedPeersUpdated(peersArray) {
@@ -23,6 +23,14 @@ Item {
     property bool compactLayout: false
     property string peersStatusText: ""
     property var i18n: null    // injected from Main.qml for translations
+    // Shared poll scheduler (set in main.cpp as pollScheduler context property)
+    readonly property var scheduler: (typeof pollScheduler !== "undefined") ? pollScheduler : null
+    property int refreshIntervalMs: 10000
+    // With the controller event stream up, peer events trigger the refresh
+    readonly property bool eventsConnected: !!(nodeManager && nodeManager.eventsConnected)
+    readonly property int peersPollIntervalMs: eventsConnected ? 60000 : refreshIntervalMs
+    // peer event while hidden: refresh once the page is shown again
+    property bool peersStale: false
 
     // Sizes
     readonly property int kCardH: 72
@@ -559,8 +567,10 @@ Item {
     // ---------------------------------------------------
     // Backend connections
     // ---------------------------------------------------
+    // Peer list through ownerRpc (batched with the other owner calls)
     Connections {
-        target: nodeOwnerApi
+        target: typeof ownerRpc !== "undefined" ? ownerRpc : null
+        ignoreUnknownSignals: true
 
         function onGetPeersFinishedQml(peersList) {
             var y = list.contentY
@@ -572,6 +582,18 @@ Item {
             restoreListPosition(y)
         }
 
+        function onRequestFailed(method, message) {
+            if (method !== "get_peers")
+                return
+            loading = false
+            errorText = message
+        }
+    }
+
+    // Ban / unban stay on nodeOwnerApi
+    Connections {
+        target: nodeOwnerApi
+
         function onBanPeerFinished(result) {
             if (!nodeRunning) return
             if (isResultOk(result)) {
@@ -621,9 +643,12 @@ Item {
     // ---------------------------------------------------
     function refresh() {
         if (!nodeRunning) return
+        if (scheduler)
+            scheduler.markFresh("owner.peers")
+        peersStale = false
         loading = true
         errorText = ""
-        nodeOwnerApi.getPeersAsync("")
+        ownerRpc.getPeersAsync("")
     }
 
     onPeersChanged: {
@@ -633,21 +658,55 @@ Item {
     }
 
     onNodeRunningChanged: {
+        updatePeersPolling()
         if (nodeRunning) {
             rebuildUaOptions()
             applyFilter()
-            refresh()
         } else {
             // wenn der Node komplett aus ist, auch hier sicherheitshalber alles leeren
             clearPeersView()
         }
     }
 
-    Timer {
-        interval: 10000
-        repeat: true
-        running: nodeRunning
-        onTriggered: refresh()
+    // Peer list polling through the shared scheduler; paused while the page is hidden
+    function updatePeersPolling() {
+        if (!scheduler)
+            return
+        if (nodeRunning)
+            scheduler.subscribe("owner.peers", root, peersPollIntervalMs, root.visible)
+        else
+            scheduler.unsubscribe("owner.peers", root)
+    }
+
+    onVisibleChanged: {
+        if (visible && peersStale)
+            refresh()
+        updatePeersPolling()
+    }
+    onPeersPollIntervalMsChanged: updatePeersPolling()
+
+    Connections {
+        target: root.scheduler
+        ignoreUnknownSignals: true
+
+        function onPoll(topic) {
+            if (topic === "owner.peers")
+                refresh()
+        }
+    }
+
+    Connections {
+        target: root.nodeManager
+        ignoreUnknownSignals: true
+
+        function onPeerChanged(peer) {
+            if (!root.nodeRunning)
+                return
+            if (root.visible)
+                refresh()
+            else
+                root.peersStale = true
+        }
     }
 
     Component.onCompleted: {
@@ -656,6 +715,6 @@ Item {
         banFilter.currentIndex = 0
         uaFilter.currentIndex = 0
         uaMustExist.checked = false
-        if (nodeRunning) refresh()
+        updatePeersPolling()
     }
 }
@@ -24,6 +24,9 @@ Item {
     property real chartPaddingPct: 0.05
     property real axisLabelFontSize: 11
     property bool pageActive: false
+    property int refreshIntervalMs: 10 * 60 * 1000
+    // Shared poll scheduler (set in main.cpp as pollScheduler context property)
+    readonly property var scheduler: (typeof pollScheduler !== "undefined") ? pollScheduler : null
 
     function tr(key, fallback) {
         if (i18n && typeof i18n.t === "function") {
@@ -56,134 +59,30 @@ Item {
         return Qt.formatDateTime(date, format)
     }
 
-    function toNumber(value) {
-        if (typeof value === "number")
-            return isFinite(value) ? value : NaN
-        if (value === undefined || value === null)
-            return NaN
-        var attempt = Number(value)
-        return isFinite(attempt) ? attempt : NaN
-    }
-
     function updateChart() {
         if (!priceSource || !timeAxis || !valueAxis || !priceCandles)
             return
 
-        var data = priceSource.history || []
-        priceCandles.clear()
-
         var chartWidth = priceChart ? priceChart.width : Math.max(360, priceContent ? priceContent.width : 360)
         var desiredCandles = Math.max(20, Math.min(120, Math.round(chartWidth / 9)))
-        var rawPoints = []
-        var minRawTs = Number.MAX_VALUE
-        var maxRawTs = 0
-
-        for (var i = 0; i < data.length; ++i) {
-            var entry = data[i]
-            if (!entry)
-                continue
-            var parsed = Date.parse(entry.timestamp)
-            if (isNaN(parsed))
-                continue
-
-            var priceValue = toNumber(entry.price)
-            if (isNaN(priceValue))
-                continue
-
-            rawPoints.push({ timestamp: parsed, price: priceValue })
-            minRawTs = Math.min(minRawTs, parsed)
-            maxRawTs = Math.max(maxRawTs, parsed)
-        }
 
-        rawPoints.sort(function(a, b) { return a.timestamp - b.timestamp })
-
-        var bucketOrigin = minRawTs !== Number.MAX_VALUE ? minRawTs : (Date.now() - fallbackTimespanMs)
-        var observedRange = Math.max(maxRawTs - bucketOrigin, fallbackTimespanMs)
-        var dayWindowStart = maxRawTs > 0 ? Math.max(maxRawTs - fallbackTimespanMs, minRawTs) : Date.now() - fallbackTimespanMs
-        var dayHigh = -Number.MAX_VALUE
-        var dayLow = Number.MAX_VALUE
-        for (var idx = 0; idx < rawPoints.length; ++idx) {
-            var pt = rawPoints[idx]
-            if (pt.timestamp >= dayWindowStart) {
-                dayHigh = Math.max(dayHigh, pt.price)
-                dayLow = Math.min(dayLow, pt.price)
-            }
-        }
-        if (dayHigh === -Number.MAX_VALUE)
-            dayHigh = NaN
-        if (dayLow === Number.MAX_VALUE)
-            dayLow = NaN
-        dailyHighPrice = dayHigh
-        dailyLowPrice = dayLow
-        var bucketSizeMs = Math.max(1, Math.floor(observedRange / desiredCandles))
-        var buckets = {}
-        var bucketKeys = []
-
-        for (var j = 0; j < rawPoints.length; ++j) {
-            var point = rawPoints[j]
-            var bucketKey = bucketOrigin + Math.floor((point.timestamp - bucketOrigin) / bucketSizeMs) * bucketSizeMs
-            if (!buckets[bucketKey]) {
-                buckets[bucketKey] = {
-                    timestamp: bucketKey,
-                    open: point.price,
-                    high: point.price,
-                    low: point.price,
-                    close: point.price
-                }
-                bucketKeys.push(bucketKey)
-            } else {
-                var bucket = buckets[bucketKey]
-                bucket.high = Math.max(bucket.high, point.price)
-                bucket.low = Math.min(bucket.low, point.price)
-                bucket.close = point.price
-            }
-        }
+        // Bucketing happens in C++; the mapper feeds the series from the model
+        var candles = priceSource.ohlc(desiredCandles, 0, 0)
 
-        bucketKeys.sort(function(a, b) { return a - b })
-        if (bucketKeys.length > desiredCandles)
-            bucketKeys = bucketKeys.slice(bucketKeys.length - desiredCandles)
-        var candleEntries = []
-        for (var k = 0; k < bucketKeys.length; ++k) {
-            var key2 = bucketKeys[k]
-            if (buckets[key2])
-                candleEntries.push(buckets[key2])
-        }
-        priceCandles.clear()
-        for (var m = 0; m < candleEntries.length; ++m) {
-            var candle = candleEntries[m]
-            var set = Qt.createQmlObject(
-                        'import QtCharts 2.5; CandlestickSet {}',
-                        priceCandles,
-                        'candlestickSet_' + m)
-            if (set) {
-                set.timestamp = candle.timestamp
-                set.open = candle.open
-                set.high = candle.high
-                set.low = candle.low
-                set.close = candle.close
-                priceCandles.append(set)
-            }
-        }
+        dailyHighPrice = priceSource.pointCount > 0 ? priceSource.dailyHighPriceUsd : NaN
+        dailyLowPrice = priceSource.pointCount > 0 ? priceSource.dailyLowPriceUsd : NaN
 
-        var minTs = Number.MAX_VALUE
-        var maxTs = 0
-        var minPrice = Number.MAX_VALUE
-        var maxPrice = -Number.MAX_VALUE
-        for (var n = 0; n < candleEntries.length; ++n) {
-            var candle = candleEntries[n]
-            minTs = Math.min(minTs, candle.timestamp)
-            maxTs = Math.max(maxTs, candle.timestamp)
-            minPrice = Math.min(minPrice, candle.low)
-            maxPrice = Math.max(maxPrice, candle.high)
-        }
+        chartHasData = candles.count > 0
 
-        var appendedPoints = candleEntries.length
-        chartHasData = appendedPoints > 0
+        var minTs = candles.minTimestamp
+        var maxTs = candles.maxTimestamp
+        var minPrice = candles.minPrice
+        var maxPrice = candles.maxPrice
 
         if (chartHasData && maxTs <= minTs)
             maxTs = minTs + fallbackTimespanMs
 
-        if (!chartHasData || minTs === Number.MAX_VALUE) {
+        if (!chartHasData) {
             var now = Date.now()
             minTs = now - fallbackTimespanMs
             maxTs = now
@@ -215,24 +114,25 @@ Item {
 
     }
 
-    Timer {
-        id: refreshTimer
-        interval: 10 * 60 * 1000
-        repeat: true
-        running: false
-        onTriggered: {
-            if (priceSource)
-                priceSource.refresh()
-        }
+    // Price refresh through the shared scheduler: only while the page is shown,
+    // and on showing only when the last refresh is older than the interval
+    Component.onCompleted: {
+        if (scheduler)
+            scheduler.subscribe("price", root, refreshIntervalMs, pageActive)
     }
 
     onPageActiveChanged: {
-        if (pageActive) {
-            refreshTimer.restart()
-            if (priceSource)
+        if (scheduler)
+            scheduler.setVisible("price", root, pageActive)
+    }
+
+    Connections {
+        target: root.scheduler
+        ignoreUnknownSignals: true
+
+        function onPoll(topic) {
+            if (topic === "price" && priceSource)
                 priceSource.refresh()
-        } else {
-            refreshTimer.stop()
         }
     }
 
@@ -392,6 +292,19 @@ Item {
                                 useOpenGL: false
                                 visible: chartHasData
                             }
+
+                            // One CandlestickSet per model row, no per-candle QML objects
+                            HCandlestickModelMapper {
+                                model: priceSource ? priceSource.candles : null
+                                series: priceCandles
+                                timestampColumn: 0
+                                openColumn: 1
+                                highColumn: 2
+                                lowColumn: 3
+                                closeColumn: 4
+                                firstSetRow: 0
+                                lastSetRow: priceSource ? Math.max(0, priceSource.candles.count - 1) : 0
+                            }
                         }
                     }
                 }
@@ -6,7 +6,7 @@
 //   - chain tip info (height, hashes, total difficulty)
 //
 // Expects:
-//   - currentStatus: status object from C++ (nodeOwnerApi)
+//   - currentStatus: status object from C++ (ownerRpc)
 //   - i18n: translation helper with .language and .t(key)
 // -----------------------------------------------------------------------------
 
@@ -14,6 +14,7 @@ import QtQuick
 import QtQuick.Controls
 import QtQuick.Layouts
 import QtQuick.Effects
+import Grin 1.0   // TimeSeries
 
 Rectangle {
     id: root
@@ -59,10 +60,68 @@ Rectangle {
     // Used to clear the view when the node is stopped or restarted.
     property var nodeManager: null
 
+    // History since the view was opened (multi-resolution series from C++),
+    // also usable by other charts
+    readonly property alias heightSeries: heightSeries
+    readonly property alias difficultySeries: difficultySeries
+    readonly property alias peerSeries: peerSeries
+
+    TimeSeries { id: heightSeries }
+    TimeSeries { id: difficultySeries }
+    TimeSeries { id: peerSeries }
+
+    // Small trend line; only draws min/max of the series per pixel column
+    component Sparkline: Canvas {
+        id: spark
+        property var series: null
+        property color lineColor: "#4caf50"
+
+        implicitHeight: 24
+        visible: !!series && series.count > 1
+
+        onWidthChanged: requestPaint()
+        Connections {
+            target: spark.series
+            function onChanged() { spark.requestPaint() }
+        }
+
+        onPaint: {
+            var ctx = getContext("2d")
+            ctx.reset()
+            if (!series || series.count < 2 || width <= 0)
+                return
+
+            var pts = series.minMax(0, 0, Math.max(1, Math.floor(width)))
+            var range = series.valueRange(0, 0)
+            var t0 = series.minTimestamp
+            var tSpan = Math.max(1, series.maxTimestamp - t0)
+            var vSpan = Math.max(1e-9, range.max - range.min)
+
+            ctx.strokeStyle = lineColor
+            ctx.lineWidth = 1
+            ctx.beginPath()
+            for (var i = 0; i < pts.length; ++i) {
+                var x = (pts[i].t - t0) / tSpan * (width - 1)
+                var y = height - 1 - (pts[i].v - range.min) / vSpan * (height - 2)
+                if (i === 0)
+                    ctx.moveTo(x, y)
+                else
+                    ctx.lineTo(x, y)
+            }
+            ctx.stroke()
+        }
+    }
+
     // -------------------------------------------------------------------------
     // i18n helper
     // -------------------------------------------------------------------------
 
+    function clearSeries() {
+        heightSeries.clear()
+        difficultySeries.clear()
+        peerSeries.clear()
+    }
+
     function tr(key, fallback) {
         if (!i18n || typeof i18n.t !== "function")
             return fallback || key
@@ -1072,6 +1131,13 @@ Rectangle {
                             }
                         }
 
+                        Sparkline {
+                            series: peerSeries
+                            Layout.fillWidth: true
+                            Layout.leftMargin: labelColumnWidth + 8
+                            Layout.preferredHeight: implicitHeight
+                        }
+
                         // Height
                         RowLayout {
                             Layout.fillWidth: true
@@ -1194,10 +1260,11 @@ Rectangle {
     }
 
     // -------------------------------------------------------------------------
-    // Connection to C++ backend (nodeOwnerApi)
+    // Connection to C++ backend (ownerRpc)
     // -------------------------------------------------------------------------
     Connections {
-        target: nodeOwnerApi
+        target: typeof ownerRpc !== "undefined" ? ownerRpc : null
+        ignoreUnknownSignals: true
 
         // Called when a new status object is available
         function onStatusUpdated(statusObj) {
@@ -1208,6 +1275,16 @@ Rectangle {
             var m = now.getMinutes().toString().padStart(2, "0")
             var s = now.getSeconds().toString().padStart(2, "0")
             root.lastUpdated = h + ":" + m + ":" + s
+
+            if (!statusObj)
+                return
+            var t = now.getTime()
+            peerSeries.append(t, Number(statusObj.connections || 0))
+            if (statusObj.tip) {
+                heightSeries.append(t, Number(statusObj.tip.height || 0))
+                difficultySeries.append(t, Number(statusObj.tip.totalDifficulty
+                                                  || statusObj.tip.total_difficulty || 0))
+            }
         }
     }
     // -------------------------------------------------------------------------
@@ -1219,11 +1296,13 @@ Rectangle {
         function onNodeStopped(kind) {
             currentStatus = null
             lastUpdated = ""
+            clearSeries()
         }
 
         function onNodeRestarted(kind) {
             currentStatus = null
             lastUpdated = ""
+            clearSeries()
         }
     }
 }
@@ -18,9 +18,25 @@ Item {
 
     // Foreign API (set as context property in C++)
     readonly property var foreignApi: nodeForeignApi
+    // Batched chain RPC (set in main.cpp as chainRpc context property); shares
+    // the foreign batcher with the pool model, so tip and pool go out together
+    readonly property var chainApi: (typeof chainRpc !== "undefined") ? chainRpc : null
+    property int tipRequestId: -1
 
     // Poll interval for mempool updates (ms)
     property int mempoolPollIntervalMs: 8000
+    // With the controller event stream up, pool and tip events trigger the
+    // refresh and polling only acts as a safety net
+    readonly property bool eventsConnected: !!(nodeManager && nodeManager.eventsConnected)
+    readonly property int effectiveMempoolIntervalMs: eventsConnected ? 60000 : mempoolPollIntervalMs
+    // pool event while hidden: refresh once the page is shown again
+    property bool mempoolStale: false
+    // Shared poll scheduler (set in main.cpp as pollScheduler context property)
+    readonly property var scheduler: (typeof pollScheduler !== "undefined") ? pollScheduler : null
+    // Mempool rows diffed in C++ (set in main.cpp as poolModel context property)
+    readonly property var pool: (typeof poolModel !== "undefined") ? poolModel : null
+    // Pool model available: poll through the scheduler, paused while hidden
+    readonly property bool schedulerPolling: scheduler !== null && pool !== null && !!foreignApi
 
     // Node manager from C++ (GrinNodeManager)
     property var nodeManager: null
@@ -29,10 +45,9 @@ Item {
     // ------------------------------------------------------------------
     // UI STATE
     // ------------------------------------------------------------------
-    property int poolSize: 0
-    property int stempoolSize: 0
+    readonly property int poolSize: pool ? pool.poolSize : 0
+    readonly property int stempoolSize: pool ? pool.stempoolSize : 0
     property var tip: ({ height: 0, lastBlockPushed: "", prevBlockToLast: "", totalDifficulty: 0 })
-    property var entries: []   // only pool transactions
     property var historyEntries: []
     property int historyLimit: 50
     property var selectedTransaction: null
@@ -80,18 +95,8 @@ Item {
     }
 
     // ------------------------------------------------------------------
-    // Helper: Map raw pool entries to a flat model
+    // Helper: history entries (pool rows come mapped from PoolModel)
     // ------------------------------------------------------------------
-    function stableHash(text) {
-        var hash = 2166136261
-        var input = String(text || "")
-        for (var i = 0; i < input.length; ++i) {
-            hash ^= input.charCodeAt(i)
-            hash += (hash << 1) + (hash << 4) + (hash << 7) + (hash << 8) + (hash << 24)
-        }
-        return (hash >>> 0).toString(16)
-    }
-
     function normalizeSource(value) {
         if (value === undefined || value === null || value === "")
             return ""
@@ -116,142 +121,6 @@ Item {
         return text
     }
 
-    function deriveTransactionId(entry, tx, body, fallbackIndex) {
-        var directId = entry.id || entry.tx_id || tx.txId || tx.tx_id || tx.id
-        if (directId !== undefined && directId !== null && String(directId).length > 0)
-            return String(directId)
-
-        if (body && body.kernels && body.kernels.length > 0) {
-            var firstKernel = body.kernels[0]
-            if (firstKernel && firstKernel.excess && String(firstKernel.excess).length > 0)
-                return String(firstKernel.excess)
-        }
-
-        var txAt = entry.txAt || entry.tx_at || ""
-        var source = normalizeSource(entry.src)
-        var fee = tx.fee || entry.fee || 0
-            var kernelData = body && body.kernels ? JSON.stringify(body.kernels) : ""
-            var outputData = body && body.outputs ? JSON.stringify(body.outputs) : ""
-            var inputData = body && body.inputs ? JSON.stringify(body.inputs) : ""
-            var fingerprint = JSON.stringify(tx)
-
-        if (!fingerprint || fingerprint === "{}") {
-            fingerprint = [
-                txAt,
-                source,
-                fee,
-                inputData,
-                outputData,
-                kernelData,
-                fallbackIndex
-            ].join("|")
-        }
-
-        return "tx-" + stableHash(fingerprint)
-    }
-
-    function totalKernelFee(body) {
-        if (!body || !body.kernels || body.kernels.length === 0)
-            return 0
-
-        var total = 0
-        for (var i = 0; i < body.kernels.length; ++i) {
-            var kernel = body.kernels[i]
-            var fee = Number(kernel && kernel.fee !== undefined ? kernel.fee : 0)
-            total += fee
-        }
-        return total
-    }
-
-    function kernelExcesses(body) {
-        var out = []
-        if (!body || !body.kernels)
-            return out
-        for (var i = 0; i < body.kernels.length; ++i) {
-            var kernel = body.kernels[i]
-            if (kernel && kernel.excess)
-                out.push(String(kernel.excess))
-        }
-        return out
-    }
-
-    function kernelSignatures(body) {
-        var out = []
-        if (!body || !body.kernels)
-            return out
-        for (var i = 0; i < body.kernels.length; ++i) {
-            var kernel = body.kernels[i]
-            if (kernel && kernel.excessSig)
-                out.push(String(kernel.excessSig))
-        }
-        return out
-    }
-
-    function kernelFeatureNames(body) {
-        var out = []
-        if (!body || !body.kernels)
-            return out
-        for (var i = 0; i < body.kernels.length; ++i) {
-            var kernel = body.kernels[i]
-            if (kernel && kernel.features)
-                out.push(String(kernel.features))
-        }
-        return out
-    }
-
-    function commitList(items) {
-        var out = []
-        if (!items)
-            return out
-        for (var i = 0; i < items.length; ++i) {
-            var item = items[i]
-            if (item && item.commit) {
-                if (item.commit.hex)
-                    out.push(String(item.commit.hex))
-                else
-                    out.push(String(item.commit))
-            }
-        }
-        return out
-    }
-
-    function mapPoolEntries(listLike) {
-        var out = []
-        if (!listLike)
-            return out
-
-        for (var i = 0; i < listLike.length; ++i) {
-            var e    = listLike[i] || {}
-            var tx   = e.tx || {}
-            var body = tx.body || {}
-
-            var fee    = Number(tx.fee || e.fee || totalKernelFee(body) || 0)
-            var inputs  = (body.inputs  && body.inputs.length)  || e.inputs  || 0
-            var outputs = (body.outputs && body.outputs.length) || e.outputs || 0
-            var kernels = (body.kernels && body.kernels.length) || e.kernels || 0
-            var id      = deriveTransactionId(e, tx, body, i)
-            var txAt    = e.txAt || e.tx_at || ""
-            var source  = normalizeSource(e.src)
-
-            out.push({
-                id: id,
-                fee: fee,
-                inputs: inputs,
-                outputs: outputs,
-                kernels: kernels,
-                txAt: txAt ? String(txAt) : "",
-                source: source ? String(source) : "",
-                offset: tx && tx.offset && tx.offset.hex ? String(tx.offset.hex) : "",
-                kernelExcesses: kernelExcesses(body),
-                kernelSignatures: kernelSignatures(body),
-                kernelFeatures: kernelFeatureNames(body),
-                inputCommits: commitList(body.inputs),
-                outputCommits: commitList(body.outputs)
-            })
-        }
-        return out
-    }
-
     function normalizeHistoryEntry(entry, fallbackIndex) {
         var item = entry || {}
         return {
@@ -362,10 +231,9 @@ Item {
     // Helper: alles leeren (keine alten Artefakte)
     // ------------------------------------------------------------------
     function clearTransactionsView() {
-        poolSize = 0
-        stempoolSize = 0
         tip = { height: 0, lastBlockPushed: "", prevBlockToLast: "", totalDifficulty: 0 }
-        entries = []
+        if (pool)
+            pool.clear()
 
         // Statusbar-Text zurücksetzen, falls vorhanden
         if (status) {
@@ -379,13 +247,33 @@ Item {
     function startMempoolPolling() {
         if (!foreignApi)
             return
-        foreignApi.startMempoolPolling(mempoolPollIntervalMs)
+        if (schedulerPolling)
+            scheduler.subscribe("foreign.mempool", root, effectiveMempoolIntervalMs, root.visible)
+        else
+            foreignApi.startMempoolPolling(mempoolPollIntervalMs)
     }
 
     function stopMempoolPolling() {
         if (!foreignApi)
             return
-        foreignApi.stopMempoolPolling()
+        if (schedulerPolling)
+            scheduler.unsubscribe("foreign.mempool", root)
+        else
+            foreignApi.stopMempoolPolling()
+    }
+
+    function pollMempool() {
+        if (!foreignApi || !nodeRunning)
+            return
+        if (schedulerPolling)
+            scheduler.markFresh("foreign.mempool")
+        mempoolStale = false
+        // sizes, transactions and tip in one batch; the model only reports changed rows
+        pool.refresh()
+        if (chainApi)
+            tipRequestId = chainApi.refreshTipAsync(1)
+        else
+            foreignApi.getTipAsync()
     }
 
     function updatePollingState() {
@@ -409,6 +297,49 @@ Item {
         }
     }
     Component.onDestruction: stopMempoolPolling()
+    onVisibleChanged: {
+        if (visible && mempoolStale && schedulerPolling)
+            pollMempool()
+        if (schedulerPolling && nodeRunning)
+            scheduler.setVisible("foreign.mempool", root, root.visible)
+    }
+    onEffectiveMempoolIntervalMsChanged: {
+        if (schedulerPolling && nodeRunning)
+            startMempoolPolling()
+    }
+
+    Connections {
+        target: root.scheduler
+        ignoreUnknownSignals: true
+
+        function onPoll(topic) {
+            if (topic === "foreign.mempool")
+                pollMempool()
+        }
+    }
+
+    Connections {
+        target: root.nodeManager
+        ignoreUnknownSignals: true
+
+        // Pool changes and new blocks (which drain the pool)
+        function onPoolChanged(pool) {
+            root.handleMempoolEvent()
+        }
+
+        function onTipChanged(tip) {
+            root.handleMempoolEvent()
+        }
+    }
+
+    function handleMempoolEvent() {
+        if (!schedulerPolling || !nodeRunning)
+            return
+        if (root.visible)
+            Qt.callLater(pollMempool)   // pool + tip of the same block: one refresh
+        else
+            mempoolStale = true
+    }
 
     Connections {
         target: settingsStore
@@ -426,22 +357,36 @@ Item {
         target: (typeof foreignApi === "object" && foreignApi) ? foreignApi : null
         ignoreUnknownSignals: true
 
-        function onPoolSizeUpdated(size) {
-            poolSize = Number(size || 0)
+        function onTipUpdated(payload) {
+            tip = toTip(payload)
         }
+    }
 
-        function onStempoolSizeUpdated(size) {
-            stempoolSize = Number(size || 0)
+    Connections {
+        target: root.chainApi
+        ignoreUnknownSignals: true
+
+        // chainRpc is shared; only our own tip request counts
+        function onTipRefreshed(requestId, tipMap, items) {
+            if (requestId !== root.tipRequestId)
+                return
+            root.tipRequestId = -1
+            tip = toTip(tipMap)
         }
 
-        function onTipUpdated(payload) {
-            tip = toTip(payload)
+        function onTipRefreshFailed(requestId, message) {
+            if (requestId === root.tipRequestId)
+                root.tipRequestId = -1
         }
+    }
+
+    Connections {
+        target: root.pool
+        ignoreUnknownSignals: true
 
-        function onUnconfirmedTransactionsUpdated(list) {
-            var mapped = mapPoolEntries(list)
-            entries = mapped
-            rememberTransactions(mapped)
+        // only transactions that were not in the previous snapshot
+        function onTransactionsAdded(added) {
+            rememberTransactions(added)
         }
     }
 
@@ -563,18 +508,18 @@ Item {
 
                     Repeater {
                         id: rep
-                        model: Array.isArray(entries) ? entries.length : 0
+                        model: root.pool
 
                         delegate: PoolBlock {
                             width: 150
                             height: 100
-                            txId:    entries[index].id
-                            fee:     entries[index].fee
-                            inputs:  entries[index].inputs
-                            outputs: entries[index].outputs
-                            kernels: entries[index].kernels
+                            txId:    model.txId
+                            fee:     model.fee
+                            inputs:  model.inputs
+                            outputs: model.outputs
+                            kernels: model.kernels
                             i18n:    root.i18n
-                            onBlockClicked: openTransactionDetails(entries[index])
+                            onBlockClicked: openTransactionDetails(root.pool.get(index))
                         }
                     }
                 }
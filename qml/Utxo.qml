@@ -2,6 +2,7 @@ import QtQuick 2.15
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Grin 1.0   // UtxoModel
 
 Item {
     id: root
@@ -11,11 +12,23 @@ Item {
     property bool compactLayout: false
     property var i18n: null
     readonly property var foreignApi: nodeForeignApi
+    // height -> PMMR index map lives in ChainRpc (one round trip per height range)
+    readonly property var chain: (typeof chainRpc !== "undefined") ? chainRpc : null
+    property int outputsRequestId: -1
+    // optional local copy of the whole UTXO set (C++ UtxoMirror)
+    readonly property var mirror: (typeof utxoMirror !== "undefined") ? utxoMirror : null
+    // full commitment typed into the search that the mirror knows
+    readonly property var mirrorHit: {
+        var text = String(utxoModel.searchText || "").trim().toLowerCase()
+        // mirror.count: re-evaluate when the set changes
+        if (!mirror || !mirror.ready || mirror.count < 0 || !/^[0-9a-f]{66}$/.test(text))
+            return null
+        var hit = mirror.lookup(text)
+        return hit && hit.commit ? hit : null
+    }
 
     property bool loading: false
     property string errorText: ""
-    property var allOutputs: []
-    property var filteredOutputs: []
     property var selectedOutput: null
     property int highestIndex: 0
     property int lastRetrievedIndex: 0
@@ -53,10 +66,6 @@ Item {
         return ""
     }
 
-    function proofHash(output) {
-        return output && output.proof_hash ? String(output.proof_hash) : ""
-    }
-
     function blockHeightText(output) {
         if (!output || output.block_height === undefined || output.block_height === null)
             return "-"
@@ -75,40 +84,6 @@ Item {
                 : tr("utxo_err_load_failed", "Failed to load UTXO outputs.")
     }
 
-    function applyFilter() {
-        var search = String(searchField.text || "").trim().toLowerCase()
-        var typeText = String(typeFilter.currentText || "")
-        var spentText = String(spentFilter.currentText || "")
-
-        filteredOutputs = allOutputs.filter(function(output) {
-            var commit = commitHex(output).toLowerCase()
-            var matchesSearch = search.length === 0
-                    || commit.indexOf(search) >= 0
-                    || String(output.mmr_index || "").toLowerCase().indexOf(search) >= 0
-                    || String(output.block_height || "").toLowerCase().indexOf(search) >= 0
-
-            var matchesType = typeText === tr("utxo_filter_all", "All")
-                    || String(output.output_type || "") === typeText
-
-            var matchesSpent = spentText === tr("utxo_filter_all", "All")
-                    || (spentText === tr("utxo_spent_only", "Spent") && !!output.spent)
-                    || (spentText === tr("utxo_unspent_only", "Unspent") && !output.spent)
-
-            return matchesSearch && matchesType && matchesSpent
-        })
-
-        filteredOutputs.sort(function(a, b) {
-            var aMmr = Number(a && a.mmr_index !== undefined ? a.mmr_index : -1)
-            var bMmr = Number(b && b.mmr_index !== undefined ? b.mmr_index : -1)
-            if (aMmr !== bMmr)
-                return bMmr - aMmr
-
-            var aHeight = Number(a && a.block_height !== undefined ? a.block_height : -1)
-            var bHeight = Number(b && b.block_height !== undefined ? b.block_height : -1)
-            return bHeight - aHeight
-        })
-    }
-
     function loadOutputs() {
         if (!foreignApi) {
             errorText = tr("utxo_err_no_api", "Foreign API not available.")
@@ -147,6 +122,13 @@ Item {
         resolvingHeightRange = true
         loading = true
         errorText = ""
+        if (chain && typeof chain.getOutputsByHeightAsync === "function") {
+            outputsRequestId = chain.getOutputsByHeightAsync(blockStartHeight,
+                                                             blockEndHeight,
+                                                             Math.max(1, maxResults),
+                                                             includeProof)
+            return
+        }
         foreignApi.getPmmrIndicesAsync(blockStartHeight, blockEndHeight)
     }
 
@@ -203,13 +185,16 @@ Item {
                 return
             }
 
-            allOutputs = outputs || []
-            applyFilter()
+            // search, type/spent filter and sorting run off the UI thread
+            utxoModel.setOutputs(outputs || [])
         }
 
         function onTipUpdated(tip) {
             if (!tip)
                 return
+            // opens the persisted PMMR index map of this chain
+            if (chain)
+                chain.setTipHeight(Number(tip.height || 0))
             applyLatestBlockWindow(tip.height)
         }
 
@@ -270,6 +255,38 @@ Item {
         }
     }
 
+    Connections {
+        target: chain
+        enabled: !!chain
+
+        function onOutputsByHeightUpdated(requestId, first, last, outputs, highest, lastRetrieved) {
+            if (requestId !== outputsRequestId)
+                return
+            loading = false
+            resolvingHeightRange = false
+            errorText = ""
+
+            startIndex = first
+            endIndex = last
+            highestIndex = Number(highest || 0)
+            lastRetrievedIndex = Number(lastRetrieved || 0)
+            startIndexField.text = String(startIndex)
+            endIndexField.text = String(endIndex)
+            utxoModel.setOutputs(outputs || [])
+        }
+
+        function onOutputsByHeightLookupFailed(requestId, message) {
+            if (requestId !== outputsRequestId)
+                return
+            loading = false
+            resolvingHeightRange = false
+            errorText = message && String(message).length > 0
+                    ? String(message)
+                    : tr("utxo_err_pmmr_failed", "Failed to resolve PMMR indices for the block range.")
+            status.showError(errorText)
+        }
+    }
+
     Component.onCompleted: {
         startIndexField.text = String(startIndex)
         maxField.text = String(maxResults)
@@ -280,6 +297,10 @@ Item {
         loadLatestWindow()
     }
 
+    UtxoModel {
+        id: utxoModel
+    }
+
     ScrollView {
         id: pageScroll
         anchors.fill: parent
@@ -305,8 +326,8 @@ Item {
                 spacing: 10
 
                 BusyIndicator {
-                    running: loading
-                    visible: loading
+                    running: loading || utxoModel.busy
+                    visible: running
                     Layout.preferredWidth: 22
                     Layout.preferredHeight: 22
                 }
@@ -477,7 +498,68 @@ Item {
                 SummaryCard {
                     Layout.fillWidth: true
                     title: tr("utxo_loaded_count", "Loaded outputs")
-                    value: String(filteredOutputs.length)
+                    value: String(utxoModel.count)
+                }
+            }
+
+            GridLayout {
+                Layout.fillWidth: true
+                visible: !!mirror
+                columns: compactLayout ? 1 : 4
+                columnSpacing: 10
+                rowSpacing: 8
+
+                ColumnLayout {
+                    Layout.fillWidth: true
+                    spacing: 4
+                    CheckBox {
+                        text: tr("utxo_mirror_enable", "Keep local UTXO set")
+                        checked: mirror ? mirror.enabled : false
+                        onToggled: if (mirror) mirror.enabled = checked
+                    }
+                    Label {
+                        Layout.fillWidth: true
+                        wrapMode: Text.WordWrap
+                        font.pixelSize: 12
+                        color: mirror && mirror.lastError.length > 0 ? "#ff9c9c" : "#aeb7c4"
+                        text: {
+                            if (!mirror || !mirror.enabled)
+                                return tr("utxo_mirror_off", "Off - lookups use the node.")
+                            if (mirror.lastError.length > 0)
+                                return mirror.lastError
+                            if (mirror.syncing && !mirror.ready)
+                                return String(tr("utxo_mirror_syncing", "Syncing %1%"))
+                                       .replace("%1", Math.floor(mirror.progress * 100))
+                            if (mirror.ready)
+                                return String(tr("utxo_mirror_synced", "Synced to height %1"))
+                                       .replace("%1", mirror.syncedHeight)
+                            return tr("utxo_mirror_opening", "Opening...")
+                        }
+                    }
+                    ProgressBar {
+                        Layout.fillWidth: true
+                        visible: !!mirror && mirror.syncing && !mirror.ready
+                        value: mirror ? mirror.progress : 0
+                    }
+                }
+
+                SummaryCard {
+                    Layout.fillWidth: true
+                    title: tr("utxo_mirror_count", "Unspent outputs")
+                    value: mirror && mirror.ready ? String(mirror.count) : "-"
+                }
+
+                SummaryCard {
+                    Layout.fillWidth: true
+                    title: tr("utxo_mirror_coinbase", "Coinbase outputs")
+                    value: mirror && mirror.ready ? String(mirror.coinbaseCount) : "-"
+                }
+
+                Button {
+                    Layout.alignment: Qt.AlignBottom
+                    text: tr("utxo_mirror_resync", "Resync")
+                    enabled: !!mirror && mirror.enabled && !mirror.syncing
+                    onClicked: mirror.resync()
                 }
             }
 
@@ -495,7 +577,7 @@ Item {
                         id: searchField
                         Layout.fillWidth: true
                         placeholderText: tr("utxo_search_placeholder", "Search commit, height or MMR index")
-                        onTextChanged: applyFilter()
+                        onTextChanged: utxoModel.searchText = text
                     }
                 }
 
@@ -512,7 +594,8 @@ Item {
                             "Transaction",
                             "Unknown"
                         ]
-                        onCurrentIndexChanged: applyFilter()
+                        // order matches UtxoModel.OutputType, -1 = all
+                        onCurrentIndexChanged: utxoModel.typeFilter = currentIndex - 1
                     }
                 }
 
@@ -528,7 +611,8 @@ Item {
                             tr("utxo_unspent_only", "Unspent"),
                             tr("utxo_spent_only", "Spent")
                         ]
-                        onCurrentIndexChanged: applyFilter()
+                        // order matches UtxoModel.SpentFilter
+                        onCurrentIndexChanged: utxoModel.spentFilter = currentIndex
                     }
                 }
             }
@@ -549,7 +633,7 @@ Item {
                     anchors.fill: parent
                     clip: true
                     spacing: 8
-                    model: filteredOutputs
+                    model: utxoModel
 
                     delegate: Rectangle {
                         width: list.width
@@ -561,7 +645,7 @@ Item {
                         MouseArea {
                             anchors.fill: parent
                             onClicked: {
-                                selectedOutput = modelData
+                                selectedOutput = utxoModel.get(index)
                                 outputDialog.open()
                             }
                         }
@@ -583,15 +667,15 @@ Item {
 
                                 Label {
                                     Layout.fillWidth: true
-                                    text: commitHex(modelData)
+                                    text: model.commit
                                     color: "white"
                                     font.pixelSize: 13
                                     elide: Text.ElideMiddle
                                 }
 
                                 Label {
-                                    text: String(modelData.output_type || "-")
-                                    color: String(modelData.output_type || "") === "Coinbase" ? "#d6c06e" : "#9db6d9"
+                                    text: model.outputType || "-"
+                                    color: model.outputType === "Coinbase" ? "#d6c06e" : "#9db6d9"
                                 }
                             }
 
@@ -600,15 +684,15 @@ Item {
                                 wrapMode: Text.WordWrap
                                 color: "#d0d0d0"
                                 text: String(tr("utxo_row_meta", "Height %1 | MMR %2 | Spent %3"))
-                                      .replace("%1", blockHeightText(modelData))
-                                      .replace("%2", String(modelData.mmr_index || "-"))
-                                      .replace("%3", modelData.spent ? tr("common_yes", "yes") : tr("common_no", "no"))
+                                      .replace("%1", model.blockHeight >= 0 ? String(model.blockHeight) : "-")
+                                      .replace("%2", model.mmrIndex > 0 ? String(model.mmrIndex) : "-")
+                                      .replace("%3", model.spent ? tr("common_yes", "yes") : tr("common_no", "no"))
                             }
 
                             Label {
                                 Layout.fillWidth: true
-                                visible: proofHash(modelData).length > 0
-                                text: tr("utxo_proof_hash_prefix", "Proof hash: ") + proofHash(modelData)
+                                visible: model.proofHash.length > 0
+                                text: tr("utxo_proof_hash_prefix", "Proof hash: ") + model.proofHash
                                 color: "#9fb1c8"
                                 font.pixelSize: 12
                                 elide: Text.ElideMiddle
@@ -616,11 +700,29 @@ Item {
                         }
                     }
 
-                    Label {
+                    ColumnLayout {
                         anchors.centerIn: parent
-                        visible: !loading && filteredOutputs.length === 0
-                        text: tr("utxo_empty", "No outputs available for the current filter.")
-                        color: "#8c8c8c"
+                        visible: !loading && !utxoModel.busy && utxoModel.count === 0
+                        spacing: 8
+
+                        Label {
+                            Layout.alignment: Qt.AlignHCenter
+                            text: mirrorHit
+                                  ? String(tr("utxo_mirror_hit", "Not on this page - unspent at height %1 (local UTXO set)"))
+                                    .replace("%1", mirrorHit.block_height)
+                                  : tr("utxo_empty", "No outputs available for the current filter.")
+                            color: "#8c8c8c"
+                        }
+
+                        Button {
+                            Layout.alignment: Qt.AlignHCenter
+                            visible: !!mirrorHit
+                            text: tr("utxo_mirror_show", "Show details")
+                            onClicked: {
+                                selectedOutput = mirrorHit
+                                outputDialog.open()
+                            }
+                        }
                     }
 
                     ScrollBar.vertical: ScrollBar { }
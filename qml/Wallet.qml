@@ -16,7 +16,27 @@ Item {
     // Quiet-Zone in QR-Modulen (üblich: 4)
     property int quietZoneModules: 4
 
+    // Bumped when grin-server.toml changes, so the config.value() bindings
+    // below re-read their keys (setValue reports per key, not the whole text)
+    property int configRevision: 0
+
+    Connections {
+        target: (typeof config !== "undefined") ? config : null
+        ignoreUnknownSignals: true
+
+        function onTextChanged() {
+            walletRoot.configRevision++
+        }
+
+        function onValueChanged(key) {
+            if (key === "chain_type" || key === "server.chain_type"
+                    || key === "owner_api.secret" || key === "owner_api_secret")
+                walletRoot.configRevision++
+        }
+    }
+
     property bool testnet: {
+        var _ = configRevision
         if (typeof config !== "undefined" && config) {
             var chainType = String(config.value("chain_type", "")).toLowerCase()
             if (!chainType.length)
@@ -57,6 +77,7 @@ Item {
         : (testnet ? defaultTestnetIpPort : defaultMainnetIpPort)
 
     property string defaultSecret: {
+        var _ = configRevision
         if (typeof config !== "undefined" && config) {
             var secret = config.value("owner_api.secret", "")
             if (secret && secret.length) return secret
@@ -0,0 +1,287 @@
+#include "chaincache.h"
+
+#include <QCborValue>
+
+#include <cstring>
+
+namespace {
+
+const quint8 kRecordVersion = 1;
+const qint64 kReorgHorizon = 60;                        // ca. eine Stunde Blöcke
+#ifdef Q_OS_WASM
+const qint64 kBudgetBytes = qint64(8) * 1024 * 1024;    // wird beim Öffnen am Stück gelesen
+#else
+const qint64 kBudgetBytes = qint64(64) * 1024 * 1024;
+#endif
+const qint64 kCompactSlackBytes = 1024 * 1024;
+const int kFlushDelayMs = 2000;
+
+QVariantMap headerOf(const QVariant &block)
+{
+    return block.toMap().value(QStringLiteral("header")).toMap();
+}
+
+} // namespace
+
+ChainCache::ChainCache(QObject *parent) :
+    QObject(parent),
+    m_store("ChainCache")
+{
+    static_assert(sizeof(Record) == 48, "ChainCache::Record must stay 48 bytes");
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushDelayMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &ChainCache::flush);
+}
+
+ChainCache::~ChainCache()
+{
+    flush();
+}
+
+/**
+ * @brief ChainCache::open
+ * Wechselt auf den Speicher der Chain mit diesem Genesis-Hash. Mainnet und
+ * Testnet teilen sich so nie einen Höhenindex.
+ */
+void ChainCache::open(const QString &genesisHash)
+{
+    const QString id = genesisHash.left(16).toLower();
+    if (id.isEmpty() || id == m_chainId) {
+        return;
+    }
+
+    flush();
+    m_entries.clear();
+    m_headerAt.clear();
+    m_blockAt.clear();
+    m_lru.clear();
+    m_pending.clear();
+    m_liveBytes = 0;
+
+    m_chainId = id;
+    m_store.open("chain-" + m_chainId + ".bin", "chain/cache-" + m_chainId, [this](const uchar *data, qint64 size) {
+        parse(data, size);
+    });
+}
+
+void ChainCache::setTipHeight(qint64 height)
+{
+    m_tipHeight = height;
+}
+
+bool ChainCache::isFinal(qint64 height) const
+{
+    return m_tipHeight >= 0 && height >= 0 && height <= m_tipHeight - kReorgHorizon;
+}
+
+qint64 ChainCache::finalHeight() const
+{
+    return m_tipHeight >= kReorgHorizon ? m_tipHeight - kReorgHorizon : -1;
+}
+
+// --- Lookup ----------------------------------------------------------
+
+QByteArray ChainCache::keyOf(Kind kind, const QByteArray &hash)
+{
+    return char(kind) + hash;
+}
+
+QVariant ChainCache::lookup(const QByteArray &key)
+{
+    const auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return QVariant();
+    }
+    touch(key, it.value());
+    return QCborValue::fromCbor(it->payload).toVariant();
+}
+
+void ChainCache::touch(const QByteArray &key, Entry &e)
+{
+    m_lru.remove(e.lastUse);
+    e.lastUse = ++m_clock;
+    m_lru.insert(e.lastUse, key);
+}
+
+QVariant ChainCache::header(qint64 height)
+{
+    const auto h = m_headerAt.constFind(height);
+    if (h != m_headerAt.constEnd()) {
+        return lookup(h.value());
+    }
+    const auto b = m_blockAt.constFind(height);
+    if (b != m_blockAt.constEnd()) {
+        return headerOf(lookup(b.value()));
+    }
+    return QVariant();
+}
+
+QVariant ChainCache::headerByHash(const QString &hash)
+{
+    const QByteArray raw = QByteArray::fromHex(hash.toLatin1());
+    const QVariant header = lookup(keyOf(HeaderKind, raw));
+    if (header.isValid()) {
+        return header;
+    }
+    const QVariant block = lookup(keyOf(BlockKind, raw));
+    return block.isValid() ? QVariant(headerOf(block)) : QVariant();
+}
+
+QVariant ChainCache::block(qint64 height)
+{
+    const auto b = m_blockAt.constFind(height);
+    return b == m_blockAt.constEnd() ? QVariant() : lookup(b.value());
+}
+
+QVariant ChainCache::blockByHash(const QString &hash)
+{
+    return lookup(keyOf(BlockKind, QByteArray::fromHex(hash.toLatin1())));
+}
+
+// --- Einfügen --------------------------------------------------------
+
+void ChainCache::insertHeader(const QVariant &header)
+{
+    const QVariantMap map = header.toMap();
+    const qint64 height = map.value(QStringLiteral("height"), -1).toLongLong();
+    const QByteArray hash = QByteArray::fromHex(map.value(QStringLiteral("hash")).toString().toLatin1());
+    if (!isOpen() || hash.size() != int(sizeof(Record::hash)) || !isFinal(height)
+        || m_entries.contains(keyOf(HeaderKind, hash))) {
+        return;
+    }
+    put(HeaderKind, height, hash, QCborValue::fromVariant(header).toCbor());
+}
+
+void ChainCache::insertBlock(const QVariant &block)
+{
+    const QVariantMap header = headerOf(block);
+    const qint64 height = header.value(QStringLiteral("height"), -1).toLongLong();
+    const QByteArray hash = QByteArray::fromHex(header.value(QStringLiteral("hash")).toString().toLatin1());
+    if (!isOpen() || hash.size() != int(sizeof(Record::hash)) || !isFinal(height)
+        || m_entries.contains(keyOf(BlockKind, hash))) {
+        return;
+    }
+    put(BlockKind, height, hash, QCborValue::fromVariant(block).toCbor());
+
+    // der Block enthält den Header, eigener Eintrag ist überflüssig
+    remove(keyOf(HeaderKind, hash));
+}
+
+void ChainCache::add(Kind kind, qint64 height, const QByteArray &hash, const QByteArray &payload)
+{
+    const QByteArray key = keyOf(kind, hash);
+    remove(key);
+
+    Entry e;
+    e.height = height;
+    e.payload = payload;
+    e.lastUse = ++m_clock;
+    m_entries.insert(key, e);
+    m_lru.insert(e.lastUse, key);
+    (kind == BlockKind ? m_blockAt : m_headerAt).insert(height, key);
+    m_liveBytes += payload.size();
+}
+
+void ChainCache::put(Kind kind, qint64 height, const QByteArray &hash, const QByteArray &payload)
+{
+    add(kind, height, hash, payload);
+    m_pending.append(keyOf(kind, hash));
+    evict();
+    scheduleFlush();
+}
+
+void ChainCache::remove(const QByteArray &key)
+{
+    const auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return;
+    }
+    QHash<qint64, QByteArray> &index = key.at(0) == char(BlockKind) ? m_blockAt : m_headerAt;
+    if (index.value(it->height) == key) {
+        index.remove(it->height);
+    }
+    m_lru.remove(it->lastUse);
+    m_liveBytes -= it->payload.size();
+    m_entries.erase(it);
+}
+
+void ChainCache::evict()
+{
+    while (m_liveBytes > kBudgetBytes && !m_lru.isEmpty()) {
+        const QByteArray key = m_lru.first();
+        remove(key);
+    }
+}
+
+// --- Persistenz ------------------------------------------------------
+
+void ChainCache::scheduleFlush()
+{
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+QByteArray ChainCache::serialize(const QVector<QByteArray> &keys) const
+{
+    QByteArray out;
+    for (const QByteArray &key : keys) {
+        const auto it = m_entries.constFind(key);
+        if (it == m_entries.constEnd()) {
+            continue;
+        }
+        Record r;
+        std::memset(&r, 0, sizeof(r));
+        r.version = kRecordVersion;
+        r.kind = quint8(key.at(0));
+        r.payloadSize = quint32(it->payload.size());
+        r.height = it->height;
+        std::memcpy(r.hash, key.constData() + 1, sizeof(r.hash));
+        out.append(reinterpret_cast<const char *>(&r), int(sizeof(r)));
+        out.append(it->payload);
+    }
+    return out;
+}
+
+void ChainCache::parse(const uchar *data, qint64 size)
+{
+    qint64 pos = 0;
+    while (pos + qint64(sizeof(Record)) <= size) {
+        Record r;
+        std::memcpy(&r, data + pos, sizeof(Record));
+        pos += qint64(sizeof(Record));
+        if (r.version != kRecordVersion || pos + qint64(r.payloadSize) > size) {
+            break;      // abgeschnittenes Ende oder fremdes Format
+        }
+        if (r.kind == HeaderKind || r.kind == BlockKind) {
+            // spätere Records gelten als zuletzt benutzt
+            add(Kind(r.kind), r.height, QByteArray(r.hash, int(sizeof(r.hash))),
+                QByteArray(reinterpret_cast<const char *>(data + pos), int(r.payloadSize)));
+        }
+        pos += qint64(r.payloadSize);
+    }
+    evict();
+}
+
+/**
+ * @brief ChainCache::flush
+ * Hängt die gesammelten Einträge an. Enthält die Datei mehr als doppelt so
+ * viel wie die lebenden Einträge (Verdrängte, Header durch Blöcke ersetzt),
+ * wird sie in LRU-Reihenfolge neu geschrieben.
+ */
+void ChainCache::flush()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty() || !isOpen()) {
+        return;
+    }
+
+    const QByteArray appended = serialize(m_pending);
+    const bool compact = m_store.size() + appended.size() > 2 * m_liveBytes + kCompactSlackBytes;
+    const bool written = compact ? m_store.rewrite(serialize(m_lru.values())) : m_store.append(appended);
+    if (!written) {
+        return;
+    }
+    m_pending.clear();
+}
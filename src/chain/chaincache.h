@@ -0,0 +1,117 @@
+#ifndef CHAINCACHE_H
+#define CHAINCACHE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+
+#include "storage/appendlogstore.h"
+
+// Persistenter Cache für Header und Blöcke unterhalb des Reorg-Horizonts
+// (Tip - kReorgHorizon); darüber wird nichts gespeichert, weil sich diese
+// Höhen noch ändern können. Schlüssel ist der Hash, daneben ein Index je Höhe.
+// Pro Chain (Genesis-Hash) ein eigener Speicher, siehe open().
+// Log aus 48-Byte-Recordkopf + CBOR-Payload im AppendLogStore, nur
+// angehängt und bei zu viel Überholtem kompaktiert (in LRU-Reihenfolge,
+// damit die Reihenfolge den Neustart überlebt).
+// Größe ist auf kBudgetBytes Payload begrenzt, verdrängt wird per LRU.
+class ChainCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ChainCache(QObject *parent = nullptr);
+    ~ChainCache() override;
+
+    // Speicher der Chain mit diesem Genesis-Hash laden; vorher ist der
+    // Cache leer und speichert nichts
+    void open(const QString &genesisHash);
+    bool isOpen() const
+    {
+        return !m_chainId.isEmpty();
+    }
+    QString chainId() const
+    {
+        return m_chainId;
+    }
+
+    void setTipHeight(qint64 height);
+    qint64 tipHeight() const
+    {
+        return m_tipHeight;
+    }
+    // Höhe liegt unter dem Reorg-Horizont und darf gecacht werden
+    bool isFinal(qint64 height) const;
+    // Höchste finale Höhe, -1 = Tip unbekannt
+    qint64 finalHeight() const;
+
+    // Ungültiges QVariant, wenn nicht im Cache. header() nimmt auch den
+    // Header eines gecachten Blocks.
+    QVariant header(qint64 height);
+    QVariant headerByHash(const QString &hash);
+    QVariant block(qint64 height);
+    QVariant blockByHash(const QString &hash);
+
+    // Werte wie von v2/foreign (JSON-Objekt als QVariantMap)
+    void insertHeader(const QVariant &header);
+    void insertBlock(const QVariant &block);
+
+    int size() const
+    {
+        return m_entries.size();
+    }
+
+    // Ausstehende Einträge sofort schreiben (sonst gebündelt per Timer)
+    void flush();
+
+private:
+    enum Kind : quint8 {
+        HeaderKind = 1,
+        BlockKind = 2
+    };
+
+    // Recordkopf auf Platte / im IndexedDB-Blob, danach payloadSize Byte CBOR
+    struct Record {
+        quint8 version;
+        quint8 kind;
+        quint16 reserved;
+        quint32 payloadSize;
+        qint64 height;
+        char hash[32];
+    };
+
+    struct Entry {
+        qint64 height = -1;
+        QByteArray payload;     // CBOR
+        quint64 lastUse = 0;
+    };
+
+    static QByteArray keyOf(Kind kind, const QByteArray &hash);
+    QVariant lookup(const QByteArray &key);
+    void add(Kind kind, qint64 height, const QByteArray &hash, const QByteArray &payload);
+    void put(Kind kind, qint64 height, const QByteArray &hash, const QByteArray &payload);
+    void remove(const QByteArray &key);
+    void touch(const QByteArray &key, Entry &e);
+    void evict();
+    void scheduleFlush();
+    QByteArray serialize(const QVector<QByteArray> &keys) const;
+    void parse(const uchar *data, qint64 size);
+
+    QHash<QByteArray, Entry> m_entries;     // Kind + Hash (binär)
+    QHash<qint64, QByteArray> m_headerAt;   // Höhe -> Schlüssel
+    QHash<qint64, QByteArray> m_blockAt;
+    QMap<quint64, QByteArray> m_lru;        // lastUse -> Schlüssel
+    quint64 m_clock = 0;
+    qint64 m_liveBytes = 0;
+    QVector<QByteArray> m_pending;
+    QTimer m_flushTimer;
+    AppendLogStore m_store;
+    QString m_chainId;
+    qint64 m_tipHeight = -1;
+};
+
+#endif // CHAINCACHE_H
@@ -0,0 +1,725 @@
+#include "chainrpc.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QHash>
+#include <QMap>
+#include <QSettings>
+#include <QSharedPointer>
+#include <QTimer>
+
+namespace {
+
+const int kMaxHeadersPerRequest = 250;
+const qint64 kBlockTimeMs = 60000;
+// Höchstens so viele Höhen unter dem Start darf der spekulative
+// Outputs-Abruf beginnen (sonst füllen fremde Outputs die Seite)
+const qint64 kMaxSpeculativeGap = 16;
+const int kBackfillBlocks = 100;
+const int kBackfillPauseMs = 250;       // Node zwischen den Abschnitten Luft lassen
+const int kBackfillRetryMs = 5000;
+const char kBackfillKey[] = "chain/kernelBackfill";
+
+int heightOf(const QVariant &item)
+{
+    const QVariantMap map = item.toMap();
+    const QVariant header = map.value("header");
+    return (header.isValid() ? header.toMap() : map).value("height", -1).toInt();
+}
+
+} // namespace
+
+ChainRpc::ChainRpc(JsonRpcBatcher *rpc, QObject *parent) :
+    QObject(parent),
+    m_rpc(rpc),
+    m_cache(new ChainCache(this)),
+    m_pmmr(new PmmrIndexMap(this)),
+    m_kernels(new KernelIndex(this)),
+    m_kernelBackfill(QSettings().value(kBackfillKey, false).toBool())
+{
+}
+
+// ---------- Transport ----------
+
+void ChainRpc::setUrl(const QString &url)
+{
+    if (url == this->url()) {
+        return;
+    }
+    m_rpc->setUrl(QUrl(url));
+    m_genesisStale = true;
+    emit endpointChanged();
+}
+
+void ChainRpc::setAuthHeader(const QString &header)
+{
+    if (header == authHeader()) {
+        return;
+    }
+    m_rpc->setAuthHeader(header);
+    emit endpointChanged();
+}
+
+// Ein Aufruf über den Batcher; done bekommt result.Ok bzw. den Fehlertext
+int ChainRpc::request(const QString &method, const QJsonArray &params, Done done)
+{
+    return m_rpc->call(method, params, [done](const QJsonObject &response, const QString &error) {
+        QString err = error;
+        const QVariant result = err.isEmpty() ? unwrap(response, &err) : QVariant();
+        done(result, err);
+    });
+}
+
+// result.Ok bzw. Fehlertext aus error / result.Err
+QVariant ChainRpc::unwrap(const QJsonObject &response, QString *error)
+{
+    const QJsonValue ok = JsonRpcBatcher::okResult(response, error);
+    return error->isEmpty() ? ok.toVariant() : QVariant();
+}
+
+// ---------- Cache ----------
+
+/**
+ * @brief ChainRpc::setTipHeight
+ * Legt den Reorg-Horizont des Caches fest. Beim ersten Tip (und wenn der Tip
+ * zurückgeht, etwa nach einem Wechsel des Nodes, sowie nach setUrl()) wird
+ * der Genesis-Header geholt, um den Speicher der richtigen Chain zu öffnen.
+ */
+void ChainRpc::setTipHeight(int height)
+{
+    const bool recheck = !m_cache->isOpen() || height < m_cache->tipHeight() || m_genesisStale;
+    m_cache->setTipHeight(height);
+    backfillKernels();
+    if (recheck) {
+        lookupChain();
+    }
+}
+
+void ChainRpc::lookupChain()
+{
+    if (m_genesisPending) {
+        return;
+    }
+    m_genesisPending = true;
+    m_genesisStale = false;
+    request("get_header", QJsonArray{ 0, QJsonValue::Null, QJsonValue::Null }, [this](const QVariant &genesis, const QString &error) {
+        m_genesisPending = false;
+        const QString hash = genesis.toMap().value("hash").toString();
+        if (!error.isEmpty() || hash.isEmpty()) {
+            const QString message = error.isEmpty() ? QStringLiteral("genesis lookup failed") : error;
+            qWarning() << "ChainRpc: genesis lookup failed, cache stays closed:" << message;
+            emit chainLookupFailed(message);
+            return;
+        }
+        m_cache->open(hash);
+        m_pmmr->open(m_cache->chainId());
+        m_kernels->open(m_cache->chainId());
+        emit kernelIndexChanged();
+        emit chainOpened();
+        backfillKernels();
+    });
+}
+
+// Signal aus dem Cache erst nach Rückkehr des Aufrufs (wie bei Netzantworten)
+void ChainRpc::deliver(std::function<void()> emitter)
+{
+    QTimer::singleShot(0, this, emitter);
+}
+
+void ChainRpc::remember(const QVariant &item, bool isBlock)
+{
+    if (isBlock) {
+        m_cache->insertBlock(item);
+    } else {
+        m_cache->insertHeader(item);
+    }
+    const bool final = m_cache->isFinal(heightOf(item));
+    m_pmmr->insertHeader(item, final);
+    if (isBlock) {
+        m_kernels->insertBlock(item, final);
+    }
+}
+
+// Auch Cache-Treffer füttern PmmrIndexMap und KernelIndex (Cache älter als diese)
+void ChainRpc::learn(const QVariantList &items)
+{
+    for (const QVariant &item : items) {
+        const bool final = m_cache->isFinal(heightOf(item));
+        m_pmmr->insertHeader(item, final);
+        m_kernels->insertBlock(item, final);
+    }
+}
+
+// ---------- Tip ----------
+
+/**
+ * @brief ChainRpc::refreshTipAsync
+ * get_tip und die vermutlich neuen Höhen in einem Batch statt zwei
+ * Round-Trips nacheinander. Vorhergesagt wird aus dem letzten Tip und der
+ * verstrichenen Zeit (ein Block pro Minute): [letzter Tip, Vorhersage],
+ * höchstens count Höhen; der letzte Tip selbst dient dem Modell zur
+ * Reorg-Prüfung. Liegt der echte Tip darüber, lädt finishTipRefresh() die
+ * fehlenden Höhen nach, bevor tipRefreshed kommt.
+ * withBlocks: volle Blöcke (get_blocks) statt Header.
+ */
+int ChainRpc::refreshTipAsync(int count, bool withBlocks)
+{
+    const int requestId = ++m_tipRequestId;
+    count = qMax(1, count);
+
+    struct Pending {
+        int remaining = 0;
+        QVariantMap tip;
+        QString tipError;
+        QMap<int, QVariant> items;
+    };
+    QSharedPointer<Pending> pending(new Pending);
+    auto done = [this, requestId, count, withBlocks, pending]() {
+        if (--pending->remaining > 0) {
+            return;
+        }
+        if (pending->tip.isEmpty()) {
+            emit tipRefreshFailed(requestId, pending->tipError);
+            return;
+        }
+        finishTipRefresh(requestId, pending->tip, pending->items, count, withBlocks);
+    };
+
+    // Ohne Batch-Unterstützung kostet jede vorhergesagte Höhe einen eigenen
+    // Request; dann nur get_tip und fehlende Header über die Seiten laden
+    const bool predict = m_lastTip >= 0 && (withBlocks || m_rpc->batchSupported());
+    int first = 0;
+    int last = -1;
+    if (predict) {
+        const qint64 elapsed = QDateTime::currentMSecsSinceEpoch() - m_lastTipMs;
+        last = int(m_lastTip + qMax<qint64>(1, (elapsed + kBlockTimeMs / 2) / kBlockTimeMs));
+        first = qMax(0, qMax(int(m_lastTip), last - count + 1));
+    }
+    pending->remaining = 1 + (last < first ? 0 : withBlocks ? 1 : last - first + 1);
+
+    m_rpc->beginGroup();
+    request("get_tip", QJsonArray(), [pending, done](const QVariant &tip, const QString &error) {
+        pending->tip = tip.toMap();
+        pending->tipError = error;
+        done();
+    });
+    if (withBlocks && last >= first) {
+        request("get_blocks", QJsonArray{ first, last, last - first + 1, false }, [pending, done](const QVariant &listing, const QString &) {
+            for (const QVariant &block : listing.toMap().value("blocks").toList()) {
+                pending->items.insert(heightOf(block), block);
+            }
+            done();
+        });
+    } else {
+        for (int h = first; h <= last; ++h) {
+            // Fehler = vorhergesagte Höhe über dem Tip
+            request("get_header", QJsonArray{ h, QJsonValue::Null, QJsonValue::Null }, [pending, done](const QVariant &header, const QString &error) {
+                if (error.isEmpty() && header.isValid()) {
+                    pending->items.insert(heightOf(header), header);
+                }
+                done();
+            });
+        }
+    }
+    m_rpc->endGroup();
+    return requestId;
+}
+
+/**
+ * @brief ChainRpc::finishTipRefresh
+ * Gleicht die spekulativ geladenen Höhen mit dem echten Tip ab: Höhen über
+ * dem Tip fallen weg, fehlen oben welche (Tip weiter als vorhergesagt oder
+ * erster Aufruf), kommen sie mit einem weiteren Request dazu.
+ */
+void ChainRpc::finishTipRefresh(int requestId, const QVariantMap &tip, QMap<int, QVariant> items, int count, bool withBlocks)
+{
+    const int height = tip.value("height").toInt();
+    m_lastTip = height;
+    m_lastTipMs = QDateTime::currentMSecsSinceEpoch();
+    setTipHeight(height);
+
+    while (!items.isEmpty() && items.lastKey() > height) {
+        items.remove(items.lastKey());
+    }
+    for (const QVariant &item : items) {
+        remember(item, withBlocks);
+    }
+
+    const int first = qMax(0, qMax(height - count + 1, items.isEmpty() ? 0 : items.lastKey() + 1));
+    // Header ohne Batch: fehlende Seiten lädt das Modell selbst
+    if (first > height || (!withBlocks && !m_rpc->batchSupported())) {
+        emit tipRefreshed(requestId, tip, items.values());
+        return;
+    }
+
+    struct Pending {
+        int remaining = 0;
+        QMap<int, QVariant> items;
+    };
+    QSharedPointer<Pending> pending(new Pending);
+    pending->items = items;
+    pending->remaining = withBlocks ? 1 : height - first + 1;
+    auto collect = [this, requestId, tip, withBlocks, pending](const QVariantList &list) {
+        for (const QVariant &item : list) {
+            pending->items.insert(heightOf(item), item);
+            remember(item, withBlocks);
+        }
+        if (--pending->remaining == 0) {
+            emit tipRefreshed(requestId, tip, pending->items.values());
+        }
+    };
+
+    m_rpc->beginGroup();
+    if (withBlocks) {
+        request("get_blocks", QJsonArray{ first, height, height - first + 1, false }, [collect](const QVariant &listing, const QString &) {
+            collect(listing.toMap().value("blocks").toList());
+        });
+    } else {
+        for (int h = first; h <= height; ++h) {
+            request("get_header", QJsonArray{ h, QJsonValue::Null, QJsonValue::Null }, [collect](const QVariant &header, const QString &error) {
+                collect(error.isEmpty() && header.isValid() ? QVariantList{ header } : QVariantList());
+            });
+        }
+    }
+    m_rpc->endGroup();
+}
+
+// ---------- Header ----------
+
+/**
+ * @brief ChainRpc::getHeadersAsync
+ * Höhen unter dem Reorg-Horizont kommen aus dem Cache, der Rest als eine
+ * Gruppe von get_header-Aufrufen, die der Batcher als ein Request sendet.
+ * Die Signale tragen den angefragten Bereich [start, end].
+ */
+void ChainRpc::getHeadersAsync(int start, int end)
+{
+    const int first = qMax(0, qMax(start, end - kMaxHeadersPerRequest + 1));
+    QMap<int, QVariant> cached;
+    QVector<int> missing;
+    for (int h = first; h <= end; ++h) {
+        const QVariant header = m_cache->header(h);
+        if (header.isValid()) {
+            cached.insert(h, header);
+        } else {
+            missing.append(h);
+        }
+    }
+
+    learn(cached.values());
+    if (missing.isEmpty()) {
+        const QVariantList headers = cached.values();
+        deliver([this, start, end, headers]() { emit headersUpdated(start, end, headers); });
+        return;
+    }
+
+    struct Pending {
+        int remaining = 0;
+        QMap<int, QVariant> byHeight;
+        QString lastError;
+        QVector<int> ids;
+    };
+    QSharedPointer<Pending> pending(new Pending);
+    pending->remaining = missing.size();
+    pending->byHeight = cached;
+    const QPair<int, int> key(start, end);
+
+    m_rpc->beginGroup();
+    for (int h : missing) {
+        const int id = request("get_header", QJsonArray{ h, QJsonValue::Null, QJsonValue::Null },
+                               [this, key, h, pending](const QVariant &header, const QString &error) {
+            if (error.isEmpty() && header.isValid()) {
+                pending->byHeight.insert(h, header);
+                remember(header, false);
+            } else {
+                pending->lastError = error;
+            }
+
+            if (--pending->remaining > 0) {
+                return;
+            }
+            for (int callId : pending->ids) {
+                m_headerCalls.remove(key, callId);
+            }
+            if (pending->byHeight.isEmpty() && !pending->lastError.isEmpty()) {
+                emit headersLookupFailed(key.first, key.second, pending->lastError);
+            } else {
+                emit headersUpdated(key.first, key.second, pending->byHeight.values());
+            }
+        });
+        pending->ids.append(id);
+        m_headerCalls.insert(key, id);
+    }
+    m_rpc->endGroup();
+}
+
+void ChainRpc::abortHeaders(int start, int end)
+{
+    const QList<int> ids = m_headerCalls.values(qMakePair(start, end));
+    m_headerCalls.remove(qMakePair(start, end));
+    for (int id : ids) {
+        m_rpc->cancel(id);
+    }
+}
+
+void ChainRpc::getHeaderAsync(int height, const QString &hash)
+{
+    const bool byHash = !hash.trimmed().isEmpty();
+    const QVariant cached = byHash ? m_cache->headerByHash(hash.trimmed()) : m_cache->header(height);
+    if (cached.isValid()) {
+        deliver([this, cached]() { emit headerUpdated(cached); });
+        return;
+    }
+
+    const QJsonArray params{ byHash ? QJsonValue::Null : QJsonValue(height),
+                             byHash ? QJsonValue(hash.trimmed()) : QJsonValue::Null,
+                             QJsonValue::Null };
+    request("get_header", params, [this](const QVariant &header, const QString &error) {
+        if (!error.isEmpty() || !header.isValid()) {
+            emit headerLookupFailed(error);
+            return;
+        }
+        remember(header, false);
+        emit headerUpdated(header);
+    });
+}
+
+// ---------- Blöcke ----------
+
+/**
+ * @brief ChainRpc::getBlocksAsync
+ * Gecachte Blöcke am Rand des Bereichs werden nicht erneut geladen; get_blocks
+ * holt nur [erste, letzte] fehlende Höhe.
+ */
+int ChainRpc::getBlocksAsync(int start, int end)
+{
+    const int requestId = ++m_blocksRequestId;
+    start = qMax(0, start);
+    QMap<int, QVariant> cached;
+    int lo = -1;
+    int hi = -1;
+    for (int h = start; h <= end; ++h) {
+        const QVariant block = m_cache->block(h);
+        if (block.isValid()) {
+            cached.insert(h, block);
+            continue;
+        }
+        lo = lo < 0 ? h : lo;
+        hi = h;
+    }
+
+    learn(cached.values());
+    if (lo < 0) {
+        const QVariantList blocks = cached.values();
+        deliver([this, requestId, blocks, end]() {
+            emit blocksUpdated(requestId, blocks, blocks.isEmpty() ? -1 : end);
+        });
+        return requestId;
+    }
+
+    request("get_blocks", QJsonArray{ lo, hi, hi - lo + 1, false },
+            [this, requestId, cached](const QVariant &result, const QString &error) {
+        if (!error.isEmpty()) {
+            emit blocksLookupFailed(requestId, error);
+            return;
+        }
+
+        const QVariantMap listing = result.toMap();
+        QMap<int, QVariant> byHeight = cached;
+        for (const QVariant &block : listing.value("blocks").toList()) {
+            remember(block, true);
+            byHeight.insert(heightOf(block), block);
+        }
+        const int lastRetrieved = qMax(listing.value("last_retrieved_height", -1).toInt(),
+                                       byHeight.isEmpty() ? -1 : byHeight.lastKey());
+        emit blocksUpdated(requestId, byHeight.values(), lastRetrieved);
+    });
+    return requestId;
+}
+
+void ChainRpc::getBlockAsync(int height, const QString &hash)
+{
+    const bool byHash = !hash.trimmed().isEmpty();
+    const QVariant cached = byHash ? m_cache->blockByHash(hash.trimmed()) : m_cache->block(height);
+    if (cached.isValid()) {
+        deliver([this, cached]() { emit blockUpdated(cached); });
+        return;
+    }
+
+    const QJsonArray params{ byHash ? QJsonValue::Null : QJsonValue(height),
+                             byHash ? QJsonValue(hash.trimmed()) : QJsonValue::Null,
+                             QJsonValue::Null };
+    request("get_block", params, [this](const QVariant &block, const QString &error) {
+        if (!error.isEmpty() || !block.isValid()) {
+            emit blockLookupFailed(error);
+            return;
+        }
+        remember(block, true);
+        emit blockUpdated(block);
+    });
+}
+
+// ---------- Outputs nach Höhe ----------
+
+/**
+ * @brief ChainRpc::getOutputsByHeightAsync
+ * Kennt die PmmrIndexMap size(startHeight - 1) und size(endHeight), geht nur
+ * get_unspent_outputs über genau diesen Bereich raus. Sonst laufen
+ * get_pmmr_indices und - wenn knapp unter dem Start eine Höhe bekannt ist -
+ * spekulativ schon get_unspent_outputs ab dort im selben Batch. Die
+ * Outputs unter dem Bereich werden verworfen; reicht die Seite dann nicht,
+ * folgt ein zweiter Abruf. Das Ergebnis von get_pmmr_indices landet in der
+ * Map, dieselbe Abfrage geht beim nächsten Mal direkt.
+ */
+int ChainRpc::getOutputsByHeightAsync(int startHeight, int endHeight, int max, bool includeProof)
+{
+    const int requestId = ++m_outputsRequestId;
+    startHeight = qMax(0, startHeight);
+    endHeight = qMax(startHeight, endHeight);
+    max = qMax(1, max);
+
+    const qint64 below = m_pmmr->sizeAt(startHeight - 1);
+    const qint64 top = m_pmmr->sizeAt(endHeight);
+    if (below >= 0 && top > below) {
+        fetchOutputs(requestId, below + 1, top, max, includeProof);
+        return requestId;
+    }
+
+    struct Pending {
+        int remaining = 0;
+        qint64 first = -1;
+        qint64 last = -1;
+        QString error;
+        bool speculated = false;
+        QVariantMap listing;
+        QString listingError;
+    };
+    QSharedPointer<Pending> pending(new Pending);
+
+    // Spekulativer Bereich aus den nächsten bekannten Nachbarn
+    const qint64 lowKnown = startHeight == 0 ? -1 : m_pmmr->knownAtOrBelow(startHeight - 1);
+    const bool speculate = below >= 0 || (lowKnown >= 0 && startHeight - 1 - lowKnown <= kMaxSpeculativeGap);
+    const qint64 specFirst = below >= 0 ? below + 1 : speculate ? m_pmmr->sizeAt(lowKnown) + 1 : -1;
+    const qint64 highKnown = m_pmmr->knownAtOrAbove(endHeight);
+    const QJsonValue specLast = highKnown >= 0 ? QJsonValue(double(m_pmmr->sizeAt(highKnown))) : QJsonValue(QJsonValue::Null);
+    pending->speculated = speculate;
+    pending->remaining = speculate ? 2 : 1;
+
+    auto done = [this, requestId, max, includeProof, pending]() {
+        if (--pending->remaining > 0) {
+            return;
+        }
+        if (!pending->error.isEmpty()) {
+            emit outputsByHeightLookupFailed(requestId, pending->error);
+            return;
+        }
+        if (!pending->speculated || !pending->listingError.isEmpty()) {
+            fetchOutputs(requestId, pending->first, pending->last, max, includeProof);
+            return;
+        }
+
+        // Spekulative Seite auf [first, last] zuschneiden
+        const QVariantList all = pending->listing.value("outputs").toList();
+        QVariantList outputs;
+        for (const QVariant &o : all) {
+            const qint64 index = o.toMap().value("mmr_index").toLongLong();
+            if (index >= pending->first && index <= pending->last && outputs.size() < max) {
+                outputs.append(o);
+            }
+        }
+        const qint64 lastRetrieved = pending->listing.value("last_retrieved_index").toLongLong();
+        const int highest = pending->listing.value("highest_index").toInt();
+        if (outputs.size() >= max) {
+            emit outputsByHeightUpdated(requestId, int(pending->first), int(pending->last), outputs, highest,
+                                        outputs.last().toMap().value("mmr_index").toInt());
+            return;
+        }
+        if (all.size() < max || lastRetrieved >= pending->last) {
+            emit outputsByHeightUpdated(requestId, int(pending->first), int(pending->last), outputs, highest,
+                                        int(pending->last));
+            return;
+        }
+        // Seite war vor dem Bereichsende voll: Rest nachladen
+        fetchOutputs(requestId, pending->first, pending->last, max, includeProof,
+                     qMax(pending->first, lastRetrieved + 1), outputs);
+    };
+
+    m_rpc->beginGroup();
+    request("get_pmmr_indices", QJsonArray{ startHeight, endHeight }, [this, startHeight, endHeight, pending, done](const QVariant &result, const QString &error) {
+        const QVariantMap range = result.toMap();
+        const qint64 start = range.value("last_retrieved_index", -1).toLongLong();
+        const qint64 end = range.value("highest_index", -1).toLongLong();
+        if (!error.isEmpty() || end <= 0) {
+            pending->error = error.isEmpty() ? QStringLiteral("No PMMR indices found for this block height range.") : error;
+        } else {
+            // Grin liefert für Höhe 0 als Start 0, sonst size(start - 1) + 1
+            pending->first = qMax<qint64>(1, start);
+            pending->last = end;
+            if (startHeight > 0) {
+                m_pmmr->insert(startHeight - 1, start - 1, m_cache->isFinal(startHeight - 1));
+            }
+            m_pmmr->insert(endHeight, end, m_cache->isFinal(endHeight));
+        }
+        done();
+    });
+    if (speculate) {
+        const QJsonArray params{ double(specFirst), specLast, max, includeProof };
+        request("get_unspent_outputs", params, [pending, done](const QVariant &result, const QString &error) {
+            pending->listing = result.toMap();
+            pending->listingError = error;
+            done();
+        });
+    }
+    m_rpc->endGroup();
+    return requestId;
+}
+
+// Outputs aus [from, last] (from < 0: ab first), vorne head anhängen
+void ChainRpc::fetchOutputs(int requestId, qint64 first, qint64 last, int max, bool includeProof,
+                            qint64 from, const QVariantList &head)
+{
+    const qint64 start = from < 0 ? first : from;
+    const QJsonArray params{ double(start), double(last), max - head.size(), includeProof };
+    request("get_unspent_outputs", params, [this, requestId, first, last, head](const QVariant &result, const QString &error) {
+        if (!error.isEmpty()) {
+            emit outputsByHeightLookupFailed(requestId, error);
+            return;
+        }
+        const QVariantMap listing = result.toMap();
+        emit outputsByHeightUpdated(requestId, int(first), int(last), head + listing.value("outputs").toList(),
+                                    listing.value("highest_index").toInt(),
+                                    listing.value("last_retrieved_index").toInt());
+    });
+}
+
+// ---------- Kernel ----------
+
+/**
+ * @brief ChainRpc::findKernelAsync
+ * Kennt der KernelIndex den Excess, fragt get_kernel nur dessen Höhe ab
+ * (passt sie nicht, etwa nach einem Reorg, folgt der ganze Bereich). Sonst
+ * wird der lückenlos indizierte Teil vom Bereich abgezogen: liegt der ganze
+ * Bereich darin, gibt es den Kernel dort nicht.
+ */
+int ChainRpc::findKernelAsync(const QString &excess, int minHeight, int maxHeight)
+{
+    const int requestId = ++m_kernelRequestId;
+    const QString key = excess.trimmed().toLower();
+    qint64 low = qMax(0, minHeight);
+    qint64 high = maxHeight > 0 ? qint64(maxHeight) : -1;   // -1 = bis Tip
+
+    const qint64 known = m_kernels->heightOf(key);
+    if (known >= low && (high < 0 || known <= high)) {
+        lookupKernel(requestId, key, known, known, true, low, high);
+        return requestId;
+    }
+
+    const qint64 coveredLow = m_kernels->coveredLow();
+    const qint64 coveredHigh = m_kernels->coveredHigh();
+    if (coveredLow >= 0 && coveredLow <= low && high >= 0 && coveredHigh >= high) {
+        deliver([this, requestId]() {
+            emit kernelLookupFailed(requestId, QStringLiteral("Kernel not found in the indexed height range."));
+        });
+        return requestId;
+    }
+    if (coveredLow >= 0 && coveredLow <= low && coveredHigh >= low) {
+        low = coveredHigh + 1;
+    } else if (coveredLow >= 0 && high >= 0 && coveredLow <= high && coveredHigh >= high) {
+        high = coveredLow - 1;
+    }
+    lookupKernel(requestId, key, low, high, false, low, high);
+    return requestId;
+}
+
+void ChainRpc::lookupKernel(int requestId, const QString &excess, qint64 low, qint64 high, bool narrowed,
+                            qint64 fullLow, qint64 fullHigh)
+{
+    const QJsonArray params{ excess,
+                             QJsonValue(double(low)),
+                             high >= 0 ? QJsonValue(double(high)) : QJsonValue(QJsonValue::Null) };
+    request("get_kernel", params, [this, requestId, excess, narrowed, fullLow, fullHigh](const QVariant &kernel, const QString &error) {
+        const QVariantMap located = kernel.toMap();
+        // Der Index kennt nur 8 Byte des Excess: Treffer am vollen Excess prüfen
+        const QString found = located.value("tx_kernel").toMap().value("excess").toString().toLower();
+        if (!error.isEmpty() || located.isEmpty() || found != excess) {
+            if (narrowed) {
+                lookupKernel(requestId, excess, fullLow, fullHigh, false, fullLow, fullHigh);
+                return;
+            }
+            emit kernelLookupFailed(requestId, error.isEmpty() && !located.isEmpty()
+                                    ? QStringLiteral("Kernel not found.") : error);
+            return;
+        }
+        const qint64 height = located.value("height").toLongLong();
+        m_kernels->insert(excess, height, m_cache->isFinal(height));
+        emit kernelUpdated(requestId, kernel);
+    });
+}
+
+void ChainRpc::setKernelBackfill(bool enabled)
+{
+    if (m_kernelBackfill == enabled) {
+        return;
+    }
+    m_kernelBackfill = enabled;
+    QSettings().setValue(kBackfillKey, enabled);
+    emit kernelIndexChanged();
+    backfillKernels();
+}
+
+/**
+ * @brief ChainRpc::backfillKernels
+ * Ein Abschnitt von kBackfillBlocks finalen Blöcken per get_blocks (ohne
+ * ChainCache, der würde sonst verdrängt): zuerst die Lücke zwischen
+ * indiziertem Bereich und finalem Tip, dann abwärts bis Genesis.
+ */
+void ChainRpc::backfillKernels()
+{
+    if (!m_kernelBackfill || m_backfillPending || !m_cache->isOpen()) {
+        return;
+    }
+    const qint64 finalHeight = m_cache->finalHeight();
+    if (finalHeight < 0) {
+        return;
+    }
+
+    const qint64 coveredLow = m_kernels->coveredLow();
+    const qint64 coveredHigh = m_kernels->coveredHigh();
+    qint64 low = 0;
+    qint64 high = -1;
+    if (coveredLow < 0) {
+        high = finalHeight;
+        low = qMax<qint64>(0, high - kBackfillBlocks + 1);
+    } else if (coveredHigh < finalHeight) {
+        low = coveredHigh + 1;
+        high = qMin(finalHeight, coveredHigh + kBackfillBlocks);
+    } else if (coveredLow > 0) {
+        high = coveredLow - 1;
+        low = qMax<qint64>(0, high - kBackfillBlocks + 1);
+    } else {
+        return;     // vollständig
+    }
+
+    m_backfillPending = true;
+    const QJsonArray params{ double(low), double(high), double(high - low + 1), false };
+    request("get_blocks", params, [this, low, high](const QVariant &result, const QString &error) {
+        m_backfillPending = false;
+        const QVariantList blocks = result.toMap().value("blocks").toList();
+        if (!error.isEmpty() || blocks.size() != high - low + 1) {
+            if (!error.isEmpty()) {
+                qWarning() << "ChainRpc: kernel backfill" << low << "-" << high << "failed:" << error;
+            }
+            QTimer::singleShot(kBackfillRetryMs, this, &ChainRpc::backfillKernels);
+            return;
+        }
+        // Abwärts von oben anwenden, damit jeder Block an den Bereich anschließt
+        const bool downward = high < m_kernels->coveredLow();
+        for (int i = 0; i < blocks.size(); ++i) {
+            const QVariant &block = blocks.at(downward ? blocks.size() - 1 - i : i);
+            m_pmmr->insertHeader(block, true);
+            m_kernels->insertBlock(block, true);
+        }
+        emit kernelIndexChanged();
+        QTimer::singleShot(kBackfillPauseMs, this, &ChainRpc::backfillKernels);
+    });
+}
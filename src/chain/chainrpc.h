@@ -0,0 +1,168 @@
+#ifndef CHAINRPC_H
+#define CHAINRPC_H
+
+#include <QObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QMultiHash>
+#include <QPair>
+#include <QVariantList>
+#include <QVector>
+
+#include "chaincache.h"
+#include "jsonrpcbatcher.h"
+#include "kernelindex.h"
+#include "pmmrindexmap.h"
+
+#include <functional>
+
+// Schlanker JSON-RPC-Client gegen v2/foreign für die Chain-Ansicht.
+// Alle Aufrufe laufen über einen JsonRpcBatcher: Header einer Seite gehen
+// als eine Gruppe von get_header-Aufrufen raus, gleichzeitige Aufrufe
+// (Seiten, Tip, Körper) teilen sich einen Request. Blockkörper kommen über
+// get_blocks.
+// Antworten tragen den angefragten Bereich, damit das Modell sie seinen
+// Seiten zuordnen kann; abortHeaders() bricht einen Bereich ab.
+// Header und Blöcke unter dem Reorg-Horizont kommen aus dem persistenten
+// ChainCache ohne Netzanfrage; dafür muss setTipHeight() den Tip kennen.
+// refreshTipAsync() holt Tip und die neuesten Höhen in einem Batch.
+// Jeder Header und Block füttert die PmmrIndexMap; getOutputsByHeightAsync()
+// braucht damit für bekannte Höhen nur noch get_unspent_outputs.
+// Ebenso der KernelIndex: findKernelAsync() fragt für bekannte Kernel nur
+// deren Höhe ab und lässt den lückenlos indizierten Bereich aus; der
+// optionale Backfill füllt den Index im Hintergrund.
+class ChainRpc : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString url READ url WRITE setUrl NOTIFY endpointChanged)
+    Q_PROPERTY(QString authHeader READ authHeader WRITE setAuthHeader NOTIFY endpointChanged)
+    Q_PROPERTY(bool kernelBackfill READ kernelBackfill WRITE setKernelBackfill NOTIFY kernelIndexChanged)
+    Q_PROPERTY(int kernelIndexSize READ kernelIndexSize NOTIFY kernelIndexChanged)
+    Q_PROPERTY(int kernelIndexLow READ kernelIndexLow NOTIFY kernelIndexChanged)
+    Q_PROPERTY(int kernelIndexHigh READ kernelIndexHigh NOTIFY kernelIndexChanged)
+public:
+    // rpc: Batcher für v2/foreign, geteilt mit den anderen Clients dort
+    explicit ChainRpc(JsonRpcBatcher *rpc, QObject *parent = nullptr);
+
+    // Tip für den Reorg-Horizont des Caches
+    Q_INVOKABLE void setTipHeight(int height);
+    // Genesis holen und die Speicher dieser Chain öffnen; danach kommt
+    // chainOpened() bzw. chainLookupFailed(). Auch für UtxoMirror.
+    void lookupChain();
+    // Erste 16 Hex-Zeichen des Genesis-Hashs, leer solange unbekannt
+    QString chainId() const
+    {
+        return m_cache->chainId();
+    }
+    // Tip plus neueste count Header (bzw. Blöcke) in einem Round-Trip;
+    // Rückgabe ist die requestId der Signale
+    Q_INVOKABLE int refreshTipAsync(int count, bool withBlocks = false);
+
+    // Header [start, end], höchstens kMaxHeadersPerRequest (die obersten)
+    Q_INVOKABLE void getHeadersAsync(int start, int end);
+    // Laufenden Abruf [start, end] abbrechen; es kommt kein Signal mehr
+    Q_INVOKABLE void abortHeaders(int start, int end);
+    // Vollständige Blöcke [start, end] ohne Rangeproofs; Rückgabe ist die
+    // requestId der Signale (chainRpc wird von mehreren Seiten geteilt)
+    Q_INVOKABLE int getBlocksAsync(int start, int end);
+    // Einzelner Header / Block per Hash (falls gesetzt) oder Höhe
+    Q_INVOKABLE void getHeaderAsync(int height, const QString &hash);
+    Q_INVOKABLE void getBlockAsync(int height, const QString &hash);
+    // Unverbrauchte Outputs der Höhen [startHeight, endHeight], höchstens max;
+    // Rückgabe ist die requestId der Signale
+    Q_INVOKABLE int getOutputsByHeightAsync(int startHeight, int endHeight, int max, bool includeProof);
+    // Kernel per Excess in [minHeight, maxHeight] (maxHeight <= 0: bis Tip);
+    // Rückgabe ist die requestId der Signale
+    Q_INVOKABLE int findKernelAsync(const QString &excess, int minHeight, int maxHeight);
+
+    QString url() const
+    {
+        return m_rpc->url().toString();
+    }
+    // Anderer Endpunkt: beim nächsten Tip wird die Chain neu bestimmt
+    void setUrl(const QString &url);
+    QString authHeader() const
+    {
+        return m_rpc->authHeader();
+    }
+    void setAuthHeader(const QString &header);
+
+    bool kernelBackfill() const
+    {
+        return m_kernelBackfill;
+    }
+    void setKernelBackfill(bool enabled);
+    int kernelIndexSize() const
+    {
+        return m_kernels->size();
+    }
+    int kernelIndexLow() const
+    {
+        return int(m_kernels->coveredLow());
+    }
+    int kernelIndexHigh() const
+    {
+        return int(m_kernels->coveredHigh());
+    }
+
+signals:
+    // items aufsteigend nach Höhe, höchstens bis tip.height
+    void tipRefreshed(int requestId, const QVariantMap &tip, const QVariantList &items);
+    void tipRefreshFailed(int requestId, const QString &message);
+    // Header aufsteigend nach Höhe, fehlende Höhen ausgelassen
+    void headersUpdated(int start, int end, const QVariantList &headers);
+    void headersLookupFailed(int start, int end, const QString &message);
+    void blocksUpdated(int requestId, const QVariantList &blocks, int lastRetrievedHeight);
+    void blocksLookupFailed(int requestId, const QString &message);
+    void headerUpdated(const QVariant &header);
+    void headerLookupFailed(const QString &message);
+    void blockUpdated(const QVariant &block);
+    void blockLookupFailed(const QString &message);
+    // [firstIndex, lastIndex]: MMR-Bereich der Höhen; highestIndex und
+    // lastRetrievedIndex wie bei get_unspent_outputs
+    void outputsByHeightUpdated(int requestId, int firstIndex, int lastIndex, const QVariantList &outputs,
+                                int highestIndex, int lastRetrievedIndex);
+    void outputsByHeightLookupFailed(int requestId, const QString &message);
+    // kernel wie get_kernel: { tx_kernel, height, mmr_index }
+    void kernelUpdated(int requestId, const QVariant &kernel);
+    void kernelLookupFailed(int requestId, const QString &message);
+    void kernelIndexChanged();
+    void chainOpened();
+    void chainLookupFailed(const QString &message);
+    void endpointChanged();
+
+private:
+    using Done = std::function<void(const QVariant &result, const QString &error)>;
+
+    int request(const QString &method, const QJsonArray &params, Done done);
+    void deliver(std::function<void()> emitter);
+    void remember(const QVariant &item, bool isBlock);
+    void learn(const QVariantList &items);
+    void fetchOutputs(int requestId, qint64 first, qint64 last, int max, bool includeProof,
+                      qint64 from = -1, const QVariantList &head = QVariantList());
+    void lookupKernel(int requestId, const QString &excess, qint64 low, qint64 high, bool narrowed,
+                      qint64 fullLow, qint64 fullHigh);
+    void backfillKernels();
+    void finishTipRefresh(int requestId, const QVariantMap &tip, QMap<int, QVariant> items, int count, bool withBlocks);
+    static QVariant unwrap(const QJsonObject &response, QString *error);
+
+    JsonRpcBatcher *m_rpc;
+    QMultiHash<QPair<int, int>, int> m_headerCalls;     // angefragter Bereich -> JSON-RPC-ids
+    ChainCache *m_cache;
+    PmmrIndexMap *m_pmmr;
+    KernelIndex *m_kernels;
+    bool m_kernelBackfill = false;
+    bool m_backfillPending = false;
+    int m_kernelRequestId = 0;
+    bool m_genesisPending = false;
+    bool m_genesisStale = false;
+    int m_tipRequestId = 0;
+    int m_outputsRequestId = 0;
+    int m_blocksRequestId = 0;
+    qint64 m_lastTip = -1;
+    qint64 m_lastTipMs = 0;
+};
+
+#endif // CHAINRPC_H
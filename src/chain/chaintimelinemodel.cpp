@@ -0,0 +1,981 @@
+#include "chaintimelinemodel.h"
+
+#include <QDateTime>
+#include <QJsonObject>
+#include <QMetaProperty>
+#include <QSequentialIterable>
+
+#include <algorithm>
+
+namespace {
+
+const int kPageSize = 50;
+const int kPrefetchAhead = 2;       // Seiten in Scrollrichtung
+const int kPrefetchBehind = 1;      // Seiten entgegen der Scrollrichtung
+const int kMaxInFlight = 3;
+const int kMaxPages = 64;           // ca. 3200 Header im Speicher
+const qint64 kFetchTimeoutMs = 30000;
+const int kMaxReorgSpan = 64;
+const int kBodyCacheSize = 32;
+
+// Blöcke kommen je nach API-Version als QVariantMap, Gadget oder QObject
+QVariantMap toMap(const QVariant &value)
+{
+    const QMetaType type = value.metaType();
+    if (type.id() == QMetaType::QVariantMap) {
+        return value.toMap();
+    }
+    if (type.id() == QMetaType::QJsonObject) {
+        return value.toJsonObject().toVariantMap();
+    }
+
+    QVariantMap out;
+    if (type.flags() & QMetaType::PointerToQObject) {
+        const QObject *obj = value.value<QObject *>();
+        if (!obj) {
+            return out;
+        }
+        const QMetaObject *mo = obj->metaObject();
+        for (int i = mo->propertyOffset(); i < mo->propertyCount(); ++i) {
+            out.insert(QString::fromLatin1(mo->property(i).name()), mo->property(i).read(obj));
+        }
+        return out;
+    }
+    if ((type.flags() & QMetaType::IsGadget) && type.metaObject()) {
+        const QMetaObject *mo = type.metaObject();
+        for (int i = 0; i < mo->propertyCount(); ++i) {
+            out.insert(QString::fromLatin1(mo->property(i).name()),
+                       mo->property(i).readOnGadget(value.constData()));
+        }
+        return out;
+    }
+    return value.canConvert<QVariantMap>() ? value.toMap() : out;
+}
+
+// snake_case (JSON) oder camelCase (Gadget-Property)
+QVariant field(const QVariantMap &map, const char *snake, const char *camel = nullptr)
+{
+    QVariant v = map.value(QLatin1String(snake));
+    if (!v.isValid() && camel) {
+        v = map.value(QLatin1String(camel));
+    }
+    return v;
+}
+
+int listSize(const QVariant &value)
+{
+    if (!value.isValid() || !value.canConvert<QSequentialIterable>()) {
+        return 0;
+    }
+    return int(value.value<QSequentialIterable>().size());
+}
+
+// Anzahl Blätter einer MMR der Größe size (Summe der Gipfel)
+qint64 leafCount(qint64 size)
+{
+    qint64 leaves = 0;
+    for (int h = 61; h >= 0; --h) {
+        const qint64 peak = (qint64(2) << h) - 1;
+        if (size >= peak) {
+            size -= peak;
+            leaves += qint64(1) << h;
+        }
+    }
+    return leaves;
+}
+
+qint64 toSeconds(const QVariant &value)
+{
+    bool ok = false;
+    const qint64 secs = value.toLongLong(&ok);
+    if (ok) {
+        return secs;
+    }
+    const QDateTime dt = QDateTime::fromString(value.toString(), Qt::ISODateWithMs);
+    return dt.isValid() ? dt.toSecsSinceEpoch() : 0;
+}
+
+} // namespace
+
+ChainTimelineModel::ChainTimelineModel(QObject *parent) :
+    QAbstractListModel(parent)
+{
+}
+
+int ChainTimelineModel::pageSize() const
+{
+    return kPageSize;
+}
+
+// ---------- Model ----------
+
+int ChainTimelineModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || m_tipHeight <= 0) {
+        return 0;
+    }
+    return rowOffset() + int(m_tipHeight) + 1;
+}
+
+QVariant ChainTimelineModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    // Platzhalter für den nächsten Block
+    if (index.row() < rowOffset()) {
+        switch (role) {
+        case IsDummyRole: return true;
+        case LoadedRole: return true;
+        case HeightRole: return double(m_tipHeight + 1);
+        case HashRole:
+        case PreviousRole: return QString();
+        case DifficultyRole: return 0.0;
+        case TimestampRole:
+        case InputsRole:
+        case OutputsRole:
+        case KernelsRole: return 0;
+        default: return QVariant();
+        }
+    }
+
+    const qint64 height = heightOfRow(index.row());
+    const Block *b = blockAtHeight(height);
+    if (!b) {
+        // Seite noch nicht geladen: nur die Höhe ist bekannt
+        switch (role) {
+        case IsDummyRole:
+        case LoadedRole: return false;
+        case HeightRole: return double(height);
+        case HashRole:
+        case PreviousRole: return QString();
+        case DifficultyRole: return 0.0;
+        case TimestampRole: return 0;
+        case InputsRole:
+        case OutputsRole:
+        case KernelsRole: return -1;
+        default: return QVariant();
+        }
+    }
+
+    switch (role) {
+    case IsDummyRole: return false;
+    case LoadedRole: return true;
+    case HeightRole: return double(b->height);
+    case HashRole: return b->hash;
+    case PreviousRole: return b->previous;
+    case TimestampRole: return double(b->timestamp);
+    case InputsRole: return b->inputs;
+    case OutputsRole: return b->outputs;
+    case KernelsRole: return b->kernels;
+    case DifficultyRole: return b->difficulty;
+    default: return QVariant();
+    }
+}
+
+QHash<int, QByteArray> ChainTimelineModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles.insert(IsDummyRole, "isDummy");
+    roles.insert(LoadedRole, "loaded");
+    roles.insert(HeightRole, "height");
+    roles.insert(HashRole, "hash");
+    roles.insert(PreviousRole, "previous");
+    roles.insert(TimestampRole, "timestamp");
+    roles.insert(InputsRole, "inputs");
+    roles.insert(OutputsRole, "outputs");
+    roles.insert(KernelsRole, "kernels");
+    roles.insert(DifficultyRole, "difficulty");
+    return roles;
+}
+
+// ---------- Tip ----------
+
+void ChainTimelineModel::setTip(const QVariantMap &tip)
+{
+    applyTip(tip, QVariantList());
+}
+
+/**
+ * @brief ChainTimelineModel::applyTip
+ * Tip zusammen mit den Headern der neuesten Höhen aus demselben Round-Trip
+ * (ChainRpc::refreshTipAsync). Die Header werden übernommen, bevor
+ * schedule() läuft, damit für die neuen Höhen keine Seite mehr angefordert
+ * wird.
+ */
+void ChainTimelineModel::applyTip(const QVariantMap &tip, const QVariantList &headers)
+{
+    if (!updateTip(tip)) {
+        return;
+    }
+    if (!headers.isEmpty()) {
+        bool mismatch = false;
+        if (mergeHeaders(headers, &mismatch) > 0) {
+            // headers aufsteigend nach Höhe
+            emit rangeLoaded(int(parseBlock(headers.first()).height), int(parseBlock(headers.last()).height));
+        }
+    }
+    schedule();
+}
+
+/**
+ * @brief ChainTimelineModel::updateTip
+ * Neue Höhen kommen als Zeilen direkt hinter dem Platzhalter dazu, alle
+ * anderen Zeilen behalten ihre Höhe. Passt der gespeicherte Block auf
+ * Tip-Höhe bzw. Tip-Höhe - 1 nicht mehr zu lastBlockPushed/prevBlockToLast,
+ * wird er verworfen; die Verkettungsprüfung in mergeHeaders() geht von dort
+ * abwärts. false, wenn es keinen Tip gibt (Modell geleert).
+ */
+bool ChainTimelineModel::updateTip(const QVariantMap &tip)
+{
+    const qint64 height = field(tip, "height").toLongLong();
+    const QString hash = field(tip, "last_block_pushed", "lastBlockPushed").toString().toLower();
+    const QString previous = field(tip, "prev_block_to_last", "prevBlockToLast").toString().toLower();
+
+    if (height <= 0) {
+        clear();
+        return false;
+    }
+
+    // fehlgeschlagene Seiten einmal pro Tip erneut versuchen
+    m_failedPages.clear();
+
+    // hängende Abrufe (Antwort nie gekommen)
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QVector<int> expired;
+    for (auto it = m_inFlight.constBegin(); it != m_inFlight.constEnd(); ++it) {
+        if (now - it->startedMs > kFetchTimeoutMs) {
+            expired.append(it.key());
+        }
+    }
+    cancelRequests(expired);
+
+    const qint64 oldTip = m_tipHeight;
+    if (oldTip <= 0) {
+        beginInsertRows(QModelIndex(), 0, int(height) + 1);
+        m_tipHeight = height;
+        endInsertRows();
+    } else if (height > oldTip) {
+        beginInsertRows(QModelIndex(), 1, int(height - oldTip));
+        m_tipHeight = height;
+        endInsertRows();
+        emit dataChanged(index(0), index(0));
+    } else if (height < oldTip) {
+        removeAbove(height);
+        beginRemoveRows(QModelIndex(), 1, int(oldTip - height));
+        m_tipHeight = height;
+        endRemoveRows();
+        emit dataChanged(index(0), index(0));
+    }
+    if (height != oldTip) {
+        // View stand am Tip: mitwandern, bis sie ihren neuen Bereich meldet
+        if (oldTip > 0 && m_viewHigh == oldTip) {
+            m_viewLow = qMax<qint64>(0, m_viewLow + height - oldTip);
+            m_viewHigh = height;
+        }
+        m_viewHigh = qMin(m_viewHigh, height);
+        m_viewLow = qMin(m_viewLow, height);
+        emit countChanged();
+        emit tipChanged();
+    }
+
+    // Reorg am Tip
+    const Block *atTip = blockAtHeight(height);
+    if (atTip && !hash.isEmpty() && atTip->hash != hash) {
+        removeBlock(height);
+    }
+    const Block *belowTip = blockAtHeight(height - 1);
+    if (belowTip && !previous.isEmpty() && belowTip->hash != previous) {
+        removeBlock(height - 1);
+        removeBlock(height);
+    }
+    return true;
+}
+
+// ---------- Viewport ----------
+
+void ChainTimelineModel::setViewport(int firstRow, int lastRow)
+{
+    if (m_tipHeight <= 0) {
+        return;
+    }
+
+    const int last = qBound(0, qMax(firstRow, lastRow), rowCount() - 1);
+    const int first = qBound(rowOffset(), qMin(firstRow, lastRow), rowCount() - 1);
+    const qint64 high = heightOfRow(first);
+    const qint64 low = last < rowOffset() ? high : heightOfRow(last);
+
+    if (high == m_viewHigh && low == m_viewLow) {
+        return;
+    }
+    if (m_viewHigh >= 0 && high != m_viewHigh) {
+        m_direction = high < m_viewHigh ? 1 : -1;
+    }
+    m_viewHigh = high;
+    m_viewLow = low;
+    schedule();
+}
+
+/**
+ * @brief ChainTimelineModel::wantedPages
+ * Seiten, die gerade gebraucht werden, nach Priorität: sichtbare, dann
+ * kPrefetchAhead Seiten in Scrollrichtung, dann kPrefetchBehind dahinter.
+ */
+QVector<int> ChainTimelineModel::wantedPages() const
+{
+    QVector<int> pages;
+    if (m_tipHeight <= 0 || m_viewHigh < 0) {
+        return pages;
+    }
+
+    const int top = pageOf(m_tipHeight);
+    const int high = pageOf(m_viewHigh);
+    const int low = pageOf(m_viewLow);
+    // in Scrollrichtung zuerst
+    if (m_direction > 0) {
+        for (int p = high; p >= low; --p) {
+            pages.append(p);
+        }
+    } else {
+        for (int p = low; p <= high; ++p) {
+            pages.append(p);
+        }
+    }
+
+    const int aheadEdge = m_direction > 0 ? low : high;
+    const int behindEdge = m_direction > 0 ? high : low;
+    for (int k = 1; k <= kPrefetchAhead; ++k) {
+        const int p = aheadEdge - k * m_direction;
+        if (p >= 0 && p <= top) {
+            pages.append(p);
+        }
+    }
+    for (int k = 1; k <= kPrefetchBehind; ++k) {
+        const int p = behindEdge + k * m_direction;
+        if (p >= 0 && p <= top) {
+            pages.append(p);
+        }
+    }
+    return pages;
+}
+
+// [erste, letzte] fehlende Höhe einer Seite, (-1, -1) wenn vollständig
+QPair<qint64, qint64> ChainTimelineModel::missingRange(int page) const
+{
+    const qint64 first = qint64(page) * kPageSize;
+    const qint64 last = qMin(first + kPageSize - 1, m_tipHeight);
+    qint64 lo = -1;
+    qint64 hi = -1;
+    for (qint64 h = first; h <= last; ++h) {
+        if (blockAtHeight(h)) {
+            continue;
+        }
+        if (lo < 0) {
+            lo = h;
+        }
+        hi = h;
+    }
+    return qMakePair(lo, hi);
+}
+
+/**
+ * @brief ChainTimelineModel::schedule
+ * Bricht Abrufe für Seiten ab, die nicht mehr gebraucht werden, und fordert
+ * die fehlenden Höhen der gewünschten Seiten an (höchstens kMaxInFlight
+ * gleichzeitig). Danach werden überzählige Seiten fern der View verdrängt.
+ */
+void ChainTimelineModel::schedule()
+{
+    const QVector<int> wanted = wantedPages();
+
+    QVector<int> stale;
+    for (auto it = m_inFlight.constBegin(); it != m_inFlight.constEnd(); ++it) {
+        if (!wanted.contains(it.key())) {
+            stale.append(it.key());
+        }
+    }
+    cancelRequests(stale);
+
+    QVector<Request> requests;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    for (int page : wanted) {
+        if (m_inFlight.size() >= kMaxInFlight) {
+            break;
+        }
+        if (m_inFlight.contains(page) || m_failedPages.contains(page)) {
+            continue;
+        }
+        const QPair<qint64, qint64> missing = missingRange(page);
+        if (missing.first < 0) {
+            continue;
+        }
+
+        // Header darunter mitnehmen (Differenz der MMR-Größen)
+        Request r;
+        r.start = qMax<qint64>(0, missing.first - 1);
+        r.end = missing.second;
+        r.startedMs = now;
+        m_inFlight.insert(page, r);
+        requests.append(r);
+    }
+
+    evict(wanted);
+    updateFetching();
+    for (const Request &r : requests) {
+        emit pageRequested(int(r.start), int(r.end));
+    }
+}
+
+void ChainTimelineModel::cancelRequests(const QVector<int> &pages)
+{
+    QVector<Request> cancelled;
+    for (int page : pages) {
+        const auto it = m_inFlight.find(page);
+        if (it != m_inFlight.end()) {
+            cancelled.append(it.value());
+            m_inFlight.erase(it);
+        }
+    }
+    updateFetching();
+    for (const Request &r : cancelled) {
+        emit pageCancelled(int(r.start), int(r.end));
+    }
+}
+
+// Antwort auf einen eigenen Abruf? Dann aus m_inFlight austragen.
+bool ChainTimelineModel::finishRange(int start, int end)
+{
+    for (auto it = m_inFlight.begin(); it != m_inFlight.end(); ++it) {
+        if (it->start == start && it->end == end) {
+            m_inFlight.erase(it);
+            updateFetching();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ChainTimelineModel::updateFetching()
+{
+    if (m_fetchingReported == fetching()) {
+        return;
+    }
+    m_fetchingReported = fetching();
+    emit fetchingChanged();
+}
+
+/**
+ * @brief ChainTimelineModel::evict
+ * Hält höchstens kMaxPages Seiten; verdrängt werden die am weitesten von
+ * der View entfernten, nie gewünschte oder gerade geladene.
+ */
+void ChainTimelineModel::evict(const QVector<int> &wanted)
+{
+    if (m_pages.size() <= kMaxPages) {
+        return;
+    }
+
+    const int center = m_viewHigh >= 0 ? pageOf((m_viewHigh + m_viewLow) / 2) : pageOf(m_tipHeight);
+    QVector<int> candidates;
+    for (auto it = m_pages.constBegin(); it != m_pages.constEnd(); ++it) {
+        if (!wanted.contains(it.key()) && !m_inFlight.contains(it.key())) {
+            candidates.append(it.key());
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [center](int a, int b) {
+        return qAbs(a - center) > qAbs(b - center);
+    });
+
+    for (int k = 0; k < candidates.size() && m_pages.size() > kMaxPages; ++k) {
+        const Page page = m_pages.take(candidates.at(k));
+        qint64 high = -1;
+        qint64 low = -1;
+        for (const Block &b : page.blocks) {
+            if (b.height < 0) {
+                continue;
+            }
+            m_heightByHash.remove(b.hash);
+            high = qMax(high, b.height);
+            low = low < 0 ? b.height : qMin(low, b.height);
+        }
+        if (high >= 0) {
+            emit dataChanged(index(rowOfHeight(high)), index(rowOfHeight(low)));
+        }
+    }
+}
+
+// ---------- Header ----------
+
+/**
+ * @brief ChainTimelineModel::applyHeaders
+ * Übernimmt die Header der Antwort auf pageRequested(start, end).
+ */
+void ChainTimelineModel::applyHeaders(int start, int end, const QVariantList &headers)
+{
+    const bool ours = finishRange(start, end);
+    if (m_tipHeight <= 0) {
+        return;
+    }
+
+    bool mismatch = false;
+    const int added = mergeHeaders(headers, &mismatch);
+
+    // Antwort ohne neue Höhen: Seite bis zum nächsten Tip nicht erneut anfordern
+    if (ours && added == 0 && !mismatch) {
+        m_failedPages.insert(pageOf(end));
+    }
+    if (added > 0) {
+        emit rangeLoaded(start, end);
+    }
+    schedule();
+}
+
+/**
+ * @brief ChainTimelineModel::mergeHeaders
+ * Outputs/Kernel pro Block ergeben sich aus der Differenz der
+ * MMR-Blattzahlen zum Header darunter; Inputs bleiben unbekannt, bis der
+ * Körper geladen ist. Danach wird die Verkettung über previous geprüft.
+ * Rückgabe: Anzahl neu übernommener Höhen.
+ */
+int ChainTimelineModel::mergeHeaders(const QVariantList &headers, bool *mismatch)
+{
+    ++m_generation;
+    QVector<qint64> heights;
+    heights.reserve(headers.size());
+    int added = 0;
+    for (const QVariant &v : headers) {
+        Block b = parseBlock(v);
+        if (b.hash.isEmpty() || b.height < 0 || b.height > m_tipHeight) {
+            continue;
+        }
+        b.generation = m_generation;
+        heights.append(b.height);
+
+        Block *cur = blockAtHeight(b.height);
+        if (cur && cur->hash == b.hash) {
+            cur->generation = m_generation;
+            continue;
+        }
+        setBlock(b);
+        ++added;
+    }
+
+    for (qint64 h : heights) {
+        fillCounts(h);
+        fillCounts(h + 1);
+    }
+
+    *mismatch = false;
+    for (qint64 h : heights) {
+        *mismatch = checkLinks(h) || *mismatch;
+    }
+    m_reorgSpan = *mismatch ? qMin(m_reorgSpan * 2, kMaxReorgSpan) : 1;
+    return added;
+}
+
+void ChainTimelineModel::pageFailed(int start, int end)
+{
+    if (!finishRange(start, end)) {
+        return;
+    }
+    m_failedPages.insert(pageOf(end));
+    schedule();
+}
+
+// Outputs/Kernel eines Headers aus den MMR-Größen, sobald der darunter da ist
+void ChainTimelineModel::fillCounts(qint64 height)
+{
+    Block *b = blockAtHeight(height);
+    if (!b || b->hasBody || b->outputs >= 0 || b->outputMmrSize < 0) {
+        return;
+    }
+    if (height == 0) {
+        b->outputs = int(leafCount(b->outputMmrSize));
+        b->kernels = int(leafCount(b->kernelMmrSize));
+    } else {
+        const Block *below = blockAtHeight(height - 1);
+        if (!below || below->outputMmrSize < 0 || below->hash != b->previous) {
+            return;
+        }
+        b->outputs = int(leafCount(b->outputMmrSize) - leafCount(below->outputMmrSize));
+        b->kernels = int(leafCount(b->kernelMmrSize) - leafCount(below->kernelMmrSize));
+    }
+    notifyHeight(height);
+}
+
+/**
+ * @brief ChainTimelineModel::checkLinks
+ * Prüft previous gegen die Nachbarn von height. Bei einem Bruch gilt die
+ * Seite als veraltet, die aus dem älteren Abruf stammt; unterhalb eines
+ * Bruchs werden m_reorgSpan Blöcke verworfen (verdoppelt sich bei tieferen
+ * Reorgs), darüber nur der eine Block.
+ */
+bool ChainTimelineModel::checkLinks(qint64 height)
+{
+    const Block *cur = blockAtHeight(height);
+    if (!cur) {
+        return false;
+    }
+    const QString hash = cur->hash;
+    const QString previous = cur->previous;
+    const quint32 generation = cur->generation;
+
+    const Block *below = blockAtHeight(height - 1);
+    if (below && !previous.isEmpty() && previous != below->hash) {
+        if (below->generation < generation) {
+            for (qint64 h = height - 1; h >= qMax<qint64>(0, height - m_reorgSpan); --h) {
+                removeBlock(h);
+            }
+        } else {
+            removeBlock(height);
+        }
+        return true;
+    }
+
+    const Block *above = blockAtHeight(height + 1);
+    if (above && !above->previous.isEmpty() && above->previous != hash) {
+        removeBlock(above->generation < generation ? height + 1 : height);
+        return true;
+    }
+    return false;
+}
+
+// ---------- Seiten ----------
+
+int ChainTimelineModel::pageOf(qint64 height)
+{
+    return int(height / kPageSize);
+}
+
+qint64 ChainTimelineModel::heightOfRow(int row) const
+{
+    return m_tipHeight - (row - rowOffset());
+}
+
+int ChainTimelineModel::rowOfHeight(qint64 height) const
+{
+    if (m_tipHeight <= 0 || height < 0 || height > m_tipHeight) {
+        return -1;
+    }
+    return rowOffset() + int(m_tipHeight - height);
+}
+
+const ChainTimelineModel::Block *ChainTimelineModel::blockAtHeight(qint64 height) const
+{
+    if (height < 0) {
+        return nullptr;
+    }
+    const auto it = m_pages.constFind(pageOf(height));
+    if (it == m_pages.constEnd()) {
+        return nullptr;
+    }
+    const Block &b = it->blocks.at(int(height % kPageSize));
+    return b.height == height ? &b : nullptr;
+}
+
+ChainTimelineModel::Block *ChainTimelineModel::blockAtHeight(qint64 height)
+{
+    if (height < 0) {
+        return nullptr;
+    }
+    const auto it = m_pages.find(pageOf(height));
+    if (it == m_pages.end()) {
+        return nullptr;
+    }
+    Block &b = it->blocks[int(height % kPageSize)];
+    return b.height == height ? &b : nullptr;
+}
+
+void ChainTimelineModel::setBlock(const Block &b)
+{
+    Page &page = m_pages[pageOf(b.height)];
+    if (page.blocks.isEmpty()) {
+        page.blocks.resize(kPageSize);
+    }
+    Block &slot = page.blocks[int(b.height % kPageSize)];
+    if (slot.height >= 0) {
+        m_heightByHash.remove(slot.hash);
+    } else {
+        ++page.loaded;
+    }
+    slot = b;
+    m_heightByHash.insert(b.hash, b.height);
+    notifyHeight(b.height);
+}
+
+void ChainTimelineModel::removeBlock(qint64 height)
+{
+    const auto it = m_pages.find(pageOf(height));
+    if (height < 0 || it == m_pages.end()) {
+        return;
+    }
+    Block &slot = it->blocks[int(height % kPageSize)];
+    if (slot.height != height) {
+        return;
+    }
+    m_heightByHash.remove(slot.hash);
+    slot = Block();
+    if (--it->loaded == 0) {
+        m_pages.erase(it);
+    }
+    notifyHeight(height);
+}
+
+// vor dem Entfernen der Zeilen, wenn der Tip sinkt
+void ChainTimelineModel::removeAbove(qint64 height)
+{
+    for (qint64 h = m_tipHeight; h > height; --h) {
+        removeBlock(h);
+    }
+}
+
+void ChainTimelineModel::notifyHeight(qint64 height)
+{
+    const int row = rowOfHeight(height);
+    if (row >= 0) {
+        emit dataChanged(index(row), index(row));
+    }
+}
+
+void ChainTimelineModel::clear()
+{
+    QVector<int> pages;
+    for (auto it = m_inFlight.constBegin(); it != m_inFlight.constEnd(); ++it) {
+        pages.append(it.key());
+    }
+    cancelRequests(pages);
+
+    const bool hadRows = rowCount() > 0;
+    beginResetModel();
+    m_pages.clear();
+    m_heightByHash.clear();
+    m_failedPages.clear();
+    m_tipHeight = 0;
+    m_viewHigh = -1;
+    m_viewLow = -1;
+    m_direction = 1;
+    m_reorgSpan = 1;
+    m_bodies.clear();
+    m_bodyOrder.clear();
+    m_bodyFetching = false;
+    m_bodyWanted = -1;
+    endResetModel();
+
+    if (hadRows) {
+        emit countChanged();
+    }
+    emit tipChanged();
+}
+
+// ---------- Blockkörper ----------
+
+void ChainTimelineModel::storeBody(const QString &hash, const QVariant &body)
+{
+    if (!m_bodies.contains(hash)) {
+        m_bodies.insert(hash, body);
+    }
+    m_bodyOrder.removeOne(hash);
+    m_bodyOrder.prepend(hash);
+    while (m_bodyOrder.size() > kBodyCacheSize) {
+        m_bodies.remove(m_bodyOrder.takeLast());
+    }
+}
+
+/**
+ * @brief ChainTimelineModel::requestBody
+ * Fordert die fehlenden Körper von row und den direkten Nachbarn als einen
+ * zusammenhängenden Bereich an. Läuft schon ein Abruf, wird row danach
+ * bedient.
+ */
+void ChainTimelineModel::requestBody(int row)
+{
+    if (row < rowOffset() || row >= rowCount()) {
+        return;
+    }
+    const qint64 height = heightOfRow(row);
+    if (m_bodyFetching) {
+        m_bodyWanted = height;
+        return;
+    }
+
+    qint64 lo = -1;
+    qint64 hi = -1;
+    for (qint64 h = qMax<qint64>(0, height - 1); h <= qMin(m_tipHeight, height + 1); ++h) {
+        const Block *b = blockAtHeight(h);
+        if (!b || b->hasBody || m_bodies.contains(b->hash)) {
+            continue;
+        }
+        lo = lo < 0 ? h : qMin(lo, h);
+        hi = qMax(hi, h);
+    }
+    if (lo < 0) {
+        return;
+    }
+
+    m_bodyFetching = true;
+    emit bodyRequested(int(lo), int(hi));
+}
+
+void ChainTimelineModel::applyBodies(const QVariantList &blocks)
+{
+    m_bodyFetching = false;
+
+    for (const QVariant &v : blocks) {
+        const Block body = parseBlock(v);
+        Block *b = blockAtHeight(body.height);
+        if (!body.hasBody || !b || b->hash != body.hash) {
+            continue;
+        }
+        storeBody(body.hash, body.raw);
+
+        b->inputs = body.inputs;
+        b->outputs = body.outputs;
+        b->kernels = body.kernels;
+        notifyHeight(body.height);
+        emit bodyAvailable(body.hash);
+    }
+
+    if (m_bodyWanted >= 0) {
+        const int row = rowOfHeight(m_bodyWanted);
+        m_bodyWanted = -1;
+        requestBody(row);
+    }
+}
+
+void ChainTimelineModel::bodyFetchFailed()
+{
+    m_bodyFetching = false;
+    m_bodyWanted = -1;
+}
+
+bool ChainTimelineModel::hasBody(int row) const
+{
+    if (row < rowOffset() || row >= rowCount()) {
+        return false;
+    }
+    const Block *b = blockAtHeight(heightOfRow(row));
+    return b && (b->hasBody || m_bodies.contains(b->hash));
+}
+
+// ---------- Lookup ----------
+
+QVariant ChainTimelineModel::blockAt(int row)
+{
+    if (row < rowOffset() || row >= rowCount()) {
+        return QVariant();
+    }
+    const Block *b = blockAtHeight(heightOfRow(row));
+    if (!b) {
+        return QVariant();
+    }
+
+    const auto body = m_bodies.constFind(b->hash);
+    if (body == m_bodies.constEnd()) {
+        return b->raw;
+    }
+    const QVariant out = body.value();
+    storeBody(b->hash, out);
+    return out;
+}
+
+bool ChainTimelineModel::isLoaded(int row) const
+{
+    return row >= rowOffset() && row < rowCount() && blockAtHeight(heightOfRow(row)) != nullptr;
+}
+
+int ChainTimelineModel::heightAt(int row) const
+{
+    if (row < 0 || row >= rowCount()) {
+        return -1;
+    }
+    return row < rowOffset() ? int(m_tipHeight + 1) : int(heightOfRow(row));
+}
+
+int ChainTimelineModel::indexOfHeight(int height) const
+{
+    return rowOfHeight(height);
+}
+
+int ChainTimelineModel::indexOfHash(const QString &hash) const
+{
+    const auto it = m_heightByHash.constFind(hash.toLower());
+    return it == m_heightByHash.constEnd() ? -1 : rowOfHeight(it.value());
+}
+
+int ChainTimelineModel::find(const QString &query) const
+{
+    const QString text = query.trimmed().toLower();
+    if (text.isEmpty()) {
+        return -1;
+    }
+
+    bool isHeight = false;
+    const int height = text.toInt(&isHeight);
+    if (isHeight && height >= 0) {
+        const int row = indexOfHeight(height);
+        if (row >= 0) {
+            return row;
+        }
+    }
+
+    const int exact = indexOfHash(text);
+    if (exact >= 0) {
+        return exact;
+    }
+    // Präfix: der höchste passende geladene Block
+    qint64 best = -1;
+    for (auto it = m_heightByHash.constBegin(); it != m_heightByHash.constEnd(); ++it) {
+        if (it.value() > best && it.key().startsWith(text)) {
+            best = it.value();
+        }
+    }
+    return best < 0 ? -1 : rowOfHeight(best);
+}
+
+// ---------- Parsing ----------
+
+ChainTimelineModel::Block ChainTimelineModel::parseBlock(const QVariant &value)
+{
+    Block b;
+    const QVariantMap block = toMap(value);
+    QVariantMap header = toMap(field(block, "header"));
+    if (header.isEmpty()) {
+        header = toMap(field(block, "block_header", "blockHeader"));
+    }
+    // reiner Header (get_header)
+    const bool headerOnly = header.isEmpty() && block.contains(QStringLiteral("hash"));
+    if (headerOnly) {
+        header = block;
+    }
+    if (header.isEmpty()) {
+        return b;
+    }
+
+    b.height = field(header, "height").toLongLong();
+    b.hash = field(header, "hash").toString().toLower();
+    b.previous = field(header, "previous").toString().toLower();
+    b.timestamp = toSeconds(field(header, "timestamp"));
+    b.difficulty = field(header, "total_difficulty", "totalDifficulty").toDouble();
+
+    bool ok = false;
+    const qint64 outputMmr = field(header, "output_mmr_size", "outputMmrSize").toLongLong(&ok);
+    b.outputMmrSize = ok ? outputMmr : -1;
+    const qint64 kernelMmr = field(header, "kernel_mmr_size", "kernelMmrSize").toLongLong(&ok);
+    b.kernelMmrSize = ok ? kernelMmr : -1;
+
+    if (headerOnly) {
+        b.inputs = b.outputs = b.kernels = -1;
+        QVariantMap wrapped;
+        wrapped.insert(QStringLiteral("header"), value);
+        b.raw = wrapped;
+        return b;
+    }
+
+    b.inputs = listSize(field(block, "inputs"));
+    b.outputs = listSize(field(block, "outputs"));
+    b.kernels = listSize(field(block, "kernels"));
+    b.hasBody = true;
+    b.raw = value;
+    return b;
+}
@@ -0,0 +1,170 @@
+#ifndef CHAINTIMELINEMODEL_H
+#define CHAINTIMELINEMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+// Zeitleiste der ganzen Chain (Höhe 0 bis Tip) für die Chain-Ansicht.
+// Zeile 0 ist der Platzhalter für den nächsten Block, danach eine Zeile pro
+// Höhe absteigend; rowCount() hängt nur am Tip, nicht an geladenen Daten.
+// Header werden seitenweise (kPageSize Höhen) geladen, sobald der per
+// setViewport() gemeldete sichtbare Bereich in die Nähe kommt, mit Vorlauf in
+// Scrollrichtung. Seiten, die aus dem Bereich fallen, werden abgebrochen
+// (pageCancelled) bzw. später verdrängt. Nicht geladene Zeilen liefern nur
+// ihre Höhe (loaded = false).
+// Reorgs: passt previous nicht zum Block darunter bzw. zum prevBlockToLast
+// des Tips, wird der ältere Stand verworfen und neu geladen.
+// Blockkörper holt requestBody() für den gewählten Block und seine Nachbarn,
+// gehalten in einem begrenzten LRU.
+class ChainTimelineModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int tipHeight READ tipHeight NOTIFY tipChanged)
+    Q_PROPERTY(int pageSize READ pageSize CONSTANT)
+    Q_PROPERTY(bool fetching READ fetching NOTIFY fetchingChanged)
+
+public:
+    enum Roles {
+        IsDummyRole = Qt::UserRole + 1,
+        LoadedRole,
+        HeightRole,
+        HashRole,
+        PreviousRole,
+        TimestampRole,
+        InputsRole,
+        OutputsRole,
+        KernelsRole,
+        DifficultyRole
+    };
+
+    explicit ChainTimelineModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return rowCount(); }
+    int tipHeight() const { return int(m_tipHeight); }
+    int pageSize() const;
+    bool fetching() const { return !m_inFlight.isEmpty(); }
+
+    // Tip aus getTipAsync (height, lastBlockPushed, prevBlockToLast)
+    Q_INVOKABLE void setTip(const QVariantMap &tip);
+    // Tip plus Header der neuesten Höhen (ChainRpc::tipRefreshed)
+    Q_INVOKABLE void applyTip(const QVariantMap &tip, const QVariantList &headers);
+    // Sichtbare Zeilen [firstRow, lastRow] der View
+    Q_INVOKABLE void setViewport(int firstRow, int lastRow);
+    // Antwort auf pageRequested(start, end)
+    Q_INVOKABLE void applyHeaders(int start, int end, const QVariantList &headers);
+    Q_INVOKABLE void pageFailed(int start, int end);
+    Q_INVOKABLE void clear();
+
+    // Körper für Zeile row und direkte Nachbarn anfordern
+    Q_INVOKABLE void requestBody(int row);
+    // Antwort auf bodyRequested
+    Q_INVOKABLE void applyBodies(const QVariantList &blocks);
+    Q_INVOKABLE void bodyFetchFailed();
+    Q_INVOKABLE bool hasBody(int row) const;
+
+    // Voller Block, falls geladen, sonst { header }; ungültig für leere Zeilen
+    Q_INVOKABLE QVariant blockAt(int row);
+    Q_INVOKABLE bool isLoaded(int row) const;
+    Q_INVOKABLE int heightAt(int row) const;
+    // Zeile einer Höhe 0..tip, unabhängig davon, ob sie geladen ist
+    Q_INVOKABLE int indexOfHeight(int height) const;
+    Q_INVOKABLE int indexOfHash(const QString &hash) const;
+    // Höhe (immer) oder (Präfix eines) geladenen Hash, sonst -1
+    Q_INVOKABLE int find(const QString &query) const;
+
+signals:
+    void countChanged();
+    void tipChanged();
+    void fetchingChanged();
+
+    // Header [start, end] laden und an applyHeaders() übergeben
+    void pageRequested(int start, int end);
+    // laufenden Abruf [start, end] abbrechen, Antwort wird nicht mehr erwartet
+    void pageCancelled(int start, int end);
+    // Blockkörper [start, end] laden und an applyBodies() übergeben
+    void bodyRequested(int start, int end);
+    void bodyAvailable(const QString &hash);
+    // Höhen [start, end] sind neu geladen (z. B. für eine ausstehende Suche)
+    void rangeLoaded(int start, int end);
+
+private:
+    struct Block {
+        qint64 height = -1;
+        QString hash;
+        QString previous;
+        qint64 timestamp = 0;   // Sekunden
+        int inputs = 0;         // -1 = unbekannt (nur Header)
+        int outputs = 0;
+        int kernels = 0;
+        double difficulty = 0.0;
+        qint64 outputMmrSize = -1;
+        qint64 kernelMmrSize = -1;
+        bool hasBody = false;
+        quint32 generation = 0; // Abruf, aus dem der Block stammt
+        QVariant raw;           // voller Block bzw. { header }
+    };
+
+    struct Request {
+        qint64 start = -1;
+        qint64 end = -1;
+        qint64 startedMs = 0;
+    };
+
+    struct Page {
+        QVector<Block> blocks;  // kPageSize Einträge, height -1 = fehlt
+        int loaded = 0;
+    };
+
+    static Block parseBlock(const QVariant &value);
+    int rowOffset() const { return m_tipHeight > 0 ? 1 : 0; }
+    qint64 heightOfRow(int row) const;
+    int rowOfHeight(qint64 height) const;
+    static int pageOf(qint64 height);
+    const Block *blockAtHeight(qint64 height) const;
+    Block *blockAtHeight(qint64 height);
+    void setBlock(const Block &b);
+    void removeBlock(qint64 height);
+    void removeAbove(qint64 height);
+    void notifyHeight(qint64 height);
+    bool updateTip(const QVariantMap &tip);
+    int mergeHeaders(const QVariantList &headers, bool *mismatch);
+    void fillCounts(qint64 height);
+    bool checkLinks(qint64 height);
+    void storeBody(const QString &hash, const QVariant &body);
+    QPair<qint64, qint64> missingRange(int page) const;
+    QVector<int> wantedPages() const;
+    void schedule();
+    void evict(const QVector<int> &wanted);
+    void cancelRequests(const QVector<int> &pages);
+    bool finishRange(int start, int end);
+    void updateFetching();
+
+    QHash<int, Page> m_pages;
+    QHash<QString, qint64> m_heightByHash;
+    QHash<int, Request> m_inFlight;     // Seite -> laufender Abruf
+    QSet<int> m_failedPages;            // bis zum nächsten Tip nicht erneut anfordern
+    bool m_fetchingReported = false;
+    qint64 m_tipHeight = 0;
+    qint64 m_viewHigh = -1;             // sichtbare Höhen, -1 = noch keine View
+    qint64 m_viewLow = -1;
+    int m_direction = 1;                // +1 Richtung Genesis, -1 Richtung Tip
+    quint32 m_generation = 0;
+    int m_reorgSpan = 1;
+
+    QHash<QString, QVariant> m_bodies;  // hash -> voller Block
+    QStringList m_bodyOrder;            // LRU, zuletzt benutzt vorn
+    bool m_bodyFetching = false;
+    qint64 m_bodyWanted = -1;           // Höhe, die nach dem laufenden Abruf dran ist
+};
+
+#endif // CHAINTIMELINEMODEL_H
@@ -0,0 +1,271 @@
+#include "jsonrpcbatcher.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+namespace {
+
+const int kWindowMs = 8;            // Aufrufe aus demselben Seitenwechsel landen im selben Batch
+const int kMaxBatchSize = 256;
+const int kRequestTimeoutMs = 30000;
+const qint64 kBatchRetryMs = 10 * 60 * 1000;
+
+} // namespace
+
+JsonRpcBatcher::JsonRpcBatcher(const QUrl &url, QObject *parent) :
+    QObject(parent),
+    m_url(url)
+{
+    m_window.setSingleShot(true);
+    m_window.setInterval(kWindowMs);
+    connect(&m_window, &QTimer::timeout, this, [this]() {
+        // offene Gruppe: endGroup() sendet alles zusammen
+        if (m_groupDepth == 0) {
+            flush();
+        }
+    });
+}
+
+int JsonRpcBatcher::call(const QString &method, const QJsonArray &params, Callback done)
+{
+    Call c;
+    c.id = m_nextId++;
+    c.request.insert("jsonrpc", "2.0");
+    c.request.insert("id", c.id);
+    c.request.insert("method", method);
+    c.request.insert("params", params);
+    c.done = done;
+    m_queue.append(c);
+
+    if (m_groupDepth == 0 && !m_window.isActive()) {
+        m_window.start();
+    }
+    return c.id;
+}
+
+void JsonRpcBatcher::beginGroup()
+{
+    ++m_groupDepth;
+}
+
+void JsonRpcBatcher::endGroup()
+{
+    if (m_groupDepth == 0) {
+        return;
+    }
+    if (--m_groupDepth == 0) {
+        flush();
+    }
+}
+
+void JsonRpcBatcher::cancel(int id)
+{
+    for (int i = 0; i < m_queue.size(); ++i) {
+        if (m_queue.at(i).id == id) {
+            m_queue.remove(i);
+            return;
+        }
+    }
+
+    const auto it = m_replyById.find(id);
+    if (it == m_replyById.end()) {
+        return;
+    }
+    QNetworkReply *reply = it.value();
+    m_replyById.erase(it);
+
+    for (int other : m_idsByReply.value(reply)) {
+        if (m_replyById.value(other) == reply) {
+            return;     // Request wird noch für andere Aufrufe gebraucht
+        }
+    }
+    reply->abort();
+}
+
+// Anderer Server: Batches wieder versuchen
+void JsonRpcBatcher::setUrl(const QUrl &url)
+{
+    if (url != m_url) {
+        m_batchSupported = true;
+    }
+    m_url = url;
+}
+
+bool JsonRpcBatcher::batchSupported() const
+{
+    return m_batchSupported || QDateTime::currentMSecsSinceEpoch() >= m_batchRetryAt;
+}
+
+void JsonRpcBatcher::setAuthHeader(const QString &header)
+{
+    m_authHeader = header;
+}
+
+QJsonValue JsonRpcBatcher::okResult(const QJsonObject &response, QString *error)
+{
+    if (response.contains("error")) {
+        *error = response.value("error").toObject().value("message").toString();
+        return QJsonValue();
+    }
+    const QJsonObject result = response.value("result").toObject();
+    if (result.contains("Err")) {
+        const QJsonValue err = result.value("Err");
+        *error = err.isString() ? err.toString()
+                                : QString::fromUtf8(QJsonDocument(err.toObject()).toJson(QJsonDocument::Compact));
+        return QJsonValue();
+    }
+    return result.value("Ok");
+}
+
+// ---------- Senden ----------
+
+void JsonRpcBatcher::flush()
+{
+    m_window.stop();
+    const QVector<Call> queue = m_queue;
+    m_queue.clear();
+    if (queue.isEmpty()) {
+        return;
+    }
+
+    if (!m_batchSupported && batchSupported()) {
+        m_batchSupported = true;    // Sperre abgelaufen, nächster Batch ist der Test
+    }
+    if (queue.size() == 1 || !m_batchSupported) {
+        for (const Call &c : queue) {
+            post(QVector<Call>{ c }, false);
+        }
+        return;
+    }
+    for (int i = 0; i < queue.size(); i += kMaxBatchSize) {
+        const QVector<Call> chunk = queue.mid(i, kMaxBatchSize);
+        post(chunk, chunk.size() > 1);
+    }
+}
+
+void JsonRpcBatcher::post(const QVector<Call> &calls, bool asBatch)
+{
+    QJsonDocument doc;
+    if (asBatch) {
+        QJsonArray batch;
+        for (const Call &c : calls) {
+            batch.append(c.request);
+        }
+        doc = QJsonDocument(batch);
+    } else {
+        doc = QJsonDocument(calls.first().request);
+    }
+
+    QNetworkRequest request(m_url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    if (!m_authHeader.isEmpty()) {
+        request.setRawHeader("Authorization", m_authHeader.toUtf8());
+    }
+    QNetworkReply *reply = m_network.post(request, doc.toJson(QJsonDocument::Compact));
+
+    QVector<int> ids;
+    ids.reserve(calls.size());
+    for (const Call &c : calls) {
+        ids.append(c.id);
+        m_replyById.insert(c.id, reply);
+    }
+    m_idsByReply.insert(reply, ids);
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, calls, asBatch]() {
+        finished(reply, calls, asBatch);
+    });
+    QTimer::singleShot(kRequestTimeoutMs, reply, [this, reply]() {
+        timeout(reply);
+    });
+}
+
+// Request hängt: abbrechen, finished() meldet den Aufrufen einen Fehler
+void JsonRpcBatcher::timeout(QNetworkReply *reply)
+{
+    if (reply->isFinished()) {
+        return;
+    }
+    m_timedOut.insert(reply);
+    reply->abort();
+}
+
+/**
+ * @brief JsonRpcBatcher::finished
+ * Verteilt die Antworten eines Requests per id auf die noch offenen Aufrufe.
+ * Ein Batch, auf den der Server nicht mit einem Array antwortet, gilt als
+ * abgelehnt und wird einzeln wiederholt.
+ */
+void JsonRpcBatcher::finished(QNetworkReply *reply, const QVector<Call> &calls, bool asBatch)
+{
+    reply->deleteLater();
+    m_idsByReply.remove(reply);
+    const bool timedOut = m_timedOut.remove(reply);
+
+    QVector<Call> open;
+    for (const Call &c : calls) {
+        const auto it = m_replyById.find(c.id);
+        if (it != m_replyById.end() && it.value() == reply) {
+            m_replyById.erase(it);
+            open.append(c);
+        }
+    }
+    if (open.isEmpty()) {
+        return;
+    }
+    if (timedOut) {
+        const QString error = QStringLiteral("request timed out after %1 s").arg(kRequestTimeoutMs / 1000);
+        for (const Call &c : open) {
+            c.done(QJsonObject(), error);
+        }
+        return;
+    }
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        return;
+    }
+
+    // Body auch bei HTTP-Fehlern lesen: JSON-RPC-Fehler stehen darin
+    const QByteArray body = reply->readAll();
+    QJsonParseError parseError;
+    const QJsonDocument json = QJsonDocument::fromJson(body, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        const QString error = reply->error() != QNetworkReply::NoError
+                ? reply->errorString() : parseError.errorString();
+        for (const Call &c : open) {
+            c.done(QJsonObject(), error);
+        }
+        return;
+    }
+
+    if (!asBatch) {
+        open.first().done(json.object(), QString());
+        return;
+    }
+
+    // Server ohne Batch-Unterstützung antwortet mit einem einzelnen Fehlerobjekt
+    if (!json.isArray()) {
+        qWarning() << "JsonRpcBatcher: batch rejected by" << m_url.toString() << "- single calls for a while";
+        m_batchSupported = false;
+        m_batchRetryAt = QDateTime::currentMSecsSinceEpoch() + kBatchRetryMs;
+        for (const Call &c : open) {
+            post(QVector<Call>{ c }, false);
+        }
+        return;
+    }
+
+    QHash<int, QJsonObject> byId;
+    for (const QJsonValue &v : json.array()) {
+        const QJsonObject response = v.toObject();
+        byId.insert(response.value("id").toInt(), response);
+    }
+    for (const Call &c : open) {
+        const auto it = byId.constFind(c.id);
+        if (it != byId.constEnd()) {
+            c.done(it.value(), QString());
+        } else {
+            c.done(QJsonObject(), QStringLiteral("no response for %1").arg(c.request.value("method").toString()));
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef JSONRPCBATCHER_H
+#define JSONRPCBATCHER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+
+#include <functional>
+
+class QNetworkReply;
+
+// JSON-RPC-2.0-Transport gegen einen Endpunkt (z. B. v2/foreign), der
+// Aufrufe bündelt: alles, was innerhalb von kWindowMs oder zwischen
+// beginGroup()/endGroup() per call() kommt, geht als ein Batch-Array in
+// einem HTTP-Request raus. Die Antworten werden über die id den Aufrufen
+// zugeordnet. Ein Batcher pro Endpunkt, geteilt von allen Clients dort.
+// Lehnt der Server Batches ab (Antwort ist kein Array), werden die Aufrufe
+// einzeln wiederholt und für kBatchRetryMs bzw. bis zum nächsten setUrl()
+// nur noch einzeln gesendet; danach wird ein Batch erneut versucht.
+// Ein Request ohne Antwort nach kRequestTimeoutMs wird abgebrochen, seine
+// Aufrufe bekommen einen Fehler.
+// cancel() verwirft einen Aufruf; sind alle Aufrufe eines Requests
+// verworfen, wird der Request abgebrochen.
+// URL und Authorization-Header lassen sich zur Laufzeit ändern (Wechsel
+// des Controllers); sie gelten ab dem nächsten Request.
+class JsonRpcBatcher : public QObject
+{
+    Q_OBJECT
+public:
+    // response: vollständiges Antwortobjekt (result bzw. error) des Aufrufs;
+    // error: Transportfehler, dann ist response leer
+    using Callback = std::function<void(const QJsonObject &response, const QString &error)>;
+
+    explicit JsonRpcBatcher(const QUrl &url, QObject *parent = nullptr);
+
+    // Aufruf einreihen; Rückgabe ist die JSON-RPC-id (für cancel())
+    int call(const QString &method, const QJsonArray &params, Callback done);
+    // Verschachtelbar; endGroup() der äußersten Gruppe sendet sofort
+    void beginGroup();
+    void endGroup();
+    // Callback wird nicht mehr aufgerufen
+    void cancel(int id);
+
+    QUrl url() const
+    {
+        return m_url;
+    }
+    void setUrl(const QUrl &url);
+    // vollständiger Header-Wert, z. B. "Basic ..."; leer = ohne Header
+    QString authHeader() const
+    {
+        return m_authHeader;
+    }
+    void setAuthHeader(const QString &header);
+
+    bool batchSupported() const;
+
+    // Grin-Konvention: result.Ok bzw. Fehlertext aus error / result.Err
+    static QJsonValue okResult(const QJsonObject &response, QString *error);
+
+private:
+    struct Call {
+        int id = 0;
+        QJsonObject request;
+        Callback done;
+    };
+
+    void flush();
+    void timeout(QNetworkReply *reply);
+    void post(const QVector<Call> &calls, bool asBatch);
+    void finished(QNetworkReply *reply, const QVector<Call> &calls, bool asBatch);
+
+    QNetworkAccessManager m_network;
+    QUrl m_url;
+    QString m_authHeader;
+    QTimer m_window;
+    QVector<Call> m_queue;
+    QHash<int, QNetworkReply *> m_replyById;        // gesendete, noch offene Aufrufe
+    QHash<QNetworkReply *, QVector<int>> m_idsByReply;
+    QSet<QNetworkReply *> m_timedOut;
+    int m_groupDepth = 0;
+    int m_nextId = 1;
+    bool m_batchSupported = true;
+    qint64 m_batchRetryAt = 0;          // ms seit Epoch, nach Ablehnung
+};
+
+#endif // JSONRPCBATCHER_H
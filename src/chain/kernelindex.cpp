@@ -0,0 +1,282 @@
+#include "kernelindex.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const int kMergeThreshold = 4096;
+const qint64 kCompactSlackRecords = 16384;
+const int kFlushDelayMs = 2000;
+
+} // namespace
+
+KernelIndex::KernelIndex(QObject *parent) :
+    QObject(parent),
+    m_store("KernelIndex")
+{
+    static_assert(sizeof(Record) == 16, "KernelIndex::Record must stay 16 bytes");
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushDelayMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &KernelIndex::flush);
+}
+
+KernelIndex::~KernelIndex()
+{
+    flush();
+}
+
+/**
+ * @brief KernelIndex::open
+ * Lädt den Speicher der Chain. Vor dem Öffnen Gelerntes bleibt im
+ * Speicher, wird aber nicht geschrieben (Höhe evtl. nicht final).
+ */
+void KernelIndex::open(const QString &chainId)
+{
+    if (chainId.isEmpty() || chainId == m_chainId) {
+        return;
+    }
+
+    flush();
+    merge();
+    const QVector<Record> learned = m_chainId.isEmpty() ? m_base : QVector<Record>();
+    m_base.clear();
+    m_delta.clear();
+    m_unfinal.clear();
+    m_pending.clear();
+    m_coveredLow = -1;
+    m_coveredHigh = -1;
+    m_coverageDirty = false;
+
+    m_chainId = chainId;
+    m_store.open("kernels-" + m_chainId + ".bin", "chain/kernels-" + m_chainId, [this](const uchar *data, qint64 size) {
+        parse(data, size);
+    });
+
+    for (const Record &r : learned) {
+        put(r.key, r.height);
+        m_unfinal.insert(r.key);
+    }
+}
+
+// ---------- Lernen ----------
+
+// 8 Byte nach dem Paritätsbyte (0x08/0x09), big-endian
+quint64 KernelIndex::keyOf(const QString &excessHex, bool *ok)
+{
+    const QByteArray raw = QByteArray::fromHex(excessHex.trimmed().toLatin1());
+    *ok = raw.size() == 33;
+    quint64 key = 0;
+    for (int i = 1; *ok && i <= 8; ++i) {
+        key = (key << 8) | quint8(raw.at(i));
+    }
+    return key;
+}
+
+void KernelIndex::insertBlock(const QVariant &block, bool final)
+{
+    const QVariantMap map = block.toMap();
+    const qint64 height = map.value(QStringLiteral("header")).toMap().value(QStringLiteral("height"), -1).toLongLong();
+    if (height < 0) {
+        return;
+    }
+    for (const QVariant &kernel : map.value(QStringLiteral("kernels")).toList()) {
+        insert(kernel.toMap().value(QStringLiteral("excess")).toString(), height, final);
+    }
+    if (final) {
+        addCoverage(height, height);
+    }
+}
+
+// Ein Kernel wird gespeichert, sobald seine Höhe final ist; bis dahin
+// (und vor open()) steht er nur in m_unfinal
+void KernelIndex::insert(const QString &excessHex, qint64 height, bool final)
+{
+    bool ok = false;
+    const quint64 key = keyOf(excessHex, &ok);
+    if (!ok || height < 0) {
+        return;
+    }
+    const bool changed = put(key, height);
+    if (!final || m_chainId.isEmpty()) {
+        if (changed) {
+            m_unfinal.insert(key);
+        }
+        return;
+    }
+    if (!m_unfinal.remove(key) && !changed) {
+        return;
+    }
+    m_pending.append(Record{ key, quint32(height), KernelKind });
+    scheduleFlush();
+}
+
+/**
+ * @brief KernelIndex::addCoverage
+ * Erweitert den lückenlosen Bereich, wenn [low, high] ihn berührt oder
+ * überlappt; getrennte Bereiche werden nicht gemerkt.
+ */
+void KernelIndex::addCoverage(qint64 low, qint64 high)
+{
+    if (low < 0 || high < low) {
+        return;
+    }
+    if (m_coveredLow < 0) {
+        m_coveredLow = low;
+        m_coveredHigh = high;
+    } else if (low <= m_coveredHigh + 1 && high >= m_coveredLow - 1) {
+        if (low >= m_coveredLow && high <= m_coveredHigh) {
+            return;
+        }
+        m_coveredLow = qMin(m_coveredLow, low);
+        m_coveredHigh = qMax(m_coveredHigh, high);
+    } else {
+        return;
+    }
+    m_coverageDirty = true;
+    scheduleFlush();
+}
+
+bool KernelIndex::put(quint64 key, qint64 height)
+{
+    const auto it = m_delta.constFind(key);
+    if (it != m_delta.constEnd()) {
+        if (qint64(it.value()) == height) {
+            return false;
+        }
+    } else {
+        const auto b = std::lower_bound(m_base.constBegin(), m_base.constEnd(), key, [](const Record &r, quint64 k) {
+            return r.key < k;
+        });
+        if (b != m_base.constEnd() && b->key == key && qint64(b->height) == height) {
+            return false;
+        }
+    }
+
+    m_delta.insert(key, quint32(height));
+    if (m_delta.size() > kMergeThreshold) {
+        merge();
+    }
+    return true;
+}
+
+// Delta in den sortierten Vektor einarbeiten; bei gleichem Schlüssel gilt das Delta
+void KernelIndex::merge()
+{
+    if (m_delta.isEmpty()) {
+        return;
+    }
+
+    QVector<Record> added;
+    added.reserve(m_delta.size());
+    for (auto it = m_delta.constBegin(); it != m_delta.constEnd(); ++it) {
+        added.append(Record{ it.key(), it.value(), KernelKind });
+    }
+    std::sort(added.begin(), added.end(), [](const Record &a, const Record &b) {
+        return a.key < b.key;
+    });
+
+    QVector<Record> merged;
+    merged.reserve(m_base.size() + added.size());
+    auto b = m_base.constBegin();
+    auto a = added.constBegin();
+    while (b != m_base.constEnd() || a != added.constEnd()) {
+        if (a == added.constEnd() || (b != m_base.constEnd() && b->key < a->key)) {
+            merged.append(*b++);
+        } else {
+            if (b != m_base.constEnd() && b->key == a->key) {
+                ++b;
+            }
+            merged.append(*a++);
+        }
+    }
+    m_base.swap(merged);
+    m_delta.clear();
+}
+
+// ---------- Abfragen ----------
+
+qint64 KernelIndex::heightOf(const QString &excessHex) const
+{
+    bool ok = false;
+    const quint64 key = keyOf(excessHex, &ok);
+    if (!ok) {
+        return -1;
+    }
+    const auto it = m_delta.constFind(key);
+    if (it != m_delta.constEnd()) {
+        return it.value();
+    }
+    const auto b = std::lower_bound(m_base.constBegin(), m_base.constEnd(), key, [](const Record &r, quint64 k) {
+        return r.key < k;
+    });
+    return (b != m_base.constEnd() && b->key == key) ? qint64(b->height) : -1;
+}
+
+// ---------- Persistenz ----------
+
+void KernelIndex::scheduleFlush()
+{
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void KernelIndex::parse(const uchar *data, qint64 size)
+{
+    for (qint64 pos = 0; pos + qint64(sizeof(Record)) <= size; pos += qint64(sizeof(Record))) {
+        Record r;
+        std::memcpy(&r, data + pos, sizeof(Record));
+        if (r.kind == CoverageKind) {
+            m_coveredLow = qint64(r.key);
+            m_coveredHigh = r.height;
+        } else if (r.kind == KernelKind) {
+            m_delta.insert(r.key, r.height);
+            if (m_delta.size() > kMergeThreshold) {
+                merge();
+            }
+        }
+    }
+    merge();
+}
+
+// Kernel finaler Höhen plus Bereich. Nicht finale Einträge (etwa von einem
+// inzwischen abgelösten Zweig) bleiben draußen.
+QByteArray KernelIndex::serialize()
+{
+    merge();
+    QByteArray out;
+    out.reserve(int((m_base.size() - m_unfinal.size() + 1) * sizeof(Record)));
+    for (const Record &r : m_base) {
+        if (!m_unfinal.contains(r.key)) {
+            out.append(reinterpret_cast<const char *>(&r), int(sizeof(r)));
+        }
+    }
+    if (m_coveredLow >= 0) {
+        const Record c{ quint64(m_coveredLow), quint32(m_coveredHigh), CoverageKind };
+        out.append(reinterpret_cast<const char *>(&c), int(sizeof(c)));
+    }
+    return out;
+}
+
+void KernelIndex::flush()
+{
+    m_flushTimer.stop();
+    if (m_chainId.isEmpty() || (m_pending.isEmpty() && !m_coverageDirty)) {
+        return;
+    }
+    if (m_coverageDirty) {
+        m_pending.append(Record{ quint64(m_coveredLow), quint32(m_coveredHigh), CoverageKind });
+        m_coverageDirty = false;
+    }
+
+    const QByteArray appended(reinterpret_cast<const char *>(m_pending.constData()), int(m_pending.size() * sizeof(Record)));
+    const qint64 storedRecords = m_store.size() / qint64(sizeof(Record));
+    const bool compact = storedRecords + m_pending.size() > 2 * qint64(size()) + kCompactSlackRecords;
+    const bool written = compact ? m_store.rewrite(serialize()) : m_store.append(appended);
+    if (!written) {
+        return;
+    }
+    m_pending.clear();
+}
@@ -0,0 +1,93 @@
+#ifndef KERNELINDEX_H
+#define KERNELINDEX_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+
+#include "storage/appendlogstore.h"
+
+// Kernel-Excess -> Blockhöhe, gelernt aus jedem Block, den ChainRpc lädt
+// (auch aus dem Hintergrund-Backfill), und aus jedem Treffer von get_kernel.
+// Schlüssel sind die 8 Byte nach dem Paritätsbyte des Excess; ein Treffer
+// ist nur ein Hinweis, den get_kernel über genau diese Höhe und den vollen
+// Excess bestätigt.
+// Daneben der lückenlos indizierte Bereich [coveredLow, coveredHigh]
+// (nur finale Höhen): fehlt ein Excess im Index, muss der Node diesen
+// Bereich nicht mehr durchsuchen.
+// Im Speicher wie UtxoMirror: sortierter Vektor plus kleines Delta.
+// Gespeichert als 16-Byte-Records (Kernel bzw. Bereich) im AppendLogStore,
+// angehängt und kompaktiert wie ChainCache; pro Chain ein Speicher. Auf
+// Platte landen nur Kernel finaler Höhen, nicht finale bleiben im Speicher.
+class KernelIndex : public QObject
+{
+    Q_OBJECT
+public:
+    explicit KernelIndex(QObject *parent = nullptr);
+    ~KernelIndex() override;
+
+    // Speicher der Chain (ChainCache::chainId()) laden
+    void open(const QString &chainId);
+
+    // Kernel eines Blocks (QVariantMap wie von get_blocks); final: darf
+    // gespeichert werden und zählt zum indizierten Bereich
+    void insertBlock(const QVariant &block, bool final);
+    void insert(const QString &excessHex, qint64 height, bool final);
+    // Alle Blöcke [low, high] sind indiziert (Backfill)
+    void addCoverage(qint64 low, qint64 high);
+
+    // -1 = unbekannt
+    qint64 heightOf(const QString &excessHex) const;
+
+    qint64 coveredLow() const
+    {
+        return m_coveredLow;
+    }
+    qint64 coveredHigh() const
+    {
+        return m_coveredHigh;
+    }
+    int size() const
+    {
+        return m_base.size() + m_delta.size();
+    }
+
+    void flush();
+
+private:
+    enum Kind : quint32 {
+        KernelKind = 0,
+        CoverageKind = 1        // key = low, height = high
+    };
+
+    struct Record {
+        quint64 key;
+        quint32 height;
+        quint32 kind;
+    };
+
+    static quint64 keyOf(const QString &excessHex, bool *ok);
+    bool put(quint64 key, qint64 height);
+    void merge();
+    void scheduleFlush();
+    void parse(const uchar *data, qint64 size);
+    QByteArray serialize();
+
+    QVector<Record> m_base;             // nach key sortiert
+    QHash<quint64, quint32> m_delta;    // seit dem letzten Merge
+    QSet<quint64> m_unfinal;            // Höhe noch nicht final, wird nicht gespeichert
+    qint64 m_coveredLow = -1;
+    qint64 m_coveredHigh = -1;
+    bool m_coverageDirty = false;
+
+    QVector<Record> m_pending;
+    QTimer m_flushTimer;
+    AppendLogStore m_store;
+    QString m_chainId;
+};
+
+#endif // KERNELINDEX_H
@@ -0,0 +1,130 @@
+#include "ownerrpc.h"
+
+#include "jsonrpcbatcher.h"
+
+#include <QJsonArray>
+#include <QStringList>
+#include <QUrl>
+
+OwnerRpc::OwnerRpc(JsonRpcBatcher *rpc, QObject *parent) :
+    QObject(parent),
+    m_rpc(rpc)
+{
+}
+
+QString OwnerRpc::url() const
+{
+    return m_rpc->url().toString();
+}
+
+void OwnerRpc::setUrl(const QString &url)
+{
+    if (url == this->url()) {
+        return;
+    }
+    m_rpc->setUrl(QUrl(url));
+    emit endpointChanged();
+}
+
+QString OwnerRpc::authHeader() const
+{
+    return m_rpc->authHeader();
+}
+
+void OwnerRpc::setAuthHeader(const QString &header)
+{
+    if (header == authHeader()) {
+        return;
+    }
+    m_rpc->setAuthHeader(header);
+    emit endpointChanged();
+}
+
+// ---------- Aufrufe ----------
+
+// Ein Aufruf je Methode; *pending hält dessen id bis zur Antwort
+void OwnerRpc::request(const QString &method, const QJsonArray &params, int *pending, Done done)
+{
+    if (*pending != 0) {
+        return;
+    }
+    *pending = m_rpc->call(method, params, [this, method, pending, done](const QJsonObject &response, const QString &error) {
+        *pending = 0;
+        QString err = error;
+        const QJsonValue result = err.isEmpty() ? JsonRpcBatcher::okResult(response, &err) : QJsonValue();
+        if (!err.isEmpty()) {
+            emit requestFailed(method, err);
+            return;
+        }
+        done(result.toVariant());
+    });
+}
+
+void OwnerRpc::getStatusAsync()
+{
+    request("get_status", QJsonArray(), &m_statusCall, [this](const QVariant &result) {
+        emit statusUpdated(result.toMap());
+    });
+}
+
+void OwnerRpc::getConnectedPeersAsync()
+{
+    request("get_connected_peers", QJsonArray(), &m_connectedCall, [this](const QVariant &result) {
+        QVariantList peers;
+        for (const QVariant &peer : result.toList()) {
+            peers.append(displayPeer(peer.toMap()));
+        }
+        emit connectedPeersUpdated(peers);
+    });
+}
+
+void OwnerRpc::getPeersAsync(const QString &addr)
+{
+    const QJsonValue filter = addr.isEmpty() ? QJsonValue(QJsonValue::Null) : QJsonValue(addr);
+    request("get_peers", QJsonArray{ filter }, &m_peersCall, [this](const QVariant &result) {
+        emit getPeersFinishedQml(result.toList());
+    });
+}
+
+// ---------- Umformen ----------
+
+/**
+ * @brief OwnerRpc::displayPeer
+ * PeerInfo aus get_connected_peers in der Form, die PeerListView und die
+ * Karte von NodeOwnerApi kennen: Felder mit asString, camelCase-Namen.
+ */
+QVariantMap OwnerRpc::displayPeer(const QVariantMap &peer)
+{
+    const auto asString = [](const QString &text) {
+        QVariantMap field;
+        field.insert("asString", text);
+        return field;
+    };
+
+    QVariantMap out;
+    out.insert("addr", asString(peer.value("addr").toString()));
+    out.insert("direction", asString(peer.value("direction").toString()));
+    out.insert("version", asString(peer.value("version").toString()));
+    out.insert("capabilities", asString(capabilitiesString(peer.value("capabilities").toMap().value("bits").toInt())));
+    out.insert("userAgent", peer.value("user_agent"));
+    out.insert("height", peer.value("height"));
+    out.insert("totalDifficulty", peer.value("total_difficulty"));
+    return out;
+}
+
+QString OwnerRpc::capabilitiesString(int bits)
+{
+    static const char *const names[] = { "HEADER_HIST", "TXHASHSET_HIST", "PEER_LIST", "TX_KERNEL_HASH" };
+
+    QStringList parts;
+    for (int i = 0; i < 4; ++i) {
+        if (bits & (1 << i)) {
+            parts.append(QLatin1String(names[i]));
+        }
+    }
+    const int unknown = bits & ~0xF;
+    if (unknown != 0) {
+        parts.append(QStringLiteral("0x%1").arg(unknown, 0, 16));
+    }
+    return parts.isEmpty() ? QStringLiteral("UNKNOWN") : parts.join(QStringLiteral(" | "));
+}
@@ -0,0 +1,64 @@
+#ifndef OWNERRPC_H
+#define OWNERRPC_H
+
+#include <QObject>
+#include <QJsonArray>
+#include <QString>
+#include <QVariant>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include <functional>
+
+class JsonRpcBatcher;
+
+// JSON-RPC-Client gegen v2/owner für die Abfragen, die Home, StatusView,
+// PeerListView, Karte und Peers im Poll-Takt stellen. Läuft über den
+// Batcher des Endpunkts: Status und verbundene Peers aus demselben Takt
+// gehen als ein Request raus. Pro Methode ist höchstens ein Aufruf
+// unterwegs, weitere werden verworfen.
+// Signale wie bei NodeOwnerApi, damit die Seiten nur das Ziel wechseln:
+// Status und get_peers kommen als JSON des Nodes, verbundene Peers in der
+// Form von PeerInfoDisplay (addr/direction/version/capabilities mit
+// asString, userAgent, height). Bannen/Entbannen bleibt bei NodeOwnerApi.
+class OwnerRpc : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString url READ url WRITE setUrl NOTIFY endpointChanged)
+    Q_PROPERTY(QString authHeader READ authHeader WRITE setAuthHeader NOTIFY endpointChanged)
+public:
+    // rpc: Batcher für v2/owner
+    explicit OwnerRpc(JsonRpcBatcher *rpc, QObject *parent = nullptr);
+
+    QString url() const;
+    void setUrl(const QString &url);
+    QString authHeader() const;
+    void setAuthHeader(const QString &header);
+
+    Q_INVOKABLE void getStatusAsync();
+    Q_INVOKABLE void getConnectedPeersAsync();
+    // addr leer: alle bekannten Peers
+    Q_INVOKABLE void getPeersAsync(const QString &addr);
+
+signals:
+    void statusUpdated(const QVariantMap &status);
+    void connectedPeersUpdated(const QVariantList &peers);
+    void getPeersFinishedQml(const QVariantList &peers);
+    // method wie im JSON-RPC-Aufruf, z. B. "get_peers"
+    void requestFailed(const QString &method, const QString &message);
+    void endpointChanged();
+
+private:
+    using Done = std::function<void(const QVariant &result)>;
+
+    void request(const QString &method, const QJsonArray &params, int *pending, Done done);
+    static QVariantMap displayPeer(const QVariantMap &peer);
+    static QString capabilitiesString(int bits);
+
+    JsonRpcBatcher *m_rpc;
+    int m_statusCall = 0;       // JSON-RPC-id, 0 = keiner unterwegs
+    int m_connectedCall = 0;
+    int m_peersCall = 0;
+};
+
+#endif // OWNERRPC_H
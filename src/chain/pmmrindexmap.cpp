@@ -0,0 +1,197 @@
+#include "pmmrindexmap.h"
+
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+const qint64 kCompactSlackRecords = 4096;
+const int kFlushDelayMs = 2000;
+
+} // namespace
+
+PmmrIndexMap::PmmrIndexMap(QObject *parent) :
+    QObject(parent),
+    m_store("PmmrIndexMap")
+{
+    static_assert(sizeof(Record) == 16, "PmmrIndexMap::Record must stay 16 bytes");
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushDelayMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &PmmrIndexMap::flush);
+}
+
+PmmrIndexMap::~PmmrIndexMap()
+{
+    flush();
+}
+
+/**
+ * @brief PmmrIndexMap::open
+ * Lädt den Speicher der Chain. Was vor dem Öffnen schon gelernt wurde,
+ * kommt danach wieder dazu (ist neuer als die Datei).
+ */
+void PmmrIndexMap::open(const QString &chainId)
+{
+    if (chainId.isEmpty() || chainId == m_chainId) {
+        return;
+    }
+
+    flush();
+    const QMap<qint64, Entry> learned = m_chainId.isEmpty() ? m_sizes : QMap<qint64, Entry>();
+    m_sizes.clear();
+    m_finalCount = 0;
+    m_pending.clear();
+
+    m_chainId = chainId;
+    m_store.open("pmmr-" + m_chainId + ".bin", "chain/pmmr-" + m_chainId, [this](const uchar *data, qint64 size) {
+        parse(data, size);
+    });
+
+    for (auto it = learned.constBegin(); it != learned.constEnd(); ++it) {
+        insert(it.key(), it->mmrSize, it->final);
+    }
+}
+
+// ---------- Lernen ----------
+
+void PmmrIndexMap::insert(qint64 height, qint64 mmrSize, bool final)
+{
+    if (!put(height, mmrSize, final) || !final || m_chainId.isEmpty()) {
+        return;
+    }
+    m_pending.append(Record{ height, mmrSize });
+    scheduleFlush();
+}
+
+void PmmrIndexMap::insertHeader(const QVariant &item, bool final)
+{
+    const QVariantMap map = item.toMap();
+    const QVariant nested = map.value(QStringLiteral("header"));
+    const QVariantMap header = nested.isValid() ? nested.toMap() : map;
+    const QVariant size = header.value(QStringLiteral("output_mmr_size"));
+    if (size.isValid()) {
+        insert(header.value(QStringLiteral("height"), -1).toLongLong(), size.toLongLong(), final);
+    }
+}
+
+/**
+ * @brief PmmrIndexMap::put
+ * Trägt den Wert ein und entfernt Nachbarn, die der strengen Monotonie
+ * widersprechen. Rückgabe: es gab etwas Neues zu speichern.
+ */
+bool PmmrIndexMap::put(qint64 height, qint64 mmrSize, bool final)
+{
+    if (height < 0 || mmrSize <= 0) {
+        return false;
+    }
+
+    auto it = m_sizes.find(height);
+    if (it != m_sizes.end() && it->mmrSize == mmrSize) {
+        if (it->final || !final) {
+            return false;
+        }
+        it->final = true;
+        ++m_finalCount;
+        return true;
+    }
+
+    // Jeder Block hat mindestens einen Output: zwischen zwei Höhen wächst
+    // der Wert mindestens um ihren Abstand
+    it = m_sizes.lowerBound(height);
+    while (it != m_sizes.begin()) {
+        auto prev = std::prev(it);
+        if (prev->mmrSize <= mmrSize - (height - prev.key())) {
+            break;
+        }
+        m_finalCount -= prev->final ? 1 : 0;
+        m_sizes.erase(prev);
+    }
+    it = m_sizes.upperBound(height);
+    while (it != m_sizes.end() && it->mmrSize < mmrSize + (it.key() - height)) {
+        m_finalCount -= it->final ? 1 : 0;
+        it = m_sizes.erase(it);
+    }
+
+    it = m_sizes.find(height);
+    if (it != m_sizes.end()) {
+        m_finalCount -= it->final ? 1 : 0;
+    }
+    m_sizes.insert(height, Entry{ mmrSize, final });
+    m_finalCount += final ? 1 : 0;
+    return true;
+}
+
+// ---------- Abfragen ----------
+
+qint64 PmmrIndexMap::sizeAt(qint64 height) const
+{
+    if (height < 0) {
+        return 0;
+    }
+    const auto it = m_sizes.constFind(height);
+    return it == m_sizes.constEnd() ? -1 : it->mmrSize;
+}
+
+qint64 PmmrIndexMap::knownAtOrBelow(qint64 height) const
+{
+    auto it = m_sizes.upperBound(height);
+    if (it == m_sizes.constBegin()) {
+        return -1;
+    }
+    return std::prev(it).key();
+}
+
+qint64 PmmrIndexMap::knownAtOrAbove(qint64 height) const
+{
+    const auto it = m_sizes.lowerBound(height);
+    return it == m_sizes.constEnd() ? -1 : it.key();
+}
+
+// ---------- Persistenz ----------
+
+void PmmrIndexMap::scheduleFlush()
+{
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void PmmrIndexMap::parse(const uchar *data, qint64 size)
+{
+    for (qint64 pos = 0; pos + qint64(sizeof(Record)) <= size; pos += qint64(sizeof(Record))) {
+        Record r;
+        std::memcpy(&r, data + pos, sizeof(Record));
+        put(r.height, r.mmrSize, true);
+    }
+}
+
+QByteArray PmmrIndexMap::serialize() const
+{
+    QByteArray out;
+    out.reserve(int(m_finalCount * sizeof(Record)));
+    for (auto it = m_sizes.constBegin(); it != m_sizes.constEnd(); ++it) {
+        if (it->final) {
+            const Record r{ it.key(), it->mmrSize };
+            out.append(reinterpret_cast<const char *>(&r), int(sizeof(r)));
+        }
+    }
+    return out;
+}
+
+void PmmrIndexMap::flush()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty() || m_chainId.isEmpty()) {
+        return;
+    }
+
+    const QByteArray appended(reinterpret_cast<const char *>(m_pending.constData()), int(m_pending.size() * sizeof(Record)));
+    const qint64 storedRecords = m_store.size() / qint64(sizeof(Record));
+    const bool compact = storedRecords + m_pending.size() > 2 * qint64(m_finalCount) + kCompactSlackRecords;
+    const bool written = compact ? m_store.rewrite(serialize()) : m_store.append(appended);
+    if (!written) {
+        return;
+    }
+    m_pending.clear();
+}
@@ -0,0 +1,75 @@
+#ifndef PMMRINDEXMAP_H
+#define PMMRINDEXMAP_H
+
+#include <QObject>
+#include <QMap>
+#include <QString>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+
+#include "storage/appendlogstore.h"
+
+// Höhe -> output_mmr_size (letzter Output-MMR-Index des Blocks), gelernt aus
+// jedem Header, Block und get_pmmr_indices. Die Outputs der Höhen [s, e]
+// liegen damit bei [size(s - 1) + 1, size(e)]; kennt die Map beide Werte,
+// braucht die UTXO-Ansicht kein get_pmmr_indices mehr.
+// Der Wert wächst streng mit der Höhe (jeder Block hat einen Coinbase-
+// Output). Widerspricht ein neuer Wert seinen Nachbarn (Reorg nahe Tip),
+// fallen die widersprechenden Einträge weg.
+// Persistiert werden nur Höhen unter dem Reorg-Horizont (final); Format und
+// Ablage wie ChainCache im AppendLogStore: 16-Byte-Records, angehängt und
+// kompaktiert, pro Chain ein Speicher.
+class PmmrIndexMap : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PmmrIndexMap(QObject *parent = nullptr);
+    ~PmmrIndexMap() override;
+
+    // Speicher der Chain (ChainCache::chainId()) laden; bisher Gelerntes bleibt
+    void open(const QString &chainId);
+
+    // final: darf gespeichert werden
+    void insert(qint64 height, qint64 mmrSize, bool final);
+    // Header bzw. Block (QVariantMap wie von v2/foreign)
+    void insertHeader(const QVariant &header, bool final);
+
+    // -1 = unbekannt; size(-1) ist 0
+    qint64 sizeAt(qint64 height) const;
+    // Nächste bekannte Höhe <= height bzw. >= height, -1 = keine
+    qint64 knownAtOrBelow(qint64 height) const;
+    qint64 knownAtOrAbove(qint64 height) const;
+
+    int size() const
+    {
+        return m_sizes.size();
+    }
+
+    void flush();
+
+private:
+    struct Record {
+        qint64 height;
+        qint64 mmrSize;
+    };
+
+    struct Entry {
+        qint64 mmrSize = 0;
+        bool final = false;     // darf gespeichert werden
+    };
+
+    bool put(qint64 height, qint64 mmrSize, bool final);
+    void scheduleFlush();
+    void parse(const uchar *data, qint64 size);
+    QByteArray serialize() const;
+
+    QMap<qint64, Entry> m_sizes;        // Höhe -> output_mmr_size
+    int m_finalCount = 0;
+    QVector<Record> m_pending;
+    QTimer m_flushTimer;
+    AppendLogStore m_store;
+    QString m_chainId;
+};
+
+#endif // PMMRINDEXMAP_H
@@ -1,5 +1,7 @@
 #include "config.h"
 
+#include <QSaveFile>
+
 /**
  * @brief Config::load
  * @return
@@ -43,7 +45,8 @@ bool Config::save()
         return false;
     }
 
-    QFile f(m_path);
+    // Temp-Datei + rename: bei Abbruch bleibt die alte Datei vollständig
+    QSaveFile f(m_path);
     if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) {
         setError("Save failed: " + f.errorString());
         return false;
@@ -51,9 +54,12 @@ bool Config::save()
 
     QTextStream out(&f);
     // out.setCodec("UTF-8");
-    out << m_text;
+    m_doc.write(out);
     out.flush();
-    f.close();
+    if (!f.commit()) {
+        setError("Save failed: " + f.errorString());
+        return false;
+    }
     return true;
 }
 
@@ -80,155 +86,6 @@ bool Config::loadFromNetwork(const QString &network, bool local)
     return load();
 }
 
-// --- kleine Helpers -------------------------------------------------
-
-QString Config::trimOutside(const QString &s)
-{
-    QString r = s.trimmed();
-    return r;
-}
-
-// Entfernt Kommentare (# ...) nur wenn sie NICHT in Anführungszeichen stehen
-QString Config::stripTomlComment(const QString &line)
-{
-    bool inStr = false;
-    bool escape = false;
-    QString out;
-    out.reserve(line.size());
-    for (int i = 0; i < line.size(); ++i) {
-        QChar c = line[i];
-        if (escape) {
-            out += c;
-            escape = false;
-            continue;
-        }
-        if (c == '\\') {
-            out += c;
-            escape = true;
-            continue;
-        }
-        if (c == '\"') {
-            inStr = !inStr;
-            out += c;
-            continue;
-        }
-        if (c == '#' && !inStr) {
-            break;
-        }
-        out += c;
-    }
-    return out;
-}
-
-// Findet erstes '=' außerhalb von Strings
-int Config::findEqualOutsideQuotes(const QString &line)
-{
-    bool inStr = false;
-    bool escape = false;
-    for (int i = 0; i < line.size(); ++i) {
-        QChar c = line[i];
-        if (escape) {
-            escape = false;
-            continue;
-        }
-        if (c == '\\') {
-            escape = true;
-            continue;
-        }
-        if (c == '\"') {
-            inStr = !inStr;
-            continue;
-        }
-        if (c == '=' && !inStr) {
-            return i;
-        }
-    }
-    return -1;
-}
-
-QString Config::unescapeTomlString(QString s)
-{
-    // TOML-Strings sind JSON-ähnlich. Wir dekodieren die häufigsten Sequenzen.
-    s.replace("\\\"", "\"");
-    s.replace("\\\\", "\\");
-    s.replace("\\n", "\n");
-    s.replace("\\r", "\r");
-    s.replace("\\t", "\t");
-    return s;
-}
-
-bool Config::isQuoted(const QString &v)
-{
-    return v.size() >= 2 && v.startsWith('\"') && v.endsWith('\"');
-}
-
-QString Config::dequote(QString v)
-{
-    if (isQuoted(v)) {
-        v = v.mid(1, v.size() - 2);
-    }
-    return v;
-}
-
-// Parsed eine sehr große TOML-Untermenge ausreichend für grin-server.toml
-// Erzeugt Map: "server.db_root" -> "C:\Users\..."
-QHash<QString, QString> Config::parseTomlFlatKeys(const QString &text)
-{
-    QHash<QString, QString> map;
-    QStringList curTable; // z.B. ["server","p2p_config"]
-
-    const QStringList lines = text.split('\n');
-    for (QString raw : lines) {
-        QString line = stripTomlComment(raw).trimmed();
-        if (line.isEmpty()) {
-            continue;
-        }
-
-        // Table: [server] oder [server.p2p_config]
-        if (line.startsWith('[') && line.endsWith(']')) {
-            bool isArrayTable = (line.size() >= 4 && line.startsWith("[[") && line.endsWith("]]"));
-            QString inside = isArrayTable ? line.mid(2, line.size() - 4)
-                             : line.mid(1, line.size() - 2);
-            inside = trimOutside(inside);
-            // für unsere Zwecke ignorieren wir Array-of-Tables; wir übernehmen nur den Pfad
-            curTable = inside.split('.', Qt::SkipEmptyParts);
-            continue;
-        }
-
-        // Key-Value: key = value  ( '=' außerhalb von Strings )
-        int eq = findEqualOutsideQuotes(line);
-        if (eq < 0) {
-            continue;
-        }
-
-        QString k = trimOutside(line.left(eq));
-        QString v = trimOutside(line.mid(eq + 1));
-
-        if (k.isEmpty()) {
-            continue;
-        }
-
-        // Vollqualifizierten Key erzeugen: [server] + db_root  -> "server.db_root"
-        QStringList parts = curTable;
-        foreach(const QString &p, k.split('.', Qt::SkipEmptyParts))
-        parts << p;
-        QString fullKey = parts.join('.');
-
-        // Wert normalisieren (Strings dequoten/ent-escapen)
-        QString valNorm;
-        if (isQuoted(v)) {
-            valNorm = unescapeTomlString(dequote(v));
-        } else {
-            // unquoted literal (true/false/number/bare) -> roh zurückgeben
-            valNorm = v;
-        }
-
-        map.insert(fullKey, valNorm);
-    }
-
-    return map;
-}
-
 // Wandelt String -> QVariant anhand des Typs des defaultValue
 QVariant Config::coerceToType(const QString &raw, const QVariant &defaultValue)
 {
@@ -276,24 +133,107 @@ QVariant Config::coerceToType(const QString &raw, const QVariant &defaultValue)
 
 QVariant Config::value(const QString &key, const QVariant &defaultValue) const
 {
-    if (m_text.isEmpty()) {
-        return defaultValue;
-    }
-
-    // Einmalig parsen (oder bei jedem Aufruf – hier simpel gehalten)
-    QHash<QString, QString> map = parseTomlFlatKeys(m_text);
-
     // Direktes Lookup
-    if (map.contains(key)) {
-        return coerceToType(map.value(key), defaultValue);
+    const TomlDocument::Value *v = m_doc.find(key);
+    if (v) {
+        return coerceToType(v->text, defaultValue);
     }
 
     // Fallback: Versuche auch unquoted/bare Keys (selten nötig)
     // (z. B. wenn jemand "server.db_root " mit Space eingibt)
-    QString trimmedKey = key.trimmed();
-    if (map.contains(trimmedKey)) {
-        return coerceToType(map.value(trimmedKey), defaultValue);
+    v = m_doc.find(key.trimmed());
+    if (v) {
+        return coerceToType(v->text, defaultValue);
     }
 
     return defaultValue;
 }
+
+// Mehrere Keys auf einmal; Typ je Key über defaults, sonst automatisch
+QVariantMap Config::values(const QStringList &keys, const QVariantMap &defaults) const
+{
+    QVariantMap out;
+    for (const QString &key : keys) {
+        const TomlDocument::Value *v = m_doc.find(key);
+        if (!v) {
+            if (defaults.contains(key)) {
+                out.insert(key, defaults.value(key));
+            }
+            continue;
+        }
+        out.insert(key, defaults.contains(key) ? coerceToType(v->text, defaults.value(key))
+                                               : autoType(*v));
+    }
+    return out;
+}
+
+// Alle Keys unterhalb eines Tabellenpfads, z.B. "server.p2p_config"
+QVariantMap Config::valuesWithPrefix(const QString &prefix) const
+{
+    QVariantMap out;
+    const QString dotted = prefix.endsWith('.') || prefix.isEmpty() ? prefix : prefix + '.';
+    for (const QString &key : m_doc.keys()) {
+        if (key.startsWith(dotted) || key == prefix) {
+            out.insert(key, autoType(*m_doc.find(key)));
+        }
+    }
+    return out;
+}
+
+// Unquoted Literale als bool/Zahl, Strings bleiben Strings
+QVariant Config::autoType(const TomlDocument::Value &v)
+{
+    if (v.quoted) {
+        return v.text;
+    }
+    if (v.text == "true") {
+        return true;
+    }
+    if (v.text == "false") {
+        return false;
+    }
+    bool ok = false;
+    const qlonglong n = v.text.toLongLong(&ok);
+    if (ok) {
+        return n;
+    }
+    const double d = v.text.toDouble(&ok);
+    if (ok) {
+        return d;
+    }
+    return v.text;
+}
+
+// Einzelner Wert; fehlende Keys werden in ihrer Tabelle angelegt
+bool Config::setValue(const QString &key, const QVariant &value)
+{
+    if (!m_doc.setValue(key, value)) {
+        setError("Cannot set value for " + key);
+        return false;
+    }
+    m_textDirty = true;
+    emit valueChanged(key);
+    return true;
+}
+
+// Mehrere Werte; valueChanged erst, wenn alle gesetzt sind
+bool Config::setValues(const QVariantMap &values)
+{
+    bool ok = true;
+    QStringList changed;
+    for (auto it = values.constBegin(); it != values.constEnd(); ++it) {
+        if (m_doc.setValue(it.key(), it.value())) {
+            changed.append(it.key());
+        } else {
+            setError("Cannot set value for " + it.key());
+            ok = false;
+        }
+    }
+    if (!changed.isEmpty()) {
+        m_textDirty = true;
+    }
+    for (const QString &key : changed) {
+        emit valueChanged(key);
+    }
+    return ok;
+}
@@ -8,6 +8,12 @@
 #include <QDir>
 #include <QFile>
 #include <QTextStream>
+#include <QHash>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+#include "tomldocument.h"
 
 class Config : public QObject
 {
@@ -36,14 +42,19 @@ public:
 
     QString text() const
     {
+        if (m_textDirty) {
+            m_text = m_doc.toString();
+            m_textDirty = false;
+        }
         return m_text;
     }
 
     void setText(const QString &t)
     {
-        if (m_text == t) {
+        if (text() == t) {
             return;
         }
+        m_doc.setText(t);
         m_text = t;
         emit textChanged();
     }
@@ -57,16 +68,30 @@ public:
     Q_INVOKABLE bool save();                   // speichert text -> Datei
     Q_INVOKABLE bool loadFromNetwork(const QString &network, bool local = false); // ~/.grin/<network>/grin-server.toml
     Q_INVOKABLE QVariant value(const QString &key, const QVariant &defaultValue) const;
+    // Bulk-Reads über den gecachten Index
+    Q_INVOKABLE QVariantMap values(const QStringList &keys, const QVariantMap &defaults = QVariantMap()) const;
+    Q_INVOKABLE QVariantMap valuesWithPrefix(const QString &prefix) const;
+    // Patcht nur den Wert im Text, Kommentare/Formatierung bleiben erhalten.
+    // Meldet valueChanged statt textChanged: Bindungen an text würden sonst
+    // bei jeder Änderung das ganze Dokument neu serialisieren.
+    Q_INVOKABLE bool setValue(const QString &key, const QVariant &value);
+    Q_INVOKABLE bool setValues(const QVariantMap &values);
 signals:
     void pathChanged();
+    // Text komplett ersetzt (setText/load)
     void textChanged();
+    void valueChanged(const QString &key);
     void errorStringChanged();
 
 private:
     QString m_path;
-    QString m_text;
+    mutable QString m_text;
     QString m_error;
 
+    // Dokumentbaum; m_text wird nach setValue erst beim Lesen neu erzeugt
+    TomlDocument m_doc;
+    mutable bool m_textDirty = false;
+
     void setError(const QString &e)
     {
         m_error = e;
@@ -74,13 +99,7 @@ private:
     }
 
     static QVariant coerceToType(const QString &raw, const QVariant &defaultValue);
-    static QHash<QString, QString> parseTomlFlatKeys(const QString &text);
-    static QString unescapeTomlString(QString s);
-    static int findEqualOutsideQuotes(const QString &line);
-    static QString stripTomlComment(const QString &line);
-    static QString trimOutside(const QString &s);
-    static bool isQuoted(const QString &v);
-    static QString dequote(QString v);
+    static QVariant autoType(const TomlDocument::Value &v);
 };
 
 #endif // CONFIG_H
@@ -0,0 +1,797 @@
+#include "tomldocument.h"
+
+#include <QLocale>
+#include <QRegularExpression>
+#include <QStringView>
+
+#include <cmath>
+
+TomlDocument::TomlDocument() :
+    m_parsed(false)
+{
+}
+
+// --- Text <-> Baum ---------------------------------------------------
+
+void TomlDocument::setText(const QString &text)
+{
+    if (!m_parsed) {
+        m_raw = text;   // Baum entsteht erst beim ersten Zugriff
+        return;
+    }
+
+    const QStringList statements = splitStatements(text);
+
+    QVector<NodeRef> flat;
+    for (int s = 0; s < m_sections.size(); ++s) {
+        for (int n = 0; n < m_sections.at(s).nodes.size(); ++n) {
+            flat.append(NodeRef{ s, n });
+        }
+    }
+    auto nodeAt = [this, &flat](int i) -> const Node & {
+        return m_sections.at(flat.at(i).section).nodes.at(flat.at(i).node);
+    };
+
+    const int oldCount = flat.size();
+    const int newCount = statements.size();
+
+    int pre = 0;
+    while (pre < oldCount && pre < newCount && nodeAt(pre).text == statements.at(pre)) {
+        ++pre;
+    }
+    int suf = 0;
+    while (suf < oldCount - pre && suf < newCount - pre
+           && nodeAt(oldCount - 1 - suf).text == statements.at(newCount - 1 - suf)) {
+        ++suf;
+    }
+    const int oldEnd = oldCount - suf;
+    const int newEnd = newCount - suf;
+
+    // Header geändert: Pfade (und [[array]]-Nummern) aller folgenden Keys ändern sich
+    bool headerTouched = false;
+    for (int i = pre; i < oldEnd && !headerTouched; ++i) {
+        headerTouched = nodeAt(i).kind == Node::Table || nodeAt(i).kind == Node::ArrayTable;
+    }
+    for (int i = pre; i < newEnd && !headerTouched; ++i) {
+        headerTouched = isHeader(statements.at(i));
+    }
+    if (headerTouched) {
+        rebuild(statements);
+        return;
+    }
+
+    // Ohne Header liegt der geänderte Bereich komplett in einer Sektion
+    NodeRef at{ 0, 0 };
+    if (pre < oldEnd) {
+        at = flat.at(pre);
+    } else if (pre > 0) {
+        at = NodeRef{ flat.at(pre - 1).section, flat.at(pre - 1).node + 1 };
+    }
+
+    Section &sec = m_sections[at.section];
+    const int oldLen = oldEnd - pre;
+    for (int i = 0; i < oldLen; ++i) {
+        const Node &n = sec.nodes.at(at.node + i);
+        auto it = m_index.find(n.key);
+        if (n.kind == Node::KeyValue && it != m_index.end()
+            && it->section == at.section && it->node == at.node + i) {
+            m_index.erase(it);
+        }
+    }
+    sec.nodes.remove(at.node, oldLen);
+
+    QVector<Node> fresh;
+    fresh.reserve(newEnd - pre);
+    for (int i = pre; i < newEnd; ++i) {
+        fresh.append(parseStatement(statements.at(i), sec.path));
+    }
+    sec.nodes.insert(at.node, fresh.size(), Node());
+    for (int i = 0; i < fresh.size(); ++i) {
+        sec.nodes[at.node + i] = fresh.at(i);
+    }
+
+    // nur der Rest dieser Sektion verschiebt sich
+    indexSection(at.section, at.node);
+}
+
+QString TomlDocument::toString() const
+{
+    if (!m_parsed) {
+        return m_raw;
+    }
+
+    int size = 0;
+    for (const Section &sec : m_sections) {
+        for (const Node &n : sec.nodes) {
+            size += n.text.size() + 1;
+        }
+    }
+
+    QString out;
+    out.reserve(size);
+    bool first = true;
+    for (const Section &sec : m_sections) {
+        for (const Node &n : sec.nodes) {
+            if (!first) {
+                out += '\n';
+            }
+            out += n.text;
+            first = false;
+        }
+    }
+    return out;
+}
+
+// Schreibt direkt aus dem Baum, ohne den Gesamttext aufzubauen
+void TomlDocument::write(QTextStream &out) const
+{
+    if (!m_parsed) {
+        out << m_raw;
+        return;
+    }
+
+    bool first = true;
+    for (const Section &sec : m_sections) {
+        for (const Node &n : sec.nodes) {
+            if (!first) {
+                out << '\n';
+            }
+            out << n.text;
+            first = false;
+        }
+    }
+}
+
+void TomlDocument::ensureParsed() const
+{
+    if (!m_parsed) {
+        rebuild(splitStatements(m_raw));
+    }
+}
+
+void TomlDocument::rebuild(const QStringList &statements) const
+{
+    m_sections.clear();
+    m_index.clear();
+    m_sectionIndex.clear();
+
+    QHash<QString, int> arrayCounts;
+    m_sections.append(Section());
+    m_sectionIndex.insert(QString(), 0);
+
+    for (const QString &st : statements) {
+        if (isHeader(st)) {
+            const Node header = parseStatement(st, QString());
+            Section sec;
+            sec.path = header.key;
+            if (header.kind == Node::ArrayTable) {
+                const int n = arrayCounts.value(header.key);
+                arrayCounts.insert(header.key, n + 1);
+                sec.path = QString("%1[%2]").arg(header.key).arg(n);
+            }
+            sec.nodes.append(header);
+            m_sectionIndex.insert(sec.path, m_sections.size());
+            m_sections.append(sec);
+            continue;
+        }
+        Section &sec = m_sections.last();
+        sec.nodes.append(parseStatement(st, sec.path));
+    }
+
+    for (int s = 0; s < m_sections.size(); ++s) {
+        indexSection(s, 0);
+    }
+    m_parsed = true;
+    m_raw.clear();
+}
+
+void TomlDocument::indexSection(int s, int from) const
+{
+    const QVector<Node> &nodes = m_sections.at(s).nodes;
+    for (int i = from; i < nodes.size(); ++i) {
+        if (nodes.at(i).kind == Node::KeyValue) {
+            m_index.insert(nodes.at(i).key, NodeRef{ s, i });
+        }
+    }
+}
+
+void TomlDocument::insertNode(int s, int pos, const Node &node)
+{
+    m_sections[s].nodes.insert(pos, node);
+    indexSection(s, pos);
+}
+
+// --- Zugriff ---------------------------------------------------------
+
+const TomlDocument::Value *TomlDocument::find(const QString &key) const
+{
+    ensureParsed();
+    auto it = m_index.constFind(key);
+    if (it == m_index.constEnd()) {
+        return nullptr;
+    }
+    return &m_sections.at(it->section).nodes.at(it->node).value;
+}
+
+QStringList TomlDocument::keys() const
+{
+    ensureParsed();
+    return m_index.keys();
+}
+
+bool TomlDocument::setValue(const QString &key, const QVariant &value)
+{
+    ensureParsed();
+
+    // Vorhandener Key: nur den Wert-Span ersetzen
+    auto it = m_index.constFind(key);
+    if (it != m_index.constEnd()) {
+        Node &n = m_sections[it->section].nodes[it->node];
+        const QString literal = formatValue(value, &n);
+        if (literal.isNull()) {
+            return false;
+        }
+        n.text.replace(n.valueStart, n.valueLength, literal);
+        n.valueLength = literal.size();
+        n.value = decodeValue(literal);
+        return true;
+    }
+
+    const QString literal = formatValue(value, nullptr);
+    const QStringList parts = splitKey(key);
+    if (literal.isNull() || parts.isEmpty()) {
+        return false;
+    }
+
+    // Längster vorhandener Tabellenpfad, z.B. "server.p2p_config" für "server.p2p_config.port"
+    int s = -1;
+    int depth = 0;
+    for (int d = parts.size() - 1; d >= 1 && s < 0; --d) {
+        auto sit = m_sectionIndex.constFind(QStringList(parts.mid(0, d)).join('.'));
+        if (sit != m_sectionIndex.constEnd()) {
+            s = sit.value();
+            depth = d;
+        }
+    }
+
+    if (s < 0 && parts.size() > 1) {
+        // Neue Tabelle am Dokumentende; ein abschließendes '\n' bleibt am Ende
+        Section &last = m_sections.last();
+        const bool trailingNewline = !last.nodes.isEmpty() && last.nodes.last().text.isEmpty()
+                                     && last.nodes.last().kind == Node::Other;
+        if (trailingNewline) {
+            last.nodes.removeLast();
+        }
+        bool needSeparator = false;
+        for (int i = m_sections.size() - 1; i >= 0; --i) {
+            if (!m_sections.at(i).nodes.isEmpty()) {
+                needSeparator = !m_sections.at(i).nodes.last().text.trimmed().isEmpty();
+                break;
+            }
+        }
+        if (needSeparator) {
+            last.nodes.append(Node());
+        }
+
+        Section sec;
+        sec.path = QStringList(parts.mid(0, parts.size() - 1)).join('.');
+        sec.nodes.append(parseStatement("[" + sec.path + "]", QString()));
+        sec.nodes.append(parseStatement(parts.last() + " = " + literal, sec.path));
+        if (trailingNewline) {
+            sec.nodes.append(Node());
+        }
+        m_sectionIndex.insert(sec.path, m_sections.size());
+        m_sections.append(sec);
+        indexSection(m_sections.size() - 1, 0);
+        return true;
+    }
+    if (s < 0) {
+        s = 0;  // Root-Key
+    }
+
+    // Hinter dem letzten Key der Sektion einfügen, Einrückung übernehmen
+    const QVector<Node> &nodes = m_sections.at(s).nodes;
+    int pos = -1;
+    for (int i = nodes.size() - 1; i >= 0; --i) {
+        if (nodes.at(i).kind == Node::KeyValue) {
+            pos = i + 1;
+            break;
+        }
+    }
+    QString indent;
+    if (pos > 0) {
+        const QString &ref = nodes.at(pos - 1).text;
+        int w = 0;
+        while (w < ref.size() && (ref.at(w) == ' ' || ref.at(w) == '\t')) {
+            ++w;
+        }
+        indent = ref.left(w);
+    } else if (s > 0) {
+        pos = 1;    // direkt unter den Header
+    } else {
+        pos = nodes.size();
+        while (pos > 0 && nodes.at(pos - 1).text.trimmed().isEmpty()) {
+            --pos;
+        }
+    }
+
+    const QString leaf = QStringList(parts.mid(depth)).join('.');
+    insertNode(s, pos, parseStatement(indent + leaf + " = " + literal, m_sections.at(s).path));
+    return true;
+}
+
+// --- Parser ----------------------------------------------------------
+
+// Fasst physische Zeilen zu Statements zusammen: Multi-Line-Strings und
+// über mehrere Zeilen laufende Arrays/Inline-Tabellen bilden ein Statement.
+QStringList TomlDocument::splitStatements(const QString &text)
+{
+    const QStringList lines = text.split('\n');
+    QStringList out;
+    out.reserve(lines.size());
+
+    QString current;
+    QString ml;         // offener Multi-Line-Delimiter (""" oder ''')
+    int depth = 0;      // offene [ / { im Wert
+    bool seenEq = false;
+    bool open = false;
+
+    for (const QString &line : lines) {
+        if (open) {
+            current += '\n';
+            current += line;
+        } else {
+            current = line;
+        }
+
+        int i = 0;
+        if (!ml.isEmpty()) {
+            const int close = findClose(line, 0, ml, ml.at(0) == '"');
+            if (close < 0) {
+                open = true;
+                continue;
+            }
+            i = close + 3;
+            ml.clear();
+        }
+
+        while (i < line.size()) {
+            const QChar c = line.at(i);
+            if (c == '#') {
+                break;
+            }
+            if (c == '"' || c == '\'') {
+                const QString triple(3, c);
+                if (QStringView(line).mid(i, 3) == triple) {
+                    const int close = findClose(line, i + 3, triple, c == '"');
+                    if (close < 0) {
+                        ml = triple;
+                        break;
+                    }
+                    i = close + 3;
+                    for (int extra = 0; extra < 2 && i < line.size() && line.at(i) == c; ++extra) {
+                        ++i;
+                    }
+                    continue;
+                }
+                const int close = findClose(line, i + 1, QString(c), c == '"');
+                i = close < 0 ? line.size() : close + 1;
+                continue;
+            }
+            if (c == '=') {
+                seenEq = true;
+            } else if (seenEq && (c == '[' || c == '{')) {
+                ++depth;
+            } else if (seenEq && (c == ']' || c == '}')) {
+                --depth;
+            }
+            ++i;
+        }
+
+        open = !ml.isEmpty() || depth > 0;
+        if (!open) {
+            out << current;
+            seenEq = false;
+            depth = 0;
+        }
+    }
+    if (open) {
+        out << current; // unvollständig am Dateiende, trotzdem erhalten
+    }
+    return out;
+}
+
+TomlDocument::Node TomlDocument::parseStatement(const QString &text, const QString &table)
+{
+    Node n;
+    n.text = text;
+
+    if (isHeader(text)) {
+        bool isArray = false;
+        n.key = headerPath(text, &isArray);
+        n.kind = isArray ? Node::ArrayTable : Node::Table;
+        return n;
+    }
+
+    const int eq = findEqualOutsideQuotes(text);
+    if (eq < 0) {
+        return n;   // Leerzeile / Kommentar
+    }
+
+    QStringList parts = splitKey(text.left(eq));
+    if (parts.isEmpty()) {
+        return n;
+    }
+    if (!table.isEmpty()) {
+        parts.prepend(table);
+    }
+
+    int start = eq + 1;
+    while (start < text.size() && (text.at(start) == ' ' || text.at(start) == '\t')) {
+        ++start;
+    }
+    const int end = valueEnd(text, start);
+
+    n.kind = Node::KeyValue;
+    n.key = parts.join('.');
+    n.valueStart = start;
+    n.valueLength = end - start;
+    n.value = decodeValue(text.mid(start, end - start));
+    return n;
+}
+
+bool TomlDocument::isHeader(const QString &statement)
+{
+    for (const QChar c : statement) {
+        if (c == ' ' || c == '\t') {
+            continue;
+        }
+        return c == '[';
+    }
+    return false;
+}
+
+QString TomlDocument::headerPath(const QString &statement, bool *isArray)
+{
+    const QString t = statement.trimmed();
+    *isArray = t.startsWith("[[");
+    const int open = *isArray ? 2 : 1;
+    int close = t.indexOf(*isArray ? "]]" : "]", open);
+    if (close < 0) {
+        close = t.size();
+    }
+    return splitKey(t.mid(open, close - open)).join('.');
+}
+
+// a.b, "a.b".c, 'x y' -> Teile ohne Quotes
+QStringList TomlDocument::splitKey(const QString &key)
+{
+    QStringList parts;
+    QString cur;
+    QChar quote;
+    for (const QChar c : key) {
+        if (!quote.isNull()) {
+            if (c == quote) {
+                quote = QChar();
+            } else {
+                cur += c;
+            }
+            continue;
+        }
+        if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '.') {
+            const QString t = cur.trimmed();
+            if (!t.isEmpty()) {
+                parts << t;
+            }
+            cur.clear();
+        } else {
+            cur += c;
+        }
+    }
+    const QString t = cur.trimmed();
+    if (!t.isEmpty()) {
+        parts << t;
+    }
+    return parts;
+}
+
+// Erstes '=' außerhalb von Strings, -1 bei Kommentar davor
+int TomlDocument::findEqualOutsideQuotes(const QString &s)
+{
+    QChar quote;
+    for (int i = 0; i < s.size(); ++i) {
+        const QChar c = s.at(i);
+        if (!quote.isNull()) {
+            if (quote == '"' && c == '\\') {
+                ++i;
+            } else if (c == quote) {
+                quote = QChar();
+            }
+            continue;
+        }
+        if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '=') {
+            return i;
+        } else if (c == '#' || c == '\n') {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+int TomlDocument::findClose(const QString &s, int from, const QString &delim, bool escapes)
+{
+    for (int i = from; i + delim.size() <= s.size(); ++i) {
+        if (escapes && s.at(i) == '\\') {
+            ++i;
+            continue;
+        }
+        if (QStringView(s).mid(i, delim.size()) == delim) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Ende des Werts ab start (exklusiv); Inline-Kommentare gehören nicht dazu
+int TomlDocument::valueEnd(const QString &s, int start)
+{
+    if (start >= s.size()) {
+        return start;
+    }
+
+    const QChar c = s.at(start);
+    if (c == '"' || c == '\'') {
+        const QString triple(3, c);
+        if (QStringView(s).mid(start, 3) == triple) {
+            const int close = findClose(s, start + 3, triple, c == '"');
+            if (close < 0) {
+                return s.size();
+            }
+            int end = close + 3;
+            for (int extra = 0; extra < 2 && end < s.size() && s.at(end) == c; ++extra) {
+                ++end;
+            }
+            return end;
+        }
+        const int close = findClose(s, start + 1, QString(c), c == '"');
+        return close < 0 ? s.size() : close + 1;
+    }
+
+    if (c == '[' || c == '{') {
+        int depth = 0;
+        for (int i = start; i < s.size(); ++i) {
+            const QChar d = s.at(i);
+            if (d == '"' || d == '\'') {
+                i = valueEnd(s, i) - 1;
+            } else if (d == '#') {
+                const int nl = s.indexOf('\n', i);
+                if (nl < 0) {
+                    return s.size();
+                }
+                i = nl;
+            } else if (d == '[' || d == '{') {
+                ++depth;
+            } else if ((d == ']' || d == '}') && --depth == 0) {
+                return i + 1;
+            }
+        }
+        return s.size();
+    }
+
+    int end = start;
+    while (end < s.size() && s.at(end) != '#' && s.at(end) != '\n') {
+        ++end;
+    }
+    while (end > start && s.at(end - 1).isSpace()) {
+        --end;
+    }
+    return end;
+}
+
+TomlDocument::Value TomlDocument::decodeValue(const QString &literal)
+{
+    auto dropFirstNewline = [](QString inner) {
+        if (inner.startsWith("\r\n")) {
+            inner.remove(0, 2);
+        } else if (inner.startsWith('\n')) {
+            inner.remove(0, 1);
+        }
+        return inner;
+    };
+
+    if (literal.size() >= 6 && literal.startsWith("\"\"\"")) {
+        return Value{ unescape(dropFirstNewline(literal.mid(3, literal.size() - 6))), true };
+    }
+    if (literal.size() >= 6 && literal.startsWith("'''")) {
+        return Value{ dropFirstNewline(literal.mid(3, literal.size() - 6)), true };
+    }
+    if (literal.size() >= 2 && literal.startsWith('"') && literal.endsWith('"')) {
+        return Value{ unescape(literal.mid(1, literal.size() - 2)), true };
+    }
+    if (literal.size() >= 2 && literal.startsWith('\'') && literal.endsWith('\'')) {
+        return Value{ literal.mid(1, literal.size() - 2), true };
+    }
+    // unquoted literal (true/false/number/array) -> roh
+    return Value{ literal, false };
+}
+
+/**
+ * @brief TomlDocument::isBareScalar
+ * true, wenn literal ohne Quotes als TOML-Skalar gelesen wird: Bool,
+ * Integer (dezimal, 0x/0o/0b, mit '_'), Float (inkl. inf/nan) oder
+ * Datum/Uhrzeit nach RFC 3339.
+ */
+bool TomlDocument::isBareScalar(const QString &literal)
+{
+    static const QRegularExpression kScalar(QRegularExpression::anchoredPattern(QStringLiteral(
+        "true|false"
+        "|[+-]?(?:0|[1-9](?:_?[0-9])*)(?:\\.[0-9](?:_?[0-9])*)?(?:[eE][+-]?[0-9](?:_?[0-9])*)?"
+        "|0x[0-9A-Fa-f](?:_?[0-9A-Fa-f])*|0o[0-7](?:_?[0-7])*|0b[01](?:_?[01])*"
+        "|[+-]?(?:inf|nan)"
+        "|[0-9]{4}-[0-9]{2}-[0-9]{2}(?:[Tt ][0-9]{2}:[0-9]{2}:[0-9]{2}(?:\\.[0-9]+)?(?:[Zz]|[+-][0-9]{2}:[0-9]{2})?)?"
+        "|[0-9]{2}:[0-9]{2}:[0-9]{2}(?:\\.[0-9]+)?")));
+    return kScalar.match(literal).hasMatch();
+}
+
+QString TomlDocument::unescape(const QString &s)
+{
+    QString out;
+    out.reserve(s.size());
+    for (int i = 0; i < s.size(); ++i) {
+        const QChar c = s.at(i);
+        if (c != '\\' || i + 1 >= s.size()) {
+            out += c;
+            continue;
+        }
+
+        const QChar e = s.at(++i);
+        switch (e.unicode()) {
+        case 'n': out += '\n'; break;
+        case 't': out += '\t'; break;
+        case 'r': out += '\r'; break;
+        case 'b': out += '\b'; break;
+        case 'f': out += '\f'; break;
+        case 'e': out += QChar(0x1b); break;
+        case '"': out += '"'; break;
+        case '\\': out += '\\'; break;
+        case 'u':
+        case 'U':
+        {
+            const int len = e == 'u' ? 4 : 8;
+            bool ok = false;
+            const char32_t cp = s.mid(i + 1, len).toUInt(&ok, 16);
+            if (ok) {
+                out += QString::fromUcs4(&cp, 1);
+                i += len;
+            } else {
+                out += '\\';
+                out += e;
+            }
+            break;
+        }
+        default:
+        {
+            // "line ending backslash" in Multi-Line-Strings: Umbruch + Einrückung entfallen
+            int j = i;
+            while (j < s.size() && (s.at(j) == ' ' || s.at(j) == '\t' || s.at(j) == '\r')) {
+                ++j;
+            }
+            if (j < s.size() && s.at(j) == '\n') {
+                while (j < s.size() && s.at(j).isSpace()) {
+                    ++j;
+                }
+                i = j - 1;
+                break;
+            }
+            out += '\\';
+            out += e;
+            break;
+        }
+        }
+    }
+    return out;
+}
+
+QString TomlDocument::escapeBasic(const QString &s, bool multiLine)
+{
+    QString out;
+    out.reserve(s.size() + 2);
+    for (const QChar c : s) {
+        if (c == '\\') {
+            out += "\\\\";
+        } else if (c == '"') {
+            out += "\\\"";
+        } else if (c == '\n') {
+            out += multiLine ? QString("\n") : QString("\\n");
+        } else if (c == '\t') {
+            out += "\\t";
+        } else if (c == '\r') {
+            out += "\\r";
+        } else if (c.unicode() < 0x20 || c.unicode() == 0x7f) {
+            out += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// QVariant -> TOML-Literal; Stil des bisherigen Werts (Quotes, Float) bleibt.
+// Null-String = nicht darstellbar.
+QString TomlDocument::formatValue(const QVariant &value, const Node *old)
+{
+    const QString oldLiteral = old ? old->text.mid(old->valueStart, old->valueLength) : QString();
+
+    switch (value.metaType().id()) {
+    case QMetaType::Bool:
+        return value.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+        return value.toString();
+    case QMetaType::Float:
+    case QMetaType::Double:
+    {
+        const double d = value.toDouble();
+        if (std::isnan(d)) {
+            return QStringLiteral("nan");
+        }
+        if (std::isinf(d)) {
+            return d > 0 ? QStringLiteral("inf") : QStringLiteral("-inf");
+        }
+        // Aus QML kommen auch ganze Zahlen als double
+        const bool wasFloat = oldLiteral.contains('.') || oldLiteral.contains('e')
+                              || oldLiteral.contains('E');
+        if (!wasFloat && d == std::floor(d) && std::fabs(d) < 9.0e15) {
+            return QString::number(qint64(d));
+        }
+        QString s = QString::number(d, 'g', QLocale::FloatingPointShortest);
+        if (!s.contains('.') && !s.contains('e')) {
+            s += ".0";
+        }
+        return s;
+    }
+    case QMetaType::QVariantList:
+    case QMetaType::QStringList:
+    {
+        QStringList items;
+        for (const QVariant &v : value.toList()) {
+            const QString item = formatValue(v, nullptr);
+            if (item.isNull()) {
+                return QString();
+            }
+            items << item;
+        }
+        return "[" + items.join(", ") + "]";
+    }
+    case QMetaType::QString:
+    {
+        const QString s = value.toString();
+        // unquoted bleibt unquoted (Zahlen/Bools aus Textfeldern), aber nur
+        // solange der Text ein gültiger Skalar ist; alles andere wird String
+        if (old && !old->value.quoted && isBareScalar(s)) {
+            return s;
+        }
+        // ein führender Umbruch würde bei """ / ''' verschluckt
+        const QString lead = s.startsWith('\n') ? QString("\n") : QString();
+        if (oldLiteral.startsWith("'''") && !s.contains("'''")) {
+            return "'''" + lead + s + "'''";
+        }
+        if (oldLiteral.startsWith("\"\"\"")) {
+            return "\"\"\"" + lead + escapeBasic(s, true) + "\"\"\"";
+        }
+        if (oldLiteral.startsWith('\'') && !oldLiteral.startsWith("'''")
+            && !s.contains('\'') && !s.contains('\n')) {
+            return "'" + s + "'";
+        }
+        return "\"" + escapeBasic(s, false) + "\"";
+    }
+    default:
+        return QString();
+    }
+}
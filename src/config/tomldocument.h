@@ -0,0 +1,91 @@
+#ifndef TOMLDOCUMENT_H
+#define TOMLDOCUMENT_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVariant>
+#include <QVector>
+
+// TOML-Dokument als Baum aus Sektionen ([table] / [[array]]) mit ihren
+// Statements. Jedes Statement behält seinen Originaltext (inkl. Kommentaren,
+// Einrückung, Multi-Line-Strings), Werte sind nur Spans darin. setValue
+// patcht genau diesen Span, alles andere bleibt Byte für Byte erhalten.
+class TomlDocument
+{
+public:
+    struct Value {
+        QString text;       // dekodiert (Strings ohne Quotes/Escapes), sonst roh
+        bool quoted;
+    };
+
+    TomlDocument();
+
+    // Neuer Gesamttext; ist das Dokument schon geparst, wird nur der
+    // geänderte Statement-Bereich neu eingelesen
+    void setText(const QString &text);
+    QString toString() const;
+    void write(QTextStream &out) const;
+
+    const Value *find(const QString &key) const;
+    QStringList keys() const;
+
+    // Setzt einen Wert; fehlende Keys werden in ihrer Tabelle (oder einer
+    // neuen Tabelle am Ende) angelegt. false bei nicht darstellbarem Wert.
+    bool setValue(const QString &key, const QVariant &value);
+
+private:
+    struct Node {
+        enum Kind {
+            Other, Table, ArrayTable, KeyValue
+        };
+        Kind kind;
+        QString text;       // Statement ohne abschließendes '\n'
+        QString key;        // vollqualifiziert, nur KeyValue
+        int valueStart;     // Span des Werts in text
+        int valueLength;
+        Value value;
+        Node() : kind(Other), valueStart(0), valueLength(0), value{ QString(), false }
+        {
+        }
+    };
+
+    struct Section {
+        QString path;       // "" = Root, Array-of-Tables als "peer[0]"
+        QVector<Node> nodes; // nodes[0] ist der Header (außer bei Root)
+    };
+
+    struct NodeRef {
+        int section;
+        int node;
+    };
+
+    void ensureParsed() const;
+    void rebuild(const QStringList &statements) const;
+    void indexSection(int s, int from) const;
+    void insertNode(int s, int pos, const Node &node);
+
+    static QStringList splitStatements(const QString &text);
+    static Node parseStatement(const QString &text, const QString &table);
+    static bool isHeader(const QString &statement);
+    static QString headerPath(const QString &statement, bool *isArray);
+    static QStringList splitKey(const QString &key);
+    static int findEqualOutsideQuotes(const QString &s);
+    static int findClose(const QString &s, int from, const QString &delim, bool escapes);
+    static int valueEnd(const QString &s, int start);
+    static Value decodeValue(const QString &literal);
+    static bool isBareScalar(const QString &literal);
+    static QString unescape(const QString &s);
+    static QString escapeBasic(const QString &s, bool multiLine);
+    static QString formatValue(const QVariant &value, const Node *old);
+
+    // Lazy: erst beim ersten Zugriff wird m_raw in den Baum überführt
+    mutable bool m_parsed;
+    mutable QString m_raw;
+    mutable QVector<Section> m_sections;
+    mutable QHash<QString, NodeRef> m_index;
+    mutable QHash<QString, int> m_sectionIndex;
+};
+
+#endif // TOMLDOCUMENT_H
@@ -0,0 +1,177 @@
+#include "geocache.h"
+
+#include <QDateTime>
+#include <QHostAddress>
+
+#include <cstring>
+
+namespace {
+
+const quint8 kRecordVersion = 1;
+const qint64 kEntryTtlMs = qint64(14) * 24 * 60 * 60 * 1000;   // Peers ziehen selten um
+const int kFlushDelayMs = 2000;
+
+} // namespace
+
+GeoCache::GeoCache(QObject *parent) :
+    QObject(parent),
+    m_store("GeoCache")
+{
+    static_assert(sizeof(Record) == 64, "GeoCache::Record must stay 64 bytes");
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushDelayMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &GeoCache::flush);
+
+    m_store.open("geocache.bin", "geo/cache", [this](const uchar *data, qint64 size) {
+        parse(data, size);
+    });
+}
+
+GeoCache::~GeoCache()
+{
+    flush();
+}
+
+// --- Lookup ----------------------------------------------------------
+
+bool GeoCache::find(const QString &ip, Entry *out, bool allowPrefix) const
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    auto it = m_entries.constFind(ip);
+    if (it == m_entries.constEnd() || it->expiresAtMs <= now) {
+        if (!allowPrefix) {
+            return false;
+        }
+        it = m_entries.constFind(prefixOf(ip));
+        if (it == m_entries.constEnd() || it->expiresAtMs <= now) {
+            return false;
+        }
+    }
+    *out = it.value();
+    return true;
+}
+
+void GeoCache::insert(const QString &ip, double lat, double lon)
+{
+    const Entry e{ float(lat), float(lon), QDateTime::currentMSecsSinceEpoch() + kEntryTtlMs };
+    put(ip, e);
+
+    const QString prefix = prefixOf(ip);
+    if (!prefix.isEmpty()) {
+        put(prefix, e);
+    }
+    scheduleFlush();
+}
+
+void GeoCache::put(const QString &key, const Entry &e)
+{
+    if (key.toLatin1().size() > int(sizeof(Record::key))) {
+        return;
+    }
+    m_entries.insert(key, e);
+    m_pending.append(qMakePair(key, e));
+}
+
+// "1.2.3.4" -> "1.2.3.0/24", "2001:db8:1:2::5" -> "2001:db8:1::/48"
+QString GeoCache::prefixOf(const QString &ip)
+{
+    QHostAddress addr;
+    if (!addr.setAddress(ip)) {
+        return QString();
+    }
+
+    bool isV4 = false;
+    const quint32 a4 = addr.toIPv4Address(&isV4);
+    if (isV4) {
+        return QHostAddress(a4 & 0xffffff00u).toString() + "/24";
+    }
+
+    Q_IPV6ADDR a6 = addr.toIPv6Address();
+    for (int i = 6; i < 16; ++i) {
+        a6[i] = 0;
+    }
+    return QHostAddress(a6).toString() + "/48";
+}
+
+// --- Persistenz ------------------------------------------------------
+
+void GeoCache::scheduleFlush()
+{
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+QByteArray GeoCache::serialize(const QVector<QPair<QString, Entry> > &entries) const
+{
+    QByteArray out(entries.size() * int(sizeof(Record)), '\0');
+    Record *r = reinterpret_cast<Record *>(out.data());
+    for (const QPair<QString, Entry> &p : entries) {
+        const QByteArray key = p.first.toLatin1();
+        r->version = kRecordVersion;
+        r->keyLength = quint8(key.size());
+        r->lat = p.second.lat;
+        r->lon = p.second.lon;
+        r->expiresAtMs = p.second.expiresAtMs;
+        std::memcpy(r->key, key.constData(), size_t(key.size()));
+        ++r;
+    }
+    return out;
+}
+
+void GeoCache::parse(const uchar *data, qint64 size)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 count = size / qint64(sizeof(Record));
+
+    for (qint64 i = 0; i < count; ++i) {
+        Record r;
+        std::memcpy(&r, data + i * qint64(sizeof(Record)), sizeof(Record));
+        if (r.version != kRecordVersion || r.keyLength == 0 || r.keyLength > sizeof(r.key)) {
+            continue;
+        }
+        // spätere Records überschreiben frühere
+        const QString key = QString::fromLatin1(r.key, r.keyLength);
+        if (r.expiresAtMs > now) {
+            m_entries.insert(key, Entry{ r.lat, r.lon, r.expiresAtMs });
+        } else {
+            m_entries.remove(key);
+        }
+    }
+}
+
+/**
+ * @brief GeoCache::flush
+ * Hängt die gesammelten Einträge an; sind mehr als doppelt so viele Records
+ * gespeichert wie gültige Einträge existieren, wird die Datei neu geschrieben.
+ */
+void GeoCache::flush()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    const qint64 storedRecords = m_store.size() / qint64(sizeof(Record));
+    const bool compact = storedRecords + m_pending.size() > 2 * m_entries.size() + 256;
+
+    bool written = false;
+    if (compact) {
+        QVector<QPair<QString, Entry> > live;
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
+        for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+            if (it->expiresAtMs > now) {
+                live.append(qMakePair(it.key(), it.value()));
+            }
+        }
+        written = m_store.rewrite(serialize(live));
+    } else {
+        written = m_store.append(serialize(m_pending));
+    }
+    if (!written) {
+        return;
+    }
+    m_pending.clear();
+}
@@ -0,0 +1,68 @@
+#ifndef GEOCACHE_H
+#define GEOCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+#include "storage/appendlogstore.h"
+
+// Persistenter GeoIP-Cache (ip -> lat/lon mit Ablaufzeit).
+// Feste 64-Byte-Records im AppendLogStore, nach dem Laden nur angehängt
+// (gelegentlich kompaktiert).
+// Jeder Treffer wird zusätzlich unter seinem /24- (IPv4) bzw. /48-Präfix
+// (IPv6) abgelegt, damit neue Peers aus bekannten Netzen sofort auflösen.
+class GeoCache : public QObject
+{
+    Q_OBJECT
+public:
+    struct Entry {
+        float lat;
+        float lon;
+        qint64 expiresAtMs;
+    };
+
+    explicit GeoCache(QObject *parent = nullptr);
+    ~GeoCache() override;
+
+    // Exakter Treffer, sonst (allowPrefix) über das Netz-Präfix
+    bool find(const QString &ip, Entry *out, bool allowPrefix = true) const;
+    void insert(const QString &ip, double lat, double lon);
+    int size() const
+    {
+        return m_entries.size();
+    }
+
+    // Ausstehende Einträge sofort schreiben (sonst gebündelt per Timer)
+    void flush();
+
+    static QString prefixOf(const QString &ip);
+
+private:
+    // Layout der Records im AppendLogStore
+    struct Record {
+        quint8 version;
+        quint8 keyLength;
+        quint16 reserved;
+        float lat;
+        float lon;
+        quint32 pad;
+        qint64 expiresAtMs;
+        char key[40];
+    };
+
+    void put(const QString &key, const Entry &e);
+    void scheduleFlush();
+    QByteArray serialize(const QVector<QPair<QString, Entry> > &entries) const;
+    void parse(const uchar *data, qint64 size);
+
+    QHash<QString, Entry> m_entries;    // IPs und "netz/NN"-Präfixe
+    QVector<QPair<QString, Entry> > m_pending;
+    QTimer m_flushTimer;
+    AppendLogStore m_store;
+};
+
+#endif // GEOCACHE_H
@@ -6,86 +6,448 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QDebug>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QSet>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+
+#include <algorithm>
+
+namespace {
+
+const int kBatchLimit = 100;            // ip-api.com: max. Einträge pro Batch
+const int kMaxParallelChunks = 3;
+const qint64 kFailureTtlMs = 30 * 60 * 1000;    // "private range", "invalid query", ...
+const qint64 kErrorRetryMs = 60 * 1000;         // Netzwerk-/Parse-Fehler
+const int kMaxFailures = 4096;                  // danach werden abgelaufene/älteste verworfen
+#if !QT_CONFIG(thread)
+const int kImportSliceLines = 2000;     // CSV-Zeilen pro Import-Schritt
+const int kSliceBudgetMs = 8;           // danach kommt der Event-Loop wieder dran
+#endif
+
+} // namespace
 
 GeoLookup::GeoLookup(QObject *parent) :
     QObject(parent),
-    m_manager(new QNetworkAccessManager(this))
+    m_manager(new QNetworkAccessManager(this)),
+    m_cache(new GeoCache(this))
+{
+    // Standard: GEOIP_DB, sonst geoip.bin / geoip.csv im App-Datenverzeichnis
+    QString path = QString::fromUtf8(qgetenv("GEOIP_DB"));
+    if (path.isEmpty()) {
+        const QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        for (const QString &name : { QStringLiteral("geoip.bin"), QStringLiteral("geoip.csv") }) {
+            if (QFileInfo::exists(dataDir + "/" + name)) {
+                path = dataDir + "/" + name;
+                break;
+            }
+        }
+    }
+    if (!path.isEmpty()) {
+        setDatabasePath(path);
+    }
+}
+
+void GeoLookup::setDatabasePath(const QString &path)
+{
+    if (m_databasePath == path) {
+        return;
+    }
+    m_databasePath = path;
+    loadDatabase();
+    emit databaseChanged();
+}
+
+void GeoLookup::setHttpFallback(bool on)
+{
+    if (m_httpFallback == on) {
+        return;
+    }
+    m_httpFallback = on;
+    emit httpFallbackChanged();
+}
+
+// .bin direkt öffnen; CSV einmalig in eine Binärtabelle im Cache-Verzeichnis
+// übersetzen (im Hintergrund) und diese bei späteren Starts wiederverwenden
+void GeoLookup::loadDatabase()
+{
+    ++m_buildGeneration;
+#if !QT_CONFIG(thread)
+    m_import.reset();
+#endif
+    m_table.close();
+    if (m_databasePath.isEmpty()) {
+        return;
+    }
+
+    const QFileInfo fi(m_databasePath);
+    if (fi.isFile() && fi.suffix().compare("bin", Qt::CaseInsensitive) == 0) {
+        openTable(fi.absoluteFilePath());
+        return;
+    }
+
+    QStringList csvs;
+    QDateTime newest;
+    const QFileInfoList sources = fi.isDir()
+                                  ? QDir(fi.absoluteFilePath()).entryInfoList({ "*.csv" }, QDir::Files, QDir::Name)
+                                  : QFileInfoList{ fi };
+    for (const QFileInfo &src : sources) {
+        if (!src.isFile()) {
+            continue;
+        }
+        csvs << src.absoluteFilePath();
+        if (!newest.isValid() || src.lastModified() > newest) {
+            newest = src.lastModified();
+        }
+    }
+    if (csvs.isEmpty()) {
+        qWarning() << "GeoLookup: no GeoIP database at" << m_databasePath;
+        return;
+    }
+
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QDir().mkpath(cacheDir);
+    const QString bin = QString("%1/geoip-%2.bin").arg(cacheDir)
+                        .arg(qHash(fi.absoluteFilePath()), 0, 16);
+
+    const QFileInfo binInfo(bin);
+    if (binInfo.exists() && binInfo.lastModified() >= newest) {
+        openTable(bin);
+        if (m_table.isOpen()) {
+            return;
+        }
+    }
+
+#if QT_CONFIG(thread)
+    const int generation = m_buildGeneration;
+    QThread *worker = QThread::create([csvs, bin]() {
+        QString err;
+        if (!GeoRangeTable::buildFromCsv(csvs, bin, &err)) {
+            qWarning() << "GeoLookup: GeoIP import failed:" << err;
+        }
+    });
+    connect(worker, &QThread::finished, worker, &QObject::deleteLater);
+    connect(worker, &QThread::finished, this, [this, generation, bin]() {
+        if (generation == m_buildGeneration) {
+            openTable(bin);
+        }
+    });
+    worker->start();
+#else
+    // ohne Threads: in Zeitscheiben importieren, damit die UI bedienbar bleibt
+    m_import.reset(new GeoRangeTable::CsvImport(csvs, bin));
+    m_importBin = bin;
+    importSlice(m_buildGeneration);
+#endif
+}
+
+#if !QT_CONFIG(thread)
+/**
+ * @brief GeoLookup::importSlice
+ * Liest CSV-Zeilen in Stücken von kImportSliceLines, bis das Zeitbudget
+ * aufgebraucht ist, und plant sich sonst neu ein. Ein neuer loadDatabase()
+ * verwirft den laufenden Import über die Generation.
+ */
+void GeoLookup::importSlice(int generation)
+{
+    if (generation != m_buildGeneration || !m_import) {
+        return;
+    }
+
+    QElapsedTimer budget;
+    budget.start();
+    bool done = false;
+    while (!done && budget.elapsed() < kSliceBudgetMs) {
+        done = m_import->step(kImportSliceLines);
+    }
+    if (!done) {
+        QTimer::singleShot(0, this, [this, generation]() {
+            importSlice(generation);
+        });
+        return;
+    }
+
+    QString err;
+    const bool ok = m_import->finish(&err);
+    m_import.reset();
+    if (!ok) {
+        qWarning() << "GeoLookup: GeoIP import failed:" << err;
+        return;
+    }
+    openTable(m_importBin);
+}
+#endif
+
+void GeoLookup::openTable(const QString &binPath)
+{
+    QString err;
+    if (!m_table.open(binPath, &err)) {
+        qWarning() << "GeoLookup: cannot open GeoIP table" << binPath << err;
+    }
+    emit databaseChanged();
+}
+
+QVariantMap GeoLookup::successResult(const LatLon &p)
+{
+    QVariantMap m;
+    m["status"] = QStringLiteral("success");
+    m["lat"] = p.first;
+    m["lon"] = p.second;
+    return m;
+}
+
+QVariantList GeoLookup::coordsFor(const QStringList &ips) const
 {
+    QVariantList coords;
+    for (const QString &ip : ips) {
+        GeoCache::Entry e;
+        if (!m_cache->find(ip, &e)) {
+            continue;
+        }
+        QVariantMap m;
+        m["ip"] = ip;
+        m["lat"] = e.lat;
+        m["lon"] = e.lon;
+        coords.append(m);
+    }
+    return coords;
 }
 
 void GeoLookup::lookupIPs(const QVariantList &ips)
 {
-    QList<LatLon> known;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QStringList all;
     QStringList toFetch;
+    QSet<QString> seen;
 
-    // durch alle IPs gehen
+    // durch alle IPs gehen; Cache-Treffer und frische Fehlschläge sind erledigt
     for (const QVariant &v : ips) {
-        QString ip = v.toString();
-        if (m_cache.contains(ip)) {
-            known.append(m_cache.value(ip));
-        } else {
-            toFetch.append(ip);
+        const QString ip = v.toString();
+        if (ip.isEmpty() || seen.contains(ip)) {
+            continue;
+        }
+        seen.insert(ip);
+        all.append(ip);
+
+        // auch über ein bekanntes /24- bzw. /48-Netz
+        GeoCache::Entry cached;
+        if (m_cache->find(ip, &cached)) {
+            continue;
+        }
+        auto f = m_failures.find(ip);
+        if (f != m_failures.end()) {
+            if (f->retryAtMs > now) {
+                continue;
+            }
+            m_failures.erase(f);
         }
+        toFetch.append(ip);
     }
 
-    // Wenn nichts nachzuholen ist, direkt Ergebnis aus Cache senden
-    if (toFetch.isEmpty()) {
-        QVariantList coords;
-        for (const LatLon &p : known) {
-            QVariantMap m;
-            m["lat"] = p.first;
-            m["lon"] = p.second;
-            coords.append(m);
+    // Lokale Tabelle: alle noch unbekannten IPs in einem Durchgang
+    QVariantMap batch;
+    if (!toFetch.isEmpty() && m_table.isOpen()) {
+        const QVector<GeoRangeTable::Hit> hits = m_table.lookupBatch(toFetch);
+        QStringList missing;
+        for (int i = 0; i < toFetch.size(); ++i) {
+            if (hits.at(i).found) {
+                const LatLon p(hits.at(i).lat, hits.at(i).lon);
+                m_cache->insert(toFetch.at(i), p.first, p.second);
+                batch.insert(toFetch.at(i), successResult(p));
+            } else {
+                missing.append(toFetch.at(i));
+            }
         }
-        emit lookupFinished(coords);
+        toFetch = missing;
+    }
+    if (!batch.isEmpty()) {
+        emit resultsReady(batch);
+    }
+
+    // Wenn nichts nachzuholen ist (oder kein HTTP erwünscht), direkt Ergebnis senden
+    if (toFetch.isEmpty() || !m_httpFallback) {
+        emit lookupFinished(coordsFor(all));
         return;
     }
 
-    // Anfrage bauen
-    QJsonArray arr;
+    // IPs, die schon im Flug sind, warten nur auf die laufende Anfrage
+    const int id = m_nextQueryId++;
+    m_queries.insert(id, Query{ all, int(toFetch.size()) });
+
+    QStringList fresh;
     for (const QString &ip : toFetch) {
-        arr.append(QJsonObject{{"query", ip}});
+        auto it = m_waiting.find(ip);
+        if (it == m_waiting.end()) {
+            m_waiting.insert(ip, QList<int>{ id });
+            fresh.append(ip);
+        } else {
+            it->append(id);
+        }
     }
+    enqueueChunks(fresh);
+}
 
-    QNetworkRequest req(QUrl("http://ip-api.com/batch"));
-    req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+void GeoLookup::enqueueChunks(const QStringList &ips)
+{
+    for (int i = 0; i < ips.size(); i += kBatchLimit) {
+        m_chunkQueue.append(ips.mid(i, kBatchLimit));
+    }
+    sendNextChunks();
+}
 
-    QNetworkReply *reply = m_manager->post(req, QJsonDocument(arr).toJson());
+void GeoLookup::sendNextChunks()
+{
+    while (!m_rateLimited && m_activeChunks < kMaxParallelChunks && !m_chunkQueue.isEmpty()) {
+        const QStringList chunk = m_chunkQueue.takeFirst();
 
-    connect(reply, &QNetworkReply::finished, this, [this, reply, known]() mutable {
-        QByteArray data = reply->readAll();
-        reply->deleteLater();
+        // Anfrage bauen
+        QJsonArray arr;
+        for (const QString &ip : chunk) {
+            arr.append(QJsonObject{{"query", ip}});
+        }
 
-        QList<LatLon> all = known; // starte mit Cache-Ergebnissen
+        QNetworkRequest req(QUrl("http://ip-api.com/batch?fields=status,message,query,lat,lon"));
+        req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
-        QJsonParseError err;
-        QJsonDocument doc = QJsonDocument::fromJson(data, &err);
-        if (err.error != QJsonParseError::NoError || !doc.isArray()) {
-            qWarning() << "GeoLookup JSON Fehler:" << err.errorString();
-        } else {
-            QJsonArray arr = doc.array();
-            for (const QJsonValue &v : arr) {
-                QJsonObject obj = v.toObject();
-                if (obj.value("status").toString() == "success") {
-                    QString ip = obj.value("query").toString();
-                    double lat = obj.value("lat").toDouble();
-                    double lon = obj.value("lon").toDouble();
-                    LatLon p(lat, lon);
-                    m_cache.insert(ip, p);
-                    all.append(p);
-                }
+        QNetworkReply *reply = m_manager->post(req, QJsonDocument(arr).toJson(QJsonDocument::Compact));
+        ++m_activeChunks;
+        connect(reply, &QNetworkReply::finished, this, [this, reply, chunk]() {
+            onChunkFinished(reply, chunk);
+        });
+    }
+}
+
+void GeoLookup::onChunkFinished(QNetworkReply *reply, const QStringList &chunk)
+{
+    --m_activeChunks;
+    reply->deleteLater();
+
+    const QByteArray data = reply->readAll();
+    const int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    // ip-api.com: X-Rl = verbleibende Requests im Fenster, X-Ttl = Sekunden bis Reset
+    if (httpStatus == 429 || reply->rawHeader("X-Rl") == "0") {
+        const int ttl = qMax(1, reply->rawHeader("X-Ttl").toInt());
+        m_rateLimited = true;
+        QTimer::singleShot(ttl * 1000, this, [this]() {
+            m_rateLimited = false;
+            sendNextChunks();
+        });
+    }
+    if (httpStatus == 429) {
+        m_chunkQueue.prepend(chunk);    // nach dem Reset erneut
+        return;
+    }
+
+    QVariantMap batch;
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(data, &err);
+    if (reply->error() != QNetworkReply::NoError) {
+        qWarning() << "GeoLookup Netzwerkfehler:" << reply->errorString();
+    } else if (err.error != QJsonParseError::NoError || !doc.isArray()) {
+        qWarning() << "GeoLookup JSON Fehler:" << err.errorString();
+    } else {
+        const QJsonArray arr = doc.array();
+        for (const QJsonValue &v : arr) {
+            const QJsonObject obj = v.toObject();
+            const QString ip = obj.value("query").toString();
+            if (!chunk.contains(ip)) {
+                continue;
+            }
+            if (obj.value("status").toString() == "success") {
+                const LatLon p(obj.value("lat").toDouble(), obj.value("lon").toDouble());
+                m_cache->insert(ip, p.first, p.second);
+                m_failures.remove(ip);
+                batch.insert(ip, successResult(p));
+            } else {
+                markFailed(ip, obj.value("message").toString(), kFailureTtlMs, &batch);
             }
         }
+    }
 
-        // Ergebnis in QVariantList für QML umwandeln
-        QVariantList coords;
-        for (const LatLon &p : all) {
-            QVariantMap m;
-            m["lat"] = p.first;
-            m["lon"] = p.second;
-            coords.append(m);
+    // Ohne Antwort: kurze Sperre, beim nächsten Poll wird es erneut versucht
+    for (const QString &ip : chunk) {
+        if (!batch.contains(ip)) {
+            markFailed(ip, reply->error() != QNetworkReply::NoError ? reply->errorString()
+                                                                    : QStringLiteral("no result"),
+                       kErrorRetryMs, &batch);
         }
+    }
 
-        emit lookupFinished(coords);
-    });
+    emit resultsReady(batch);
+    for (const QString &ip : chunk) {
+        finishIp(ip);
+    }
+    sendNextChunks();
+}
+
+void GeoLookup::markFailed(const QString &ip, const QString &message, qint64 ttlMs, QVariantMap *batch)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (m_failures.size() >= kMaxFailures && !m_failures.contains(ip)) {
+        pruneFailures(now);
+    }
+    m_failures.insert(ip, Failure{ now + ttlMs, message });
+
+    QVariantMap m;
+    m["status"] = QStringLiteral("fail");
+    m["message"] = message;
+    batch->insert(ip, m);
+}
+
+/**
+ * @brief GeoLookup::pruneFailures
+ * Entfernt abgelaufene Fehlschläge; reicht das nicht, die Hälfte mit der
+ * frühesten Wiederholzeit (die würden ohnehin als Nächste neu angefragt).
+ */
+void GeoLookup::pruneFailures(qint64 now)
+{
+    for (auto it = m_failures.begin(); it != m_failures.end();) {
+        if (it->retryAtMs <= now) {
+            it = m_failures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (m_failures.size() < kMaxFailures) {
+        return;
+    }
+
+    QVector<qint64> retryAt;
+    retryAt.reserve(m_failures.size());
+    for (auto it = m_failures.constBegin(); it != m_failures.constEnd(); ++it) {
+        retryAt.append(it->retryAtMs);
+    }
+    std::nth_element(retryAt.begin(), retryAt.begin() + retryAt.size() / 2, retryAt.end());
+    const qint64 cutoff = retryAt.at(retryAt.size() / 2);
+    for (auto it = m_failures.begin(); it != m_failures.end();) {
+        if (it->retryAtMs <= cutoff) {
+            it = m_failures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// IP beantwortet: wartende Queries abschließen, sobald alle ihre IPs da sind
+void GeoLookup::finishIp(const QString &ip)
+{
+    const QList<int> ids = m_waiting.take(ip);
+    for (int id : ids) {
+        auto it = m_queries.find(id);
+        if (it == m_queries.end()) {
+            continue;
+        }
+        if (--it->remaining <= 0) {
+            const QStringList ips = it->ips;
+            m_queries.erase(it);
+            emit lookupFinished(coordsFor(ips));
+        }
+    }
 }
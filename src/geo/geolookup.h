@@ -5,11 +5,23 @@
 #include <QStringList>
 #include <QVariantList>
 #include <QHash>
+#include <QList>
 #include <QPair>
+#include <QVariantMap>
+
+#include <memory>
+
+#include "geocache.h"
+#include "georangetable.h"
 
 class GeoLookup : public QObject
 {
     Q_OBJECT
+    // Lokale GeoIP-Datenbank: .bin (fertige Tabelle), .csv oder Verzeichnis mit CSVs
+    Q_PROPERTY(QString databasePath READ databasePath WRITE setDatabasePath NOTIFY databaseChanged)
+    Q_PROPERTY(bool databaseReady READ databaseReady NOTIFY databaseChanged)
+    // ip-api.com nur noch für IPs, die die lokale Tabelle nicht kennt
+    Q_PROPERTY(bool httpFallback READ httpFallback WRITE setHttpFallback NOTIFY httpFallbackChanged)
 public:
     explicit GeoLookup(QObject *parent = nullptr);
 
@@ -18,13 +30,81 @@ public:
     // QML soll diese Methode aufrufen können
     Q_INVOKABLE void lookupIPs(const QVariantList &ips);
 
+    QString databasePath() const
+    {
+        return m_databasePath;
+    }
+    void setDatabasePath(const QString &path);
+    bool databaseReady() const
+    {
+        return m_table.isOpen();
+    }
+
+    bool httpFallback() const
+    {
+        return m_httpFallback;
+    }
+    void setHttpFallback(bool on);
+
 signals:
-    // Signal für QML mit einer Liste von Koordinaten-Objekten
+    // Pro lookupIPs-Aufruf, sobald alle seine IPs beantwortet sind:
+    // Liste von { ip, lat, lon } (nur erfolgreich aufgelöste)
     void lookupFinished(QVariantList coords);
+    // Inkrementell je beantwortetem Chunk:
+    // ip -> { status: "success", lat, lon } | { status: "fail", message }
+    void resultsReady(QVariantMap results);
+    void databaseChanged();
+    void httpFallbackChanged();
 
 private:
+    // Ein lookupIPs-Aufruf, der noch auf IPs im Flug wartet
+    struct Query {
+        QStringList ips;
+        int remaining;
+    };
+
+    struct Failure {
+        qint64 retryAtMs;       // vorher wird die IP nicht erneut angefragt
+        QString message;
+    };
+
+    void loadDatabase();
+    void openTable(const QString &binPath);
+#if !QT_CONFIG(thread)
+    void importSlice(int generation);
+#endif
+    void enqueueChunks(const QStringList &ips);
+    void sendNextChunks();
+    void onChunkFinished(class QNetworkReply *reply, const QStringList &chunk);
+    void finishIp(const QString &ip);
+    void markFailed(const QString &ip, const QString &message, qint64 ttlMs, QVariantMap *batch);
+    void pruneFailures(qint64 now);
+    QVariantList coordsFor(const QStringList &ips) const;
+    static QVariantMap successResult(const LatLon &p);
+
     class QNetworkAccessManager *m_manager;
-    QHash<QString, LatLon> m_cache; // ip -> lat/lon
+    GeoCache *m_cache;              // ip -> lat/lon, persistent
+    QHash<QString, Failure> m_failures;     // höchstens kMaxFailures
+
+    // In-Flight: IP -> wartende Queries; neue Aufrufe hängen sich hier an
+    QHash<QString, QList<int> > m_waiting;
+    QHash<int, Query> m_queries;
+    int m_nextQueryId = 1;
+
+    // ip-api.com/batch nimmt max. 100 IPs pro Request
+    QList<QStringList> m_chunkQueue;
+    int m_activeChunks = 0;
+    bool m_rateLimited = false;
+
+    GeoRangeTable m_table;
+    QString m_databasePath;
+    bool m_httpFallback = true;
+    int m_buildGeneration = 0;      // verwirft veraltete Hintergrund-Builds
+#if !QT_CONFIG(thread)
+    // ohne Threads: CSV-Import in Zeitscheiben, Ziel m_importBin
+    std::unique_ptr<GeoRangeTable::CsvImport> m_import;
+    QString m_importBin;
+#endif
 };
 
 Q_DECLARE_METATYPE(GeoLookup*)
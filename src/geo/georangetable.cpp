@@ -0,0 +1,438 @@
+#include "georangetable.h"
+
+#include <QHostAddress>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const char kMagic[8] = { 'G', 'R', 'N', 'G', 'E', 'O', 0, 1 };
+const quint32 kByteOrder = 0x01020304;
+
+quint64 readBe64(const quint8 *p)
+{
+    quint64 v = 0;
+    for (int i = 0; i < 8; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+// Einfacher CSV-Split mit "..."-Feldern
+QList<QByteArray> splitCsv(const QByteArray &line)
+{
+    QList<QByteArray> out;
+    QByteArray cur;
+    bool inQuotes = false;
+    for (int i = 0; i < line.size(); ++i) {
+        const char c = line.at(i);
+        if (inQuotes) {
+            if (c == '"' && i + 1 < line.size() && line.at(i + 1) == '"') {
+                cur += '"';
+                ++i;
+            } else if (c == '"') {
+                inQuotes = false;
+            } else {
+                cur += c;
+            }
+        } else if (c == '"') {
+            inQuotes = true;
+        } else if (c == ',') {
+            out << cur;
+            cur.clear();
+        } else if (c != '\r' && c != '\n') {
+            cur += c;
+        }
+    }
+    out << cur;
+    return out;
+}
+
+int columnOf(const QList<QByteArray> &header, const char *const *names)
+{
+    for (int i = 0; i < header.size(); ++i) {
+        const QByteArray h = header.at(i).trimmed().toLower();
+        for (const char *const *n = names; *n; ++n) {
+            if (h == *n) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+GeoRangeTable::GeoRangeTable() :
+    m_data(nullptr),
+    m_v4(nullptr),
+    m_v6(nullptr),
+    m_v4Count(0),
+    m_v6Count(0)
+{
+}
+
+GeoRangeTable::~GeoRangeTable()
+{
+    close();
+}
+
+/**
+ * @brief GeoRangeTable::open
+ * Blendet die Binärtabelle per mmap ein (sonst: einmal komplett lesen).
+ */
+bool GeoRangeTable::open(const QString &binPath, QString *error)
+{
+    close();
+
+    m_file.setFileName(binPath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (error) {
+            *error = m_file.errorString();
+        }
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    if (size < qint64(sizeof(Header))) {
+        if (error) {
+            *error = QStringLiteral("GeoIP table truncated");
+        }
+        m_file.close();
+        return false;
+    }
+
+    const uchar *data = m_file.map(0, size);
+    if (!data) {
+        m_buffer = m_file.readAll();
+        data = reinterpret_cast<const uchar *>(m_buffer.constData());
+    }
+
+    Header h;
+    std::memcpy(&h, data, sizeof(Header));
+    const qint64 expected = qint64(sizeof(Header)) + qint64(h.v4Count) * qint64(sizeof(V4Range))
+                            + qint64(h.v6Count) * qint64(sizeof(V6Range));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.byteOrder != kByteOrder
+        || expected != size) {
+        if (error) {
+            *error = QStringLiteral("GeoIP table has an unknown format");
+        }
+        close();
+        return false;
+    }
+
+    m_data = data;
+    m_v4Count = h.v4Count;
+    m_v6Count = h.v6Count;
+    m_v4 = reinterpret_cast<const V4Range *>(data + sizeof(Header));
+    m_v6 = reinterpret_cast<const V6Range *>(data + sizeof(Header) + m_v4Count * sizeof(V4Range));
+    return true;
+}
+
+void GeoRangeTable::close()
+{
+    if (m_file.isOpen()) {
+        if (m_data && m_buffer.isEmpty()) {
+            m_file.unmap(const_cast<uchar *>(m_data));
+        }
+        m_file.close();
+    }
+    m_buffer.clear();
+    m_data = nullptr;
+    m_v4 = nullptr;
+    m_v6 = nullptr;
+    m_v4Count = 0;
+    m_v6Count = 0;
+}
+
+// --- Lookup ----------------------------------------------------------
+
+bool GeoRangeTable::parseKey(const QString &ip, Key *key)
+{
+    QHostAddress addr;
+    if (!addr.setAddress(ip.trimmed())) {
+        return false;
+    }
+
+    bool isV4 = false;
+    const quint32 a4 = addr.toIPv4Address(&isV4);   // auch ::ffff:a.b.c.d
+    if (isV4) {
+        key->v4 = true;
+        key->a4 = a4;
+        key->hi = key->lo = 0;
+        return true;
+    }
+
+    const Q_IPV6ADDR a6 = addr.toIPv6Address();
+    key->v4 = false;
+    key->a4 = 0;
+    key->hi = readBe64(a6.c);
+    key->lo = readBe64(a6.c + 8);
+    return true;
+}
+
+GeoRangeTable::Hit GeoRangeTable::lookup(const QString &ip) const
+{
+    return lookupBatch(QStringList{ ip }).value(0, Hit{ false, 0.0, 0.0 });
+}
+
+QVector<GeoRangeTable::Hit> GeoRangeTable::lookupBatch(const QStringList &ips) const
+{
+    QVector<Hit> out(ips.size(), Hit{ false, 0.0, 0.0 });
+    if (!isOpen()) {
+        return out;
+    }
+
+    QVector<QPair<Key, int> > v4;
+    QVector<QPair<Key, int> > v6;
+    for (int i = 0; i < ips.size(); ++i) {
+        Key k;
+        if (parseKey(ips.at(i), &k)) {
+            (k.v4 ? v4 : v6).append(qMakePair(k, i));
+        }
+    }
+
+    // IPv4: Anfragen sortiert, Suche beginnt jeweils hinter dem letzten Treffer
+    std::sort(v4.begin(), v4.end(), [](const QPair<Key, int> &a, const QPair<Key, int> &b) {
+        return a.first.a4 < b.first.a4;
+    });
+    const V4Range *first4 = m_v4;
+    const V4Range *end4 = m_v4 + m_v4Count;
+    for (const QPair<Key, int> &q : v4) {
+        const quint32 a = q.first.a4;
+        const V4Range *it = std::upper_bound(first4, end4, a, [](quint32 v, const V4Range &r) {
+            return v < r.start;
+        });
+        first4 = it == m_v4 ? it : it - 1;
+        if (it != m_v4 && a <= (it - 1)->end) {
+            out[q.second] = Hit{ true, (it - 1)->lat, (it - 1)->lon };
+        }
+    }
+
+    // IPv6 genauso, Schlüssel (hi, lo)
+    auto less6 = [](quint64 hi1, quint64 lo1, quint64 hi2, quint64 lo2) {
+        return hi1 < hi2 || (hi1 == hi2 && lo1 < lo2);
+    };
+    std::sort(v6.begin(), v6.end(), [&less6](const QPair<Key, int> &a, const QPair<Key, int> &b) {
+        return less6(a.first.hi, a.first.lo, b.first.hi, b.first.lo);
+    });
+    const V6Range *first6 = m_v6;
+    const V6Range *end6 = m_v6 + m_v6Count;
+    for (const QPair<Key, int> &q : v6) {
+        const Key &k = q.first;
+        const V6Range *it = std::upper_bound(first6, end6, k, [&less6](const Key &v, const V6Range &r) {
+            return less6(v.hi, v.lo, r.startHi, r.startLo);
+        });
+        first6 = it == m_v6 ? it : it - 1;
+        if (it != m_v6 && !less6((it - 1)->endHi, (it - 1)->endLo, k.hi, k.lo)) {
+            out[q.second] = Hit{ true, (it - 1)->lat, (it - 1)->lon };
+        }
+    }
+    return out;
+}
+
+// --- Import ----------------------------------------------------------
+
+namespace {
+
+const char *const kNetwork[] = { "network", nullptr };
+const char *const kStart[] = { "ip_start", "start_ip", "range_start", "ip_from", nullptr };
+const char *const kEnd[] = { "ip_end", "end_ip", "range_end", "ip_to", nullptr };
+const char *const kLat[] = { "latitude", "lat", nullptr };
+const char *const kLon[] = { "longitude", "lon", "lng", nullptr };
+
+} // namespace
+
+GeoRangeTable::CsvImport::CsvImport(const QStringList &csvPaths, const QString &binPath) :
+    m_paths(csvPaths),
+    m_binPath(binPath)
+{
+}
+
+/**
+ * @brief GeoRangeTable::buildFromCsv
+ * Liest eine oder mehrere CSV-Dateien, sortiert die Bereiche und schreibt
+ * sie atomar als Binärtabelle. Läuft typischerweise im Worker-Thread.
+ */
+bool GeoRangeTable::buildFromCsv(const QStringList &csvPaths, const QString &binPath, QString *error)
+{
+    CsvImport import(csvPaths, binPath);
+    while (!import.step(std::numeric_limits<int>::max())) {
+    }
+    return import.finish(error);
+}
+
+bool GeoRangeTable::CsvImport::toKey(const QByteArray &field, Key *key)
+{
+    // IP2Location-Stil: IPv4 als Dezimalzahl
+    bool isNumber = false;
+    const qulonglong n = field.toULongLong(&isNumber);
+    if (isNumber && n <= 0xffffffffULL) {
+        key->v4 = true;
+        key->a4 = quint32(n);
+        key->hi = key->lo = 0;
+        return true;
+    }
+    return parseKey(QString::fromLatin1(field), key);
+}
+
+/**
+ * @brief GeoRangeTable::CsvImport::step
+ * Liest höchstens maxLines Zeilen und wechselt dabei bei Bedarf zur nächsten
+ * Datei. true, wenn alle Dateien gelesen sind oder ein Fehler auftrat.
+ */
+bool GeoRangeTable::CsvImport::step(int maxLines)
+{
+    for (int n = 0; n < maxLines; ++n) {
+        if (!m_error.isEmpty()) {
+            return true;
+        }
+        if (!m_file.isOpen() || !m_usable || m_file.atEnd()) {
+            m_file.close();
+            if (m_pathIndex >= m_paths.size()) {
+                return true;
+            }
+            openNext();
+            continue;
+        }
+        readLine(m_file.readLine());
+    }
+    return false;
+}
+
+void GeoRangeTable::CsvImport::openNext()
+{
+    const QString &path = m_paths.at(m_pathIndex++);
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = path + ": " + m_file.errorString();
+        return;
+    }
+    m_colNetwork = -1;
+    m_colStart = 0;
+    m_colEnd = 1;
+    m_colLat = -1;
+    m_colLon = -1;
+    m_first = true;
+    m_usable = true;
+}
+
+void GeoRangeTable::CsvImport::readLine(const QByteArray &line)
+{
+    if (line.trimmed().isEmpty() || line.startsWith('#')) {
+        return;
+    }
+    const QList<QByteArray> fields = splitCsv(line);
+
+    if (m_first) {
+        m_first = false;
+        const QByteArray f0 = fields.value(0).trimmed();
+        Key probe;
+        const bool isData = toKey(f0, &probe)
+                            || !QHostAddress::parseSubnet(QString::fromLatin1(f0)).first.isNull();
+        if (!isData) {
+            // Header-Zeile
+            m_colNetwork = columnOf(fields, kNetwork);
+            m_colStart = columnOf(fields, kStart);
+            m_colEnd = columnOf(fields, kEnd);
+            m_colLat = columnOf(fields, kLat);
+            m_colLon = columnOf(fields, kLon);
+            // z.B. GeoLite2-City-Locations: keine Bereiche -> Datei überspringen
+            m_usable = m_colLat >= 0 && m_colLon >= 0
+                       && (m_colNetwork >= 0 || (m_colStart >= 0 && m_colEnd >= 0));
+            return;
+        }
+    }
+
+    // DB-IP ohne Header: Koordinaten in den letzten beiden Spalten
+    const int lat = m_colLat >= 0 ? m_colLat : fields.size() - 2;
+    const int lon = m_colLon >= 0 ? m_colLon : fields.size() - 1;
+    bool okLat = false, okLon = false;
+    const float la = fields.value(lat).trimmed().toFloat(&okLat);
+    const float lo = fields.value(lon).trimmed().toFloat(&okLon);
+    if (!okLat || !okLon) {
+        return;
+    }
+
+    Key s, e;
+    if (m_colNetwork >= 0) {
+        const QPair<QHostAddress, int> net =
+            QHostAddress::parseSubnet(QString::fromLatin1(fields.value(m_colNetwork).trimmed()));
+        if (net.first.isNull() || !toKey(net.first.toString().toLatin1(), &s)) {
+            return;
+        }
+        e = s;
+        if (s.v4) {
+            const int bits = 32 - (net.second > 32 ? net.second - 96 : net.second);
+            e.a4 = s.a4 | (bits >= 32 ? 0xffffffffu : ((quint32(1) << bits) - 1));
+        } else {
+            const int bits = 128 - net.second;
+            if (bits >= 64) {
+                e.lo = ~quint64(0);
+                e.hi = s.hi | (bits >= 128 ? ~quint64(0) : ((quint64(1) << (bits - 64)) - 1));
+            } else if (bits > 0) {
+                e.lo = s.lo | ((quint64(1) << bits) - 1);
+            }
+        }
+    } else if (!toKey(fields.value(m_colStart).trimmed(), &s)
+               || !toKey(fields.value(m_colEnd).trimmed(), &e)) {
+        return;
+    }
+
+    if (s.v4 && e.v4) {
+        m_v4.append(V4Range{ s.a4, e.a4, la, lo });
+    } else if (!s.v4 && !e.v4) {
+        m_v6.append(V6Range{ s.hi, s.lo, e.hi, e.lo, la, lo });
+    }
+}
+
+/**
+ * @brief GeoRangeTable::CsvImport::finish
+ * Sortiert die eingelesenen Bereiche und schreibt sie atomar als
+ * Binärtabelle nach binPath.
+ */
+bool GeoRangeTable::CsvImport::finish(QString *error)
+{
+    if (!m_error.isEmpty()) {
+        if (error) {
+            *error = m_error;
+        }
+        return false;
+    }
+
+    std::sort(m_v4.begin(), m_v4.end(), [](const V4Range &a, const V4Range &b) {
+        return a.start < b.start;
+    });
+    std::sort(m_v6.begin(), m_v6.end(), [](const V6Range &a, const V6Range &b) {
+        return a.startHi < b.startHi || (a.startHi == b.startHi && a.startLo < b.startLo);
+    });
+
+    Header h;
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.byteOrder = kByteOrder;
+    h.v4Count = quint32(m_v4.size());
+    h.v6Count = quint32(m_v6.size());
+    h.reserved = 0;
+
+    QSaveFile out(m_binPath);
+    if (!out.open(QIODevice::WriteOnly)) {
+        if (error) {
+            *error = out.errorString();
+        }
+        return false;
+    }
+    out.write(reinterpret_cast<const char *>(&h), sizeof(Header));
+    out.write(reinterpret_cast<const char *>(m_v4.constData()), qint64(m_v4.size()) * qint64(sizeof(V4Range)));
+    out.write(reinterpret_cast<const char *>(m_v6.constData()), qint64(m_v6.size()) * qint64(sizeof(V6Range)));
+    if (!out.commit()) {
+        if (error) {
+            *error = out.errorString();
+        }
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,128 @@
+#ifndef GEORANGETABLE_H
+#define GEORANGETABLE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Offline-GeoIP: sortierte IP-Bereiche (IPv4 und IPv6) mit Koordinaten in
+// einer Binärdatei, die per mmap eingeblendet und binär durchsucht wird.
+//
+// Dateiformat (native Byte-Order, bei Abweichung wird neu gebaut):
+//   Header  { magic[8], byteOrder, v4Count, v6Count, reserved }
+//   V4Range[v4Count]  nach start sortiert
+//   V6Range[v6Count]  nach (startHi, startLo) sortiert
+class GeoRangeTable
+{
+public:
+    struct Hit {
+        bool found;
+        double lat;
+        double lon;
+    };
+
+    GeoRangeTable();
+    ~GeoRangeTable();
+
+    bool open(const QString &binPath, QString *error = nullptr);
+    void close();
+    bool isOpen() const
+    {
+        return m_data != nullptr;
+    }
+    int rangeCount() const
+    {
+        return int(m_v4Count + m_v6Count);
+    }
+
+    Hit lookup(const QString &ip) const;
+    // Sortiert die Adressen einmal und läuft dann in einem Durchgang über
+    // die Tabelle; Ergebnis in der Reihenfolge von ips
+    QVector<Hit> lookupBatch(const QStringList &ips) const;
+
+    // CSV (GeoLite2-City-Blocks mit "network"-Spalte, DB-IP ohne Header
+    // "start,end,...,lat,lon" oder Header mit ip_start/ip_end) -> Binärdatei
+    static bool buildFromCsv(const QStringList &csvPaths, const QString &binPath, QString *error = nullptr);
+    // Derselbe Import schrittweise, für Builds ohne Threads
+    class CsvImport;
+
+private:
+    struct Header {
+        char magic[8];
+        quint32 byteOrder;
+        quint32 v4Count;
+        quint32 v6Count;
+        quint32 reserved;
+    };
+
+    struct V4Range {
+        quint32 start;
+        quint32 end;
+        float lat;
+        float lon;
+    };
+
+    struct V6Range {
+        quint64 startHi;
+        quint64 startLo;
+        quint64 endHi;
+        quint64 endLo;
+        float lat;
+        float lon;
+    };
+
+    struct Key {
+        bool v4;
+        quint32 a4;
+        quint64 hi;
+        quint64 lo;
+    };
+
+    static bool parseKey(const QString &ip, Key *key);
+
+    QFile m_file;
+    QByteArray m_buffer;        // Fallback, wenn mmap nicht verfügbar ist
+    const uchar *m_data;
+    const V4Range *m_v4;
+    const V6Range *m_v6;
+    quint32 m_v4Count;
+    quint32 m_v6Count;
+};
+
+// step() liest höchstens maxLines Zeilen und liefert true, sobald alle
+// Dateien gelesen sind; finish() sortiert und schreibt die Binärdatei
+class GeoRangeTable::CsvImport
+{
+public:
+    CsvImport(const QStringList &csvPaths, const QString &binPath);
+
+    bool step(int maxLines);
+    bool finish(QString *error = nullptr);
+
+private:
+    void openNext();
+    void readLine(const QByteArray &line);
+    static bool toKey(const QByteArray &field, Key *key);
+
+    QStringList m_paths;
+    QString m_binPath;
+    int m_pathIndex = 0;
+    QFile m_file;
+    QString m_error;
+
+    // Spalten der aktuellen Datei
+    int m_colNetwork = -1;
+    int m_colStart = 0;
+    int m_colEnd = 1;
+    int m_colLat = -1;
+    int m_colLon = -1;
+    bool m_first = true;
+    bool m_usable = true;
+
+    QVector<V4Range> m_v4;
+    QVector<V6Range> m_v6;
+};
+
+#endif // GEORANGETABLE_H
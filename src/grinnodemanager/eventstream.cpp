@@ -0,0 +1,198 @@
+#include "eventstream.h"
+
+#include <QJsonDocument>
+
+namespace {
+const int kReconnectMs = 250;               // Server hat den Stream regulär beendet
+const int kMinRetryMs = 1000;
+const int kMaxRetryMs = 30000;
+const int kUnavailableRetryMs = 5 * 60 * 1000;
+}
+
+EventStream::EventStream(QNetworkAccessManager *net, QObject *parent) :
+    QObject(parent),
+    m_net(net),
+    m_active(false),
+    m_connected(false),
+    m_headersSeen(false),
+    m_resumed(false),
+    m_sequence(-1),
+    m_retryMs(kMinRetryMs)
+{
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &EventStream::connectStream);
+}
+
+EventStream::~EventStream()
+{
+    abortReply();
+}
+
+void EventStream::start(const RequestFactory &factory)
+{
+    stop();
+
+    m_factory = factory;
+    m_sequence = -1;
+    m_epoch.clear();
+    m_retryMs = kMinRetryMs;
+    m_active = true;
+    connectStream();
+}
+
+void EventStream::stop()
+{
+    m_active = false;
+    m_reconnectTimer.stop();
+    abortReply();
+    setConnected(false);
+}
+
+void EventStream::connectStream()
+{
+    if (!m_active || !m_factory) {
+        return;
+    }
+
+    abortReply();
+    m_parser.reset();
+    m_headersSeen = false;
+    m_resumed = false;
+
+    QNetworkRequest req = m_factory(m_sequence);
+    req.setRawHeader("Accept", "text/event-stream");
+    req.setRawHeader("Cache-Control", "no-cache");
+    if (m_sequence >= 0) {
+        const QByteArray sequence = QByteArray::number(m_sequence);
+        req.setRawHeader("Last-Event-ID", m_epoch.isEmpty() ? sequence : m_epoch.toUtf8() + ':' + sequence);
+    }
+
+    m_reply = m_net->get(req);
+    connect(m_reply.data(), &QNetworkReply::readyRead, this, &EventStream::onReadyRead);
+    connect(m_reply.data(), &QNetworkReply::finished, this, &EventStream::onFinished);
+}
+
+void EventStream::abortReply()
+{
+    if (!m_reply) {
+        return;
+    }
+    QNetworkReply *reply = m_reply.data();
+    m_reply.clear();
+    reply->disconnect(this);
+    reply->abort();
+    reply->deleteLater();
+}
+
+void EventStream::setConnected(bool connected)
+{
+    if (m_connected == connected) {
+        return;
+    }
+    m_connected = connected;
+    emit connectedChanged(connected);
+}
+
+void EventStream::onReadyRead()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    if (!reply || reply != m_reply.data()) {
+        return;
+    }
+    consume(reply);
+}
+
+void EventStream::consume(QNetworkReply *reply)
+{
+    if (!m_headersSeen) {
+        m_headersSeen = true;
+        const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        const QString type = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+        if (statusCode != 200 || !type.startsWith("text/event-stream")) {
+            return;     // onFinished entscheidet
+        }
+        m_retryMs = kMinRetryMs;
+        setConnected(true);
+    }
+    if (!m_connected) {
+        return;
+    }
+
+    const QList<SseParser::Event> events = m_parser.feed(reply->readAll());
+    for (const SseParser::Event &ev : events) {
+        const int colon = ev.id.lastIndexOf(':');
+        const QString epoch = colon >= 0 ? ev.id.left(colon) : QString();
+        bool ok = false;
+        const qint64 id = ev.id.mid(colon + 1).toLongLong(&ok);
+        if (ok) {
+            const bool first = !m_resumed;
+            m_resumed = true;
+            if (m_sequence >= 0 && epoch != m_epoch) {
+                // Andere Epoche: Controller wurde neu gestartet, seine
+                // Nummern haben mit unseren nichts zu tun. Zustand neu holen
+                // und ab seiner Nummer weiterlesen
+                m_epoch = epoch;
+                m_sequence = id;
+                emit resetRequired();
+                continue;
+            }
+            if (m_sequence >= 0 && id <= m_sequence && ev.event != "reset") {
+                // Ohne Epoche: erstes Event einer neuen Verbindung liegt nicht
+                // hinter Last-Event-ID, der Controller zählt also von vorn
+                if (first && epoch.isEmpty()) {
+                    m_sequence = id;
+                    emit resetRequired();
+                }
+                // sonst Duplikat nach einem Reconnect
+                continue;
+            }
+            m_epoch = epoch;
+            m_sequence = id;
+        }
+
+        if (ev.event == "reset") {
+            emit resetRequired();
+            continue;
+        }
+        const QJsonObject payload = QJsonDocument::fromJson(ev.data).object();
+        emit eventReceived(ev.event, payload, m_sequence);
+    }
+}
+
+void EventStream::onFinished()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    if (!reply || reply != m_reply.data()) {
+        return;
+    }
+    // Rest lesen; unter WASM (Long-Poll) kommt alles erst hier an
+    consume(reply);
+    m_reply.clear();
+    reply->deleteLater();
+
+    if (!m_active) {
+        return;
+    }
+
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const QString type = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+
+    // Controller ohne Events: Polling bleibt, später erneut versuchen
+    if (statusCode == 404 || statusCode == 405 || statusCode == 501
+        || (statusCode == 200 && !type.startsWith("text/event-stream"))) {
+        setConnected(false);
+        emit unavailable();
+        m_reconnectTimer.start(kUnavailableRetryMs);
+        return;
+    }
+
+    if (reply->error() != QNetworkReply::NoError || statusCode != 200) {
+        setConnected(false);
+        m_reconnectTimer.start(m_retryMs);
+        m_retryMs = qMin(m_retryMs * 2, kMaxRetryMs);
+        return;
+    }
+
+    // Regulär beendet (Idle-Timeout, Proxy, Long-Poll unter WASM): ab Sequenz weiter
+    m_reconnectTimer.start(kReconnectMs);
+}
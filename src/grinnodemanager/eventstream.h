@@ -0,0 +1,81 @@
+#ifndef EVENTSTREAM_H
+#define EVENTSTREAM_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QPointer>
+#include <QTimer>
+
+#include <functional>
+
+#include "sseparser.h"
+
+// Abo auf die Push-Events des Controllers (/events) als SSE.
+// Jedes Event trägt als id "<epoche>:<sequenz>" und als data ein
+// JSON-Objekt; event ist der Typ (status, tip, peer, pool, ...). Die Epoche
+// vergibt der Controller bei jedem Start neu, die Sequenz zählt innerhalb
+// einer Epoche fortlaufend.
+// Bricht die Verbindung ab, wird ab der letzten gesehenen id fortgesetzt
+// (Last-Event-ID bzw. since=). Kann der Server nicht mehr so weit zurück,
+// schickt er "reset" -> resetRequired(), der Client holt seinen Zustand dann
+// einmal komplett neu. Dasselbe gilt, sobald sich die Epoche ändert
+// (Controller neu gestartet). Controller ohne Epoche senden nur die Sequenz;
+// dort gilt ein Neustart als erkannt, wenn das erste Event einer neuen
+// Verbindung nicht hinter der letzten Sequenz liegt.
+// Kennt der Controller /events nicht (404 bzw. kein event-stream), kommt
+// unavailable() und erst nach kUnavailableRetryMs ein neuer Versuch; bis
+// dahin gilt Polling.
+class EventStream : public QObject
+{
+    Q_OBJECT
+public:
+    // Baut den Request ab Sequenznummer since (-1 = nur neue Events)
+    typedef std::function<QNetworkRequest (qint64 since)> RequestFactory;
+
+    explicit EventStream(QNetworkAccessManager *net, QObject *parent = nullptr);
+    ~EventStream() override;
+
+    void start(const RequestFactory &factory);
+    void stop();
+
+    bool isActive() const { return m_active; }
+    // Stream steht (auch während eines kurzen regulären Reconnects)
+    bool isConnected() const { return m_connected; }
+    qint64 sequence() const { return m_sequence; }
+
+signals:
+    void eventReceived(const QString &type, const QJsonObject &payload, qint64 sequence);
+    void resetRequired();
+    void connectedChanged(bool connected);
+    void unavailable();
+
+private slots:
+    void onReadyRead();
+    void onFinished();
+
+private:
+    void connectStream();
+    void abortReply();
+    void consume(QNetworkReply *reply);
+    void setConnected(bool connected);
+
+    QNetworkAccessManager *m_net;
+    RequestFactory m_factory;
+    QPointer<QNetworkReply> m_reply;
+    SseParser m_parser;
+
+    bool m_active;
+    bool m_connected;
+    bool m_headersSeen;
+    bool m_resumed;         // auf dieser Verbindung schon ein Event mit id
+    qint64 m_sequence;
+    QString m_epoch;        // leer bei Controllern ohne Epoche
+
+    QTimer m_reconnectTimer;
+    int m_retryMs;
+};
+
+#endif // EVENTSTREAM_H
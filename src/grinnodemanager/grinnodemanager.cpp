@@ -2,6 +2,15 @@
 #include <QJsonDocument>
 #include <QJsonParseError>
 
+namespace {
+const int kMinPollMs = 1000;
+const int kFastPollMs = 2000;       // solange ein Node startet oder synchronisiert
+const int kMaxBackoffFactor = 6;    // Obergrenze: Basisintervall * 6
+const qint64 kStartingWindowMs = 120000; // danach gilt ein Start als abgeschlossen/gescheitert
+const int kEventsSafetyFactor = 6;  // bei stehendem Event-Stream: Status nur noch zur Absicherung
+const char kStatusPath[] = "status";
+}
+
 static inline QString safePretty(const QByteArray &data)
 {
     QJsonParseError err{};
@@ -21,8 +30,12 @@ void GrinNodeManager::initNetwork()
     connect(m_net, &QNetworkAccessManager::finished,
             this, &GrinNodeManager::onReplyFinished);
 
-    m_statusTimer.setSingleShot(false);
+    // Single-Shot: der naechste Poll wird erst nach der Antwort geplant,
+    // damit sich bei langsamem Controller keine Requests stapeln.
+    m_statusTimer.setSingleShot(true);
     connect(&m_statusTimer, &QTimer::timeout, this, &GrinNodeManager::getStatus);
+
+    m_clock.start();
 }
 
 // Default-Ctor für QML
@@ -84,6 +97,16 @@ void GrinNodeManager::getLogsGrinPP(int n)
     getLogs(NodeKind::GrinPP, n);
 }
 
+void GrinNodeManager::tailLogsRust(qint64 cursor, int n)
+{
+    tailLogs(NodeKind::Rust, cursor, n);
+}
+
+void GrinNodeManager::tailLogsGrinPP(qint64 cursor, int n)
+{
+    tailLogs(NodeKind::GrinPP, cursor, n);
+}
+
 // NEU: Delete-Wrapper für QML
 void GrinNodeManager::deleteRustChain()
 {
@@ -98,27 +121,88 @@ void GrinNodeManager::deleteGrinppChain()
 // ---------- Public API ----------
 void GrinNodeManager::getStatus()
 {
-    QNetworkRequest req = makeRequest("status");
-    m_net->get(req);
+    // Laeuft bereits ein /status, teilen sich alle Aufrufer dessen Antwort
+    sendGet(Endpoint::Status, NodeKind::Rust, kStatusPath,
+            [this](const QByteArray &payload) { handleStatusReply(payload); });
+}
+
+QString GrinNodeManager::lastResponse() const
+{
+    if (m_lastResponseDirty) {
+        m_lastResponse = safePretty(m_lastPayload);
+        m_lastResponseDirty = false;
+    }
+    return m_lastResponse;
 }
 
 // Polling
 void GrinNodeManager::startStatusPolling(int intervalMs)
 {
-    if (intervalMs < 1000) {
-        intervalMs = 1000;
+    if (intervalMs < kMinPollMs) {
+        intervalMs = kMinPollMs;
+    }
+
+    // Mehrfacher Start mit gleichem Intervall (z.B. Home.qml) aendert nichts
+    if (m_pollBaseMs == intervalMs) {
+        return;
+    }
+
+    m_pollBaseMs = intervalMs;
+    m_pollCurrentMs = intervalMs;
+    emit pollingChanged();
+
+    if (!m_inFlight.contains(kStatusPath)) {
+        m_statusTimer.start(m_pollCurrentMs);
     }
-    m_statusTimer.start(intervalMs);
 }
 
 void GrinNodeManager::stopStatusPolling()
 {
     m_statusTimer.stop();
+    if (m_pollBaseMs != 0) {
+        m_pollBaseMs = 0;
+        m_pollCurrentMs = 0;
+        emit pollingChanged();
+    }
+}
+
+void GrinNodeManager::setNodeSyncing(bool syncing)
+{
+    if (m_nodeSyncing == syncing) {
+        return;
+    }
+    m_nodeSyncing = syncing;
+    emit pollingChanged();
+
+    // Beim Wechsel in den Sync-Modus nicht das (evtl. zurueckgefahrene) Intervall abwarten
+    if (syncing && m_pollBaseMs > 0 && m_statusTimer.isActive()
+        && m_statusTimer.remainingTime() > kFastPollMs) {
+        m_statusTimer.start(kFastPollMs);
+    }
+}
+
+QVariantMap GrinNodeManager::endpointTimings() const
+{
+    QVariantMap out;
+    for (auto it = m_stats.constBegin(); it != m_stats.constEnd(); ++it) {
+        const EndpointStats &s = it.value();
+        QVariantMap m;
+        m["requests"] = s.requests;
+        m["errors"] = s.errors;
+        m["coalesced"] = s.coalesced;
+        m["lastMs"] = s.lastMs;
+        m["maxMs"] = s.maxMs;
+        m["avgMs"] = s.requests > 0 ? double(s.totalMs) / s.requests : 0.0;
+        out.insert(endpointName(it.key()), m);
+    }
+    return out;
 }
 
 // ---------- Core helpers ----------
 void GrinNodeManager::start(NodeKind kind, const QStringList &args)
 {
+    setStarting(kind, true);
+
     QNetworkRequest req = makeRequest("start/" + kindToPath(kind));
     req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
@@ -127,17 +211,21 @@ void GrinNodeManager::start(NodeKind kind, const QStringList &args)
         json["args"] = QJsonArray::fromStringList(args);
     }
 
-    m_net->post(req, QJsonDocument(json).toJson());
+    sendPost(Endpoint::Start, kind, req, QJsonDocument(json).toJson(),
+             [this, kind](const QByteArray &) { emit nodeStarted(kind); });
 }
 
 void GrinNodeManager::stop(NodeKind kind)
 {
     QNetworkRequest req = makeRequest("stop/" + kindToPath(kind));
-    m_net->post(req, QByteArray());
+    sendPost(Endpoint::Stop, kind, req, QByteArray(),
+             [this, kind](const QByteArray &) { emit nodeStopped(kind); });
 }
 
 void GrinNodeManager::restart(NodeKind kind, const QStringList &args)
 {
+    setStarting(kind, true);
+
     QNetworkRequest req = makeRequest("restart/" + kindToPath(kind));
     req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
 
@@ -146,16 +234,143 @@ void GrinNodeManager::restart(NodeKind kind, const QStringList &args)
         json["args"] = QJsonArray::fromStringList(args);
     }
 
-    m_net->post(req, QJsonDocument(json).toJson());
+    sendPost(Endpoint::Restart, kind, req, QJsonDocument(json).toJson(),
+             [this, kind](const QByteArray &) { emit nodeRestarted(kind); });
 }
 
 void GrinNodeManager::getLogs(NodeKind kind, int n)
 {
     // Query-String direkt an den relativen Pfad hängen
-    QNetworkRequest req = makeRequest(QString("logs/%1?n=%2")
-                                          .arg(kindToPath(kind))
-                                          .arg(n));
-    m_net->get(req);
+    sendGet(Endpoint::Logs, kind, QString("logs/%1?n=%2").arg(kindToPath(kind)).arg(n),
+            [this](const QByteArray &payload) { emit logsReceived(QString::fromUtf8(payload)); });
+}
+
+// Streaming-Tail: /logs/<kind>/tail?cursor=<byte-offset>&n=<zeilen>
+// cursor < 0 startet mit den letzten n Zeilen, danach nur noch neue Zeilen.
+void GrinNodeManager::tailLogs(NodeKind kind, qint64 cursor, int n)
+{
+    if (!m_logTail) {
+        m_logTail = new LogTailStream(m_net, this);
+        connect(m_logTail, &LogTailStream::linesAppended, this,
+                [this](const QStringList &lines, qint64 cursor) {
+            emit logLinesAppended(m_logTailKind, lines, cursor);
+        });
+        connect(m_logTail, &LogTailStream::streamError, this, &GrinNodeManager::errorOccurred);
+        connect(m_logTail, &LogTailStream::stopped, this, &GrinNodeManager::logTailChanged);
+    }
+
+    m_logTailKind = kind;
+    const QString kindPath = kindToPath(kind);
+    m_logTail->start([this, kindPath, n](qint64 c) {
+        QString path = QString("logs/%1/tail?cursor=%2&n=%3").arg(kindPath).arg(c).arg(n);
+#ifdef Q_OS_WASM
+        // fetch() liefert erst nach Abschluss aus: Long-Poll statt offenem Stream
+        path += "&follow=0";
+#endif
+        return makeRequest(path);
+    }, cursor);
+    emit logTailChanged();
+}
+
+void GrinNodeManager::stopLogTail()
+{
+    if (!m_logTail || !m_logTail->isActive()) {
+        return;
+    }
+    m_logTail->stop();
+    emit logTailChanged();
+}
+
+bool GrinNodeManager::logTailActive() const
+{
+    return m_logTail && m_logTail->isActive();
+}
+
+qint64 GrinNodeManager::logTailCursor() const
+{
+    return m_logTail ? m_logTail->cursor() : -1;
+}
+
+// ---------- Events ----------
+
+// /events?since=<sequenz>: SSE mit status, tip, peer und pool.
+// Log-Zeilen bleiben auf ihrem eigenen Stream (tailLogs), sonst liefe jede
+// Zeile auch bei Clients ohne offene Log-Ansicht mit.
+void GrinNodeManager::startEvents()
+{
+    if (!m_events) {
+        m_events = new EventStream(m_net, this);
+        connect(m_events, &EventStream::eventReceived, this,
+                [this](const QString &type, const QJsonObject &payload, qint64) {
+            handleEvent(type, payload);
+        });
+        connect(m_events, &EventStream::connectedChanged, this, &GrinNodeManager::onEventsConnectedChanged);
+        connect(m_events, &EventStream::resetRequired, this, [this]() {
+            getStatus();
+            emit eventsResynced();
+        });
+    } else if (m_events->isActive()) {
+        return;
+    }
+
+    m_events->start([this](qint64 since) {
+        QString path = "events";
+        if (since >= 0) {
+            path += QString("?since=%1").arg(since);
+        }
+#ifdef Q_OS_WASM
+        // wie beim Log-Tail: Long-Poll statt offenem Stream
+        path += since >= 0 ? "&follow=0" : "?follow=0";
+#endif
+        return makeRequest(path);
+    });
+}
+
+void GrinNodeManager::stopEvents()
+{
+    if (m_events) {
+        m_events->stop();
+    }
+}
+
+bool GrinNodeManager::eventsConnected() const
+{
+    return m_events && m_events->isConnected();
+}
+
+void GrinNodeManager::handleEvent(const QString &type, const QJsonObject &payload)
+{
+    if (type == "status") {
+        const QByteArray raw = QJsonDocument(payload).toJson(QJsonDocument::Compact);
+        updateStartingState(payload);
+        m_lastStatusHash = qHash(raw);
+        m_hasLastStatus = true;
+        emit statusReceived(payload);
+        setLastPayload(raw);
+    } else if (type == "tip") {
+        emit tipChanged(payload);
+    } else if (type == "peer") {
+        emit peerChanged(payload);
+    } else if (type == "pool") {
+        emit poolChanged(payload);
+    }
+}
+
+// Verbunden: Status-Timer auf Absicherungstakt; getrennt: sofort nachholen,
+// ab dann wieder normales Polling
+void GrinNodeManager::onEventsConnectedChanged(bool connected)
+{
+    emit eventsChanged();
+    if (m_pollBaseMs <= 0) {
+        return;
+    }
+    if (connected) {
+        if (m_statusTimer.isActive()) {
+            m_statusTimer.start(m_pollBaseMs * kEventsSafetyFactor);
+        }
+    } else if (!m_inFlight.contains(kStatusPath)) {
+        m_statusTimer.start(0);
+    }
 }
 
 // NEU: /delete/<kind>
@@ -164,7 +379,184 @@ void GrinNodeManager::deleteChain(NodeKind kind)
     QNetworkRequest req = makeRequest("delete/" + kindToPath(kind));
 
     // analog zu start/stop/restart als POST
-    m_net->post(req, QByteArray());
+    sendPost(Endpoint::Delete, kind, req, QByteArray(),
+             [this, kind](const QByteArray &) { emit chainDeleted(kind); });
+}
+
+// ---------- Request-Registry ----------
+
+// Startet einen GET, sofern fuer denselben Pfad (inkl. Query) nicht schon einer
+// unterwegs ist; logs?n=100 und logs?n=500 bleiben getrennte Requests.
+// Gibt false zurueck, wenn der Aufruf an den laufenden Request angehaengt wurde.
+bool GrinNodeManager::sendGet(Endpoint endpoint, NodeKind kind, const QString &path,
+                              const ReplyCallback &onSuccess)
+{
+    if (m_inFlight.contains(path)) {
+        m_stats[flightKey(endpoint, kind)].coalesced++;
+        return false;
+    }
+
+    QNetworkReply *reply = m_net->get(makeRequest(path));
+    registerReply(reply, endpoint, kind, onSuccess);
+    m_requests[reply].path = path;
+    m_inFlight.insert(path, reply);
+    return true;
+}
+
+// POST-Aktionen werden nie zusammengefasst
+void GrinNodeManager::sendPost(Endpoint endpoint, NodeKind kind, const QNetworkRequest &req,
+                               const QByteArray &body, const ReplyCallback &onSuccess)
+{
+    registerReply(m_net->post(req, body), endpoint, kind, onSuccess);
+}
+
+void GrinNodeManager::registerReply(QNetworkReply *reply, Endpoint endpoint, NodeKind kind,
+                                    const ReplyCallback &onSuccess)
+{
+    RequestInfo info;
+    info.endpoint = endpoint;
+    info.kind = kind;
+    info.onSuccess = onSuccess;
+    info.issuedAt = m_clock.elapsed();
+    m_requests.insert(reply, info);
+}
+
+int GrinNodeManager::flightKey(Endpoint endpoint, NodeKind kind)
+{
+    return static_cast<int>(endpoint) * 2 + static_cast<int>(kind);
+}
+
+// flightKey -> "status", "logs/rust", "start/grinpp", ...
+QString GrinNodeManager::endpointName(int key) const
+{
+    const Endpoint endpoint = static_cast<Endpoint>(key / 2);
+    const NodeKind kind = static_cast<NodeKind>(key % 2);
+
+    switch (endpoint) {
+    case Endpoint::Status:
+        return "status";
+    case Endpoint::Logs:
+        return "logs/" + kindToPath(kind);
+    case Endpoint::Start:
+        return "start/" + kindToPath(kind);
+    case Endpoint::Stop:
+        return "stop/" + kindToPath(kind);
+    case Endpoint::Restart:
+        return "restart/" + kindToPath(kind);
+    case Endpoint::Delete:
+        return "delete/" + kindToPath(kind);
+    }
+    return QString();
+}
+
+void GrinNodeManager::recordTiming(const RequestInfo &info, bool ok)
+{
+    const qint64 ms = m_clock.elapsed() - info.issuedAt;
+    EndpointStats &s = m_stats[flightKey(info.endpoint, info.kind)];
+    s.requests++;
+    if (!ok) {
+        s.errors++;
+    }
+    s.lastMs = ms;
+    s.totalMs += ms;
+    s.maxMs = qMax(s.maxMs, ms);
+    emit endpointTimingsChanged();
+}
+
+void GrinNodeManager::handleStatusReply(const QByteArray &payload)
+{
+    const QJsonObject status = QJsonDocument::fromJson(payload).object();
+    updateStartingState(status);
+    scheduleNextStatusPoll(true, payload);
+    emit statusReceived(status);
+}
+
+// lastResponse wird nur markiert; safePretty laeuft erst beim Lesen
+void GrinNodeManager::setLastPayload(const QByteArray &payload)
+{
+    if (payload == m_lastPayload) {
+        return;
+    }
+    m_lastPayload = payload;
+    m_lastResponseDirty = true;
+    emit lastResponseChanged();
+}
+
+// ---------- Status-Polling ----------
+
+// Plant den naechsten Status-Poll:
+// - Event-Stream steht -> nur Absicherung, Aenderungen kommen per Push
+// - Node startet/synchronisiert -> schnell
+// - Fehler oder unveraenderte Antwort -> Intervall schrittweise verlaengern
+// - sonst -> Basisintervall
+void GrinNodeManager::scheduleNextStatusPoll(bool ok, const QByteArray &payload)
+{
+    const size_t hash = qHash(payload);
+    const bool changed = ok && (!m_hasLastStatus || hash != m_lastStatusHash);
+    if (ok) {
+        m_lastStatusHash = hash;
+        m_hasLastStatus = true;
+    }
+
+    if (m_startingMask != 0 && m_clock.elapsed() - m_startingSinceMs > kStartingWindowMs) {
+        m_startingMask = 0;
+    }
+
+    if (m_pollBaseMs <= 0) {
+        return;
+    }
+
+    int next = m_pollBaseMs;
+    if (eventsConnected()) {
+        next = m_pollBaseMs * kEventsSafetyFactor;
+    } else if (m_nodeSyncing || m_startingMask != 0) {
+        next = qMin(m_pollBaseMs, kFastPollMs);
+    } else if (!changed) {
+        next = qMin(m_pollCurrentMs + m_pollCurrentMs / 2,
+                    m_pollBaseMs * kMaxBackoffFactor);
+        next = qMax(next, m_pollBaseMs);
+    }
+
+    if (next != m_pollCurrentMs) {
+        m_pollCurrentMs = next;
+        emit pollingChanged();
+    }
+    m_statusTimer.start(m_pollCurrentMs);
+}
+
+void GrinNodeManager::updateStartingState(const QJsonObject &status)
+{
+    if (m_startingMask == 0) {
+        return;
+    }
+
+    const QJsonObject nodes = status.contains("nodes") ? status.value("nodes").toObject() : status;
+    const NodeKind kinds[] = { NodeKind::Rust, NodeKind::GrinPP };
+    for (NodeKind kind : kinds) {
+        const QJsonValue running = nodes.value(kindToPath(kind)).toObject().value("running");
+        if (running.toBool() || running.toString() == "true") {
+            setStarting(kind, false);
+        }
+    }
+}
+
+void GrinNodeManager::setStarting(NodeKind kind, bool starting)
+{
+    const int bit = 1 << static_cast<int>(kind);
+    const int mask = starting ? (m_startingMask | bit) : (m_startingMask & ~bit);
+    if (mask == m_startingMask) {
+        return;
+    }
+    m_startingMask = mask;
+    if (starting) {
+        m_startingSinceMs = m_clock.elapsed();
+    }
+
+    // Nach Start/Restart sofort in den schnellen Takt wechseln
+    if (starting && m_pollBaseMs > 0
+        && !m_inFlight.contains(kStatusPath)) {
+        m_statusTimer.start(qMin(m_pollBaseMs, kFastPollMs));
+    }
 }
 
 // ---------- Utils ----------
@@ -173,9 +565,6 @@ void GrinNodeManager::deleteChain(NodeKind kind)
 // eine echte URL zu bauen (ohne den Basis-Pfad zu überschreiben)
 QNetworkRequest GrinNodeManager::makeRequest(const QString &path) const
 {
-    // <-- Speichere den ORIGINAL-Pfad, unverändert
-    QString apiPath = path;
-
     QString rel = path;
     if (rel.startsWith('/'))
         rel.remove(0, 1);
@@ -192,9 +581,6 @@ QNetworkRequest GrinNodeManager::makeRequest(const QString &path) const
 
     QNetworkRequest req(url);
 
-    // EXAKT diesen relativen Pfad speichern – das ist unser Routing-Key
-    req.setAttribute(QNetworkRequest::User, apiPath);
-
     req.setRawHeader("User-Agent", m_opts.userAgent);
     if (!m_opts.username.isEmpty())
         req.setRawHeader("Authorization", basicAuthHeader());
@@ -235,58 +621,56 @@ void GrinNodeManager::setBaseUrl(const QUrl &u)
         return;
     }
 
+    // Offene Requests gehoeren zur alten URL und duerfen neue nicht blockieren
+    m_inFlight.clear();
+    m_hasLastStatus = false;
+
     m_baseUrl = fixed;
     emit baseUrlChanged();
+
+    // Sequenznummern gelten nur für den alten Controller
+    if (m_events && m_events->isActive()) {
+        m_events->stop();
+        startEvents();
+    }
 }
 
 // ---------- Reply dispatch ----------
 void GrinNodeManager::onReplyFinished(QNetworkReply *reply)
 {
-    int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
-
-    // Unser eigener „API-Pfad“
-    QString apiPath = reply->request().attribute(QNetworkRequest::User).toString();
-
+    // Routing ausschliesslich ueber den registrierten Deskriptor.
+    // Nicht registrierte Replies (z.B. Log-Tail-Stream) verwaltet ihr Besitzer selbst.
+    auto it = m_requests.find(reply);
+    if (it == m_requests.end()) {
+        return;
+    }
+    const RequestInfo info = it.value();
+    m_requests.erase(it);
+    reply->deleteLater();
 
-    // Fallback (nur für Debug), falls aus irgendeinem Grund leer:
-    if (apiPath.isEmpty()) {
-        apiPath = reply->url().path();
+    if (!info.path.isEmpty() && m_inFlight.value(info.path) == reply) {
+        m_inFlight.remove(info.path);
     }
 
-    const QByteArray payload = reply->readAll();
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const bool ok = (statusCode == 200);
+    recordTiming(info, ok);
 
-    auto finish = [&] {
-        const QString pretty = safePretty(payload);
-        if (pretty != m_lastResponse) {
-            m_lastResponse = pretty;
-            emit lastResponseChanged();
-        }
-    };
+    const QByteArray payload = reply->readAll();
 
-    if (statusCode != 200) {
+    if (!ok) {
         emit errorOccurred(QString("[%1] %2")
                                .arg(reply->url().toString(), reply->errorString()));
-        finish();
-        reply->deleteLater();
+        if (info.endpoint == Endpoint::Status) {
+            scheduleNextStatusPoll(false, payload);
+        }
+        setLastPayload(payload);
         return;
     }
 
-    // Routing nur noch über apiPath
-    if (apiPath.contains("status")) {
-        const auto doc = QJsonDocument::fromJson(payload);
-        emit statusReceived(doc.object());
-    } else if (apiPath.contains("logs/")) {
-        emit logsReceived(QString::fromUtf8(payload));
-    } else if (apiPath.contains("start/")) {
-        emit nodeStarted(apiPath.contains("rust") ? NodeKind::Rust : NodeKind::GrinPP);
-    } else if (apiPath.contains("stop/")) {
-        emit nodeStopped(apiPath.contains("rust") ? NodeKind::Rust : NodeKind::GrinPP);
-    } else if (apiPath.contains("restart/")) {
-        emit nodeRestarted(apiPath.contains("rust") ? NodeKind::Rust : NodeKind::GrinPP);
-    } else if (apiPath.contains("delete/")) {
-        emit chainDeleted(apiPath.contains("rust") ? NodeKind::Rust : NodeKind::GrinPP);
+    if (info.onSuccess) {
+        info.onSuccess(payload);
     }
 
-    finish();
-    reply->deleteLater();
+    setLastPayload(payload);
 }
@@ -10,8 +10,16 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QVariantMap>
 #include <QDebug>
 
+#include <functional>
+
+#include "eventstream.h"
+#include "logtailstream.h"
+
 class GrinNodeManager : public QObject
 {
     Q_OBJECT
@@ -22,6 +30,15 @@ class GrinNodeManager : public QObject
     Q_PROPERTY(QString password READ password WRITE setPassword NOTIFY optionsChanged)
     Q_PROPERTY(int timeoutMs READ timeoutMs WRITE setTimeoutMs NOTIFY optionsChanged)
     Q_PROPERTY(QString userAgent READ userAgent WRITE setUserAgent NOTIFY optionsChanged)
+    // Adaptives Status-Polling
+    Q_PROPERTY(bool nodeSyncing READ nodeSyncing WRITE setNodeSyncing NOTIFY pollingChanged)
+    Q_PROPERTY(int statusPollIntervalMs READ statusPollIntervalMs NOTIFY pollingChanged)
+    Q_PROPERTY(QVariantMap endpointTimings READ endpointTimings NOTIFY endpointTimingsChanged)
+    // Streaming-Log-Tail
+    Q_PROPERTY(bool logTailActive READ logTailActive NOTIFY logTailChanged)
+    Q_PROPERTY(qint64 logTailCursor READ logTailCursor NOTIFY logTailChanged)
+    // Push-Events vom Controller (/events); solange verbunden ruht das Polling
+    Q_PROPERTY(bool eventsConnected READ eventsConnected NOTIFY eventsChanged)
 public:
     enum class NodeKind {
         Rust, GrinPP
@@ -60,6 +77,15 @@ public:
     Q_INVOKABLE void restartGrinPP(const QStringList &args = {});
     Q_INVOKABLE void getLogsGrinPP(int n = 100);
 
+    // Streaming-Tail: liefert nur neue Zeilen ab cursor (Byte-Offset) über logLinesAppended
+    Q_INVOKABLE void tailLogsRust(qint64 cursor = -1, int n = 100);
+    Q_INVOKABLE void tailLogsGrinPP(qint64 cursor = -1, int n = 100);
+    Q_INVOKABLE void stopLogTail();
+
+    // Event-Abo: status/tip/peer/pool als Signale, Polling nur als Rückfall
+    Q_INVOKABLE void startEvents();
+    Q_INVOKABLE void stopEvents();
+
     // NEU: Chain-Delete-Endpunkte
     Q_INVOKABLE void deleteRustChain();
     Q_INVOKABLE void deleteGrinppChain();
@@ -71,7 +97,8 @@ public:
     QUrl baseUrl() const { return m_baseUrl; }
     void setBaseUrl(const QUrl &u);
 
-    QString lastResponse() const { return m_lastResponse; }
+    // wird erst beim Lesen aus dem letzten Payload aufbereitet
+    QString lastResponse() const;
 
     // Options als Properties
     QString username() const { return m_opts.username; }
@@ -86,9 +113,32 @@ public:
     QString userAgent() const { return QString::fromUtf8(m_opts.userAgent); }
     void setUserAgent(const QString &ua) { m_opts.userAgent = ua.toUtf8(); emit optionsChanged(); }
 
+    // Polling-Zustand
+    bool nodeSyncing() const { return m_nodeSyncing; }
+    void setNodeSyncing(bool syncing);
+
+    int statusPollIntervalMs() const { return m_pollCurrentMs; }
+
+    // endpoint -> { requests, errors, coalesced, lastMs, avgMs, maxMs }
+    QVariantMap endpointTimings() const;
+
+    bool logTailActive() const;
+    qint64 logTailCursor() const;
+
+    bool eventsConnected() const;
+
 signals:
     void statusReceived(const QJsonObject &json);
     void logsReceived(const QString &logs);
+    void logLinesAppended(GrinNodeManager::NodeKind kind, const QStringList &lines, qint64 cursor);
+    void logTailChanged();
+    // Push-Events; payload wie vom Controller geliefert
+    void tipChanged(const QJsonObject &tip);
+    void peerChanged(const QJsonObject &peer);
+    void poolChanged(const QJsonObject &pool);
+    // Events gingen verloren (Server konnte nicht fortsetzen): Zustand neu holen
+    void eventsResynced();
+    void eventsChanged();
     void nodeStarted(GrinNodeManager::NodeKind kind);
     void nodeStopped(GrinNodeManager::NodeKind kind);
     void nodeRestarted(GrinNodeManager::NodeKind kind);
@@ -96,6 +146,8 @@ signals:
     void baseUrlChanged();
     void optionsChanged();
     void errorOccurred(const QString &message);
+    void pollingChanged();
+    void endpointTimingsChanged();
 
     void chainDeleted(GrinNodeManager::NodeKind kind);
 
@@ -103,6 +155,46 @@ private slots:
     void onReplyFinished(QNetworkReply *reply);
 
 private:
+    // Controller-Endpunkte; ersetzt das Routing über Pfad-Strings
+    enum class Endpoint {
+        Status, Logs, Start, Stop, Restart, Delete
+    };
+
+    typedef std::function<void (const QByteArray &payload)> ReplyCallback;
+
+    // Deskriptor je offenem Request (Key: QNetworkReply*)
+    struct RequestInfo {
+        Endpoint endpoint;
+        NodeKind kind;          // bei Status ohne Bedeutung
+        QString path;           // nur bei GET: Schluessel in m_inFlight
+        ReplyCallback onSuccess;
+        qint64 issuedAt;
+        RequestInfo()
+            : endpoint(Endpoint::Status),
+            kind(NodeKind::Rust),
+            issuedAt(0)
+        {
+        }
+    };
+
+    struct EndpointStats {
+        int requests;
+        int errors;
+        int coalesced;
+        qint64 lastMs;
+        qint64 maxMs;
+        qint64 totalMs;
+        EndpointStats()
+            : requests(0),
+            errors(0),
+            coalesced(0),
+            lastMs(0),
+            maxMs(0),
+            totalMs(0)
+        {
+        }
+    };
+
     // Hilfsinit, von beiden Ctors aufgerufen
     void initNetwork();
 
@@ -110,6 +202,7 @@ private:
     void stop(NodeKind kind);
     void restart(NodeKind kind, const QStringList &args);
     void getLogs(NodeKind kind, int n);
+    void tailLogs(NodeKind kind, qint64 cursor, int n);
 
     void deleteChain(NodeKind kind);
 
@@ -117,11 +210,49 @@ private:
     QByteArray basicAuthHeader() const;
     QString kindToPath(NodeKind kind) const;
 
+    // Single-Flight: hoechstens ein offener GET pro Pfad (inkl. Query)
+    bool sendGet(Endpoint endpoint, NodeKind kind, const QString &path, const ReplyCallback &onSuccess);
+    void sendPost(Endpoint endpoint, NodeKind kind, const QNetworkRequest &req, const QByteArray &body,
+                  const ReplyCallback &onSuccess);
+    void registerReply(QNetworkReply *reply, Endpoint endpoint, NodeKind kind, const ReplyCallback &onSuccess);
+    static int flightKey(Endpoint endpoint, NodeKind kind);
+    QString endpointName(int flightKey) const;
+    void recordTiming(const RequestInfo &info, bool ok);
+
+    void handleStatusReply(const QByteArray &payload);
+    void scheduleNextStatusPoll(bool ok, const QByteArray &payload);
+    void updateStartingState(const QJsonObject &status);
+    void setStarting(NodeKind kind, bool starting);
+    void setLastPayload(const QByteArray &payload);
+    void handleEvent(const QString &type, const QJsonObject &payload);
+    void onEventsConnectedChanged(bool connected);
+
     QUrl m_baseUrl;
     Options m_opts;
     QNetworkAccessManager *m_net{nullptr};
     QTimer m_statusTimer;
-    QString m_lastResponse;
+
+    QByteArray m_lastPayload;
+    mutable QString m_lastResponse;
+    mutable bool m_lastResponseDirty{false};
+
+    LogTailStream *m_logTail{nullptr};
+    NodeKind m_logTailKind{NodeKind::Rust};
+
+    EventStream *m_events{nullptr};
+
+    QHash<QNetworkReply *, RequestInfo> m_requests; // offene Requests
+    QHash<QString, QNetworkReply *> m_inFlight;     // Pfad inkl. Query -> offener GET
+    QHash<int, EndpointStats> m_stats;              // flightKey -> Timing
+    QElapsedTimer m_clock;
+
+    int m_pollBaseMs{0};        // 0 = Polling aus
+    int m_pollCurrentMs{0};
+    bool m_nodeSyncing{false};
+    int m_startingMask{0};      // Bit pro NodeKind, solange Start noch nicht bestaetigt
+    qint64 m_startingSinceMs{0};
+    size_t m_lastStatusHash{0};
+    bool m_hasLastStatus{false};
 };
 
 #endif // GRINNODEMANAGER_H
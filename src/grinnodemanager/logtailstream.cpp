@@ -0,0 +1,227 @@
+#include "logtailstream.h"
+
+namespace {
+const int kFlushIntervalMs = 100;   // Zeilen werden in diesem Takt gebündelt gemeldet
+const int kReconnectMs = 250;       // Server hat den Stream regulär beendet
+const int kMinRetryMs = 1000;
+const int kMaxRetryMs = 30000;
+}
+
+LogTailStream::LogTailStream(QNetworkAccessManager *net, QObject *parent) :
+    QObject(parent),
+    m_net(net),
+    m_active(false),
+    m_sse(false),
+    m_headersSeen(false),
+    m_cursor(-1),
+    m_delivered(false),
+    m_retryMs(kMinRetryMs)
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushIntervalMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, &LogTailStream::flush);
+
+    m_reconnectTimer.setSingleShot(true);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &LogTailStream::connectStream);
+}
+
+LogTailStream::~LogTailStream()
+{
+    abortReply();
+}
+
+void LogTailStream::start(const RequestFactory &factory, qint64 cursor)
+{
+    stop();
+
+    m_factory = factory;
+    m_cursor = cursor;
+    m_delivered = false;
+    m_retryMs = kMinRetryMs;
+    m_active = true;
+    connectStream();
+}
+
+void LogTailStream::stop()
+{
+    m_active = false;
+    m_reconnectTimer.stop();
+    abortReply();
+    flush();
+}
+
+void LogTailStream::connectStream()
+{
+    if (!m_active || !m_factory) {
+        return;
+    }
+
+    abortReply();
+    m_parser.reset();
+    m_partialLine.clear();
+    m_headersSeen = false;
+    m_sse = false;
+
+    QNetworkRequest req = m_factory(m_cursor);
+    req.setRawHeader("Accept", "text/event-stream, text/plain");
+    req.setRawHeader("Cache-Control", "no-cache");
+    if (m_cursor >= 0) {
+        req.setRawHeader("Last-Event-ID", QByteArray::number(m_cursor));
+    }
+    // Accept-Encoding bewusst nicht setzen: QNetworkAccessManager fordert dann
+    // selbst gzip/deflate an und dekomprimiert den Stream inkrementell.
+
+    m_reply = m_net->get(req);
+    connect(m_reply.data(), &QNetworkReply::readyRead, this, &LogTailStream::onReadyRead);
+    connect(m_reply.data(), &QNetworkReply::finished, this, &LogTailStream::onFinished);
+}
+
+void LogTailStream::abortReply()
+{
+    if (!m_reply) {
+        return;
+    }
+    QNetworkReply *reply = m_reply.data();
+    m_reply.clear();
+    reply->disconnect(this);
+    reply->abort();
+    reply->deleteLater();
+}
+
+void LogTailStream::onReadyRead()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    if (!reply || reply != m_reply.data()) {
+        return;
+    }
+
+    if (!m_headersSeen) {
+        m_headersSeen = true;
+        const QString type = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+        m_sse = type.startsWith("text/event-stream");
+
+        // text/plain: Server nennt den Offset des ersten gesendeten Bytes
+        bool ok = false;
+        const qint64 start = reply->rawHeader("X-Log-Cursor").toLongLong(&ok);
+        if (ok) {
+            m_cursor = start;
+        }
+    }
+
+    const QByteArray chunk = reply->readAll();
+    if (chunk.isEmpty()) {
+        return;
+    }
+    m_retryMs = kMinRetryMs;
+
+    if (!m_sse) {
+        appendPlain(chunk);
+        return;
+    }
+
+    const QList<SseParser::Event> events = m_parser.feed(chunk);
+    for (const SseParser::Event &ev : events) {
+        if (ev.event == "message" || ev.event == "lines") {
+            appendEventData(ev.data);
+        }
+        // id = Cursor hinter den Zeilen dieses Events
+        bool ok = false;
+        const qint64 id = ev.id.toLongLong(&ok);
+        if (ok) {
+            m_cursor = id;
+        }
+    }
+}
+
+void LogTailStream::appendPlain(const QByteArray &chunk)
+{
+    m_partialLine.append(chunk);
+
+    int start = 0;
+    for (;;) {
+        const int nl = m_partialLine.indexOf('\n', start);
+        if (nl < 0) {
+            break;
+        }
+        int end = nl;
+        if (end > start && m_partialLine.at(end - 1) == '\r') {
+            --end;
+        }
+        m_pending.append(QString::fromUtf8(m_partialLine.constData() + start, end - start));
+        m_delivered = true;
+        if (m_cursor >= 0) {
+            m_cursor += nl + 1 - start;
+        }
+        start = nl + 1;
+    }
+    m_partialLine.remove(0, start);
+
+    if (!m_pending.isEmpty() && !m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void LogTailStream::appendEventData(const QByteArray &data)
+{
+    const QList<QByteArray> lines = data.split('\n');
+    for (const QByteArray &line : lines) {
+        m_pending.append(QString::fromUtf8(line));
+    }
+    m_delivered = true;
+
+    if (!m_pending.isEmpty() && !m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void LogTailStream::flush()
+{
+    m_flushTimer.stop();
+    if (m_pending.isEmpty()) {
+        return;
+    }
+
+    QStringList batch;
+    batch.swap(m_pending);
+    emit linesAppended(batch, m_cursor);
+}
+
+void LogTailStream::onFinished()
+{
+    QNetworkReply *reply = qobject_cast<QNetworkReply *>(sender());
+    if (!reply || reply != m_reply.data()) {
+        return;
+    }
+    m_reply.clear();
+    reply->deleteLater();
+
+    flush();
+
+    if (!m_active) {
+        return;
+    }
+
+    const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const bool failed = reply->error() != QNetworkReply::NoError || statusCode != 200;
+    if (failed) {
+        emit streamError(QString("[%1] %2").arg(reply->url().toString(), reply->errorString()));
+    }
+
+    // Ohne Cursor (text/plain ohne X-Log-Cursor) liefert ein neuer Request
+    // wieder die letzten n Zeilen; die stehen schon in der Ansicht
+    if (m_cursor < 0 && m_delivered) {
+        m_active = false;
+        emit streamError(QString("[%1] log tail sent no cursor, not resuming").arg(reply->url().toString()));
+        emit stopped();
+        return;
+    }
+
+    if (failed) {
+        m_reconnectTimer.start(m_retryMs);
+        m_retryMs = qMin(m_retryMs * 2, kMaxRetryMs);
+        return;
+    }
+
+    // Regulär beendet (Idle-Timeout, Proxy, Long-Poll unter WASM): ab Cursor weiter
+    m_reconnectTimer.start(kReconnectMs);
+}
@@ -0,0 +1,72 @@
+#ifndef LOGTAILSTREAM_H
+#define LOGTAILSTREAM_H
+
+#include <QObject>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QPointer>
+#include <QStringList>
+#include <QTimer>
+
+#include <functional>
+
+#include "sseparser.h"
+
+// Inkrementelles Log-Tailing über den Controller (/logs/<kind>/tail).
+// Der Server liefert ab einem Byte-Cursor nur neue Zeilen, entweder als
+// SSE (id = Cursor nach dem Event) oder als chunked text/plain.
+// Fortgesetzt wird nur mit bekanntem Cursor; ohne ihn endet der Tail.
+// Zeilen werden gesammelt und gebündelt als Delta gemeldet.
+class LogTailStream : public QObject
+{
+    Q_OBJECT
+public:
+    // Baut den Request für einen gegebenen Cursor (-1 = "letzte n Zeilen")
+    typedef std::function<QNetworkRequest (qint64 cursor)> RequestFactory;
+
+    explicit LogTailStream(QNetworkAccessManager *net, QObject *parent = nullptr);
+    ~LogTailStream() override;
+
+    void start(const RequestFactory &factory, qint64 cursor);
+    void stop();
+
+    bool isActive() const { return m_active; }
+    qint64 cursor() const { return m_cursor; }
+
+signals:
+    void linesAppended(const QStringList &lines, qint64 cursor);
+    void streamError(const QString &message);
+    // Stream ohne Cursor beendet; ein Neustart würde Zeilen doppelt liefern
+    void stopped();
+
+private slots:
+    void onReadyRead();
+    void onFinished();
+    void flush();
+
+private:
+    void connectStream();
+    void abortReply();
+    void appendPlain(const QByteArray &chunk);
+    void appendEventData(const QByteArray &data);
+
+    QNetworkAccessManager *m_net;
+    RequestFactory m_factory;
+    QPointer<QNetworkReply> m_reply;
+    SseParser m_parser;
+
+    bool m_active;
+    bool m_sse;
+    bool m_headersSeen;
+    qint64 m_cursor;
+    bool m_delivered;           // seit start() schon Zeilen gemeldet
+    QByteArray m_partialLine;   // nur text/plain: angefangene Zeile
+    QStringList m_pending;      // noch nicht gemeldete Zeilen
+
+    QTimer m_flushTimer;
+    QTimer m_reconnectTimer;
+    int m_retryMs;
+};
+
+#endif // LOGTAILSTREAM_H
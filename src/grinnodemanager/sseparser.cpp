@@ -0,0 +1,87 @@
+#include "sseparser.h"
+
+SseParser::SseParser() :
+    m_hasData(false)
+{
+}
+
+/**
+ * @brief SseParser::feed
+ * @param chunk roher (bereits dekomprimierter) Stream-Ausschnitt
+ * @return alle durch diesen Chunk abgeschlossenen Events
+ */
+QList<SseParser::Event> SseParser::feed(const QByteArray &chunk)
+{
+    QList<Event> out;
+    m_buffer.append(chunk);
+
+    int start = 0;
+    for (;;) {
+        const int nl = m_buffer.indexOf('\n', start);
+        if (nl < 0) {
+            break;
+        }
+        int end = nl;
+        if (end > start && m_buffer.at(end - 1) == '\r') {
+            --end;
+        }
+        processLine(m_buffer.mid(start, end - start), out);
+        start = nl + 1;
+    }
+    m_buffer.remove(0, start);
+
+    return out;
+}
+
+void SseParser::reset()
+{
+    m_buffer.clear();
+    m_current = Event();
+    m_hasData = false;
+}
+
+void SseParser::processLine(const QByteArray &line, QList<Event> &out)
+{
+    // Leerzeile schließt das Event ab
+    if (line.isEmpty()) {
+        if (m_hasData) {
+            if (m_current.event.isEmpty()) {
+                m_current.event = QStringLiteral("message");
+            }
+            out.append(m_current);
+        }
+        m_current = Event();
+        m_hasData = false;
+        return;
+    }
+
+    // Kommentar / Keep-Alive
+    if (line.startsWith(':')) {
+        return;
+    }
+
+    QByteArray field = line;
+    QByteArray value;
+    const int colon = line.indexOf(':');
+    if (colon >= 0) {
+        field = line.left(colon);
+        value = line.mid(colon + 1);
+        if (value.startsWith(' ')) {
+            value.remove(0, 1);
+        }
+    }
+
+    if (field == "data") {
+        if (m_hasData) {
+            m_current.data.append('\n');
+        }
+        m_current.data.append(value);
+        m_hasData = true;
+    } else if (field == "event") {
+        m_current.event = QString::fromUtf8(value);
+    } else if (field == "id") {
+        m_current.id = QString::fromUtf8(value);
+        m_lastEventId = m_current.id;
+    }
+    // "retry" und unbekannte Felder werden ignoriert
+}
@@ -0,0 +1,36 @@
+#ifndef SSEPARSER_H
+#define SSEPARSER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+// Inkrementeller Parser für text/event-stream (Server-Sent Events).
+// Chunks können an beliebiger Stelle getrennt sein; fertige Events
+// werden erst nach der abschließenden Leerzeile geliefert.
+class SseParser
+{
+public:
+    struct Event {
+        QString id;         // leer, wenn das Event keine id hatte
+        QString event;      // "message", falls nicht gesetzt
+        QByteArray data;    // mehrere data:-Zeilen mit '\n' verbunden
+    };
+
+    SseParser();
+
+    QList<Event> feed(const QByteArray &chunk);
+    void reset();
+
+    QString lastEventId() const { return m_lastEventId; }
+
+private:
+    void processLine(const QByteArray &line, QList<Event> &out);
+
+    QByteArray m_buffer;
+    Event m_current;
+    bool m_hasData;
+    QString m_lastEventId;
+};
+
+#endif // SSEPARSER_H
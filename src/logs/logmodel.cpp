@@ -0,0 +1,746 @@
+#include "logmodel.h"
+
+#include <QElapsedTimer>
+
+#include <cstring>
+
+namespace {
+// Token = Bereich bis zum nächsten Leerzeichen; [..]-Klammern gelten mit als Token
+struct Token {
+    int start;
+    int end;
+};
+
+bool nextToken(const char *s, int n, int &pos, Token &tok)
+{
+    while (pos < n && s[pos] == ' ') {
+        ++pos;
+    }
+    if (pos >= n) {
+        return false;
+    }
+    tok.start = pos;
+    while (pos < n && s[pos] != ' ') {
+        ++pos;
+    }
+    tok.end = pos;
+    return true;
+}
+
+QByteArray stripBrackets(const char *s, const Token &t)
+{
+    int a = t.start;
+    int b = t.end;
+    if (b - a >= 2 && s[a] == '[' && s[b - 1] == ']') {
+        ++a;
+        --b;
+    }
+    return QByteArray::fromRawData(s + a, b - a);
+}
+
+bool isDigitAt(const char *s, const Token &t)
+{
+    int p = t.start;
+    if (p < t.end && s[p] == '[') {
+        ++p;
+    }
+    return p < t.end && s[p] >= '0' && s[p] <= '9';
+}
+
+inline char lowerAscii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? char(c + ('a' - 'A')) : c;
+}
+
+// Suche ohne Beachtung der Groß-/Kleinschreibung (ASCII); needle ist bereits lowercase
+bool containsFolded(const char *hay, int n, const QByteArray &needle)
+{
+    const int m = needle.size();
+    if (m == 0) {
+        return true;
+    }
+    const char *nd = needle.constData();
+    const char first = nd[0];
+    for (int i = 0; i + m <= n; ++i) {
+        if (lowerAscii(hay[i]) != first) {
+            continue;
+        }
+        int j = 1;
+        while (j < m && lowerAscii(hay[i + j]) == nd[j]) {
+            ++j;
+        }
+        if (j == m) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool spanMatches(const LogSpan &r, const QByteArray &arena, qint64 arenaBase, const LogFilter &f)
+{
+    if (r.level < f.minLevel) {
+        return false;
+    }
+    if (f.moduleId != -1 && r.module != f.moduleId) {
+        return false;
+    }
+    if (!f.needle.isEmpty()) {
+        return containsFolded(arena.constData() + (r.offset - arenaBase), int(r.length), f.needle);
+    }
+    return true;
+}
+
+const char *kLevelNames[] = { "", "TRACE", "DEBUG", "INFO", "WARN", "ERROR" };
+
+#if !QT_CONFIG(thread)
+const int kSliceLines = 500;        // Zeilen pro Tokenizer-Aufruf
+const int kSliceScanLines = 20000;  // Zeilen pro Filter-Schritt
+const int kSliceBudgetMs = 8;       // danach kommt der Event-Loop wieder dran
+#endif
+}
+
+// ---------- Worker ----------
+
+void LogTokenizer::tokenize(const QStringList &lines, quint64 generation)
+{
+    LogBatch batch;
+    batch.generation = generation;
+    batch.lines.reserve(lines.size());
+
+    QHash<QByteArray, qint16> moduleIndex;
+
+    for (const QString &line : lines) {
+        const QByteArray utf8 = line.toUtf8();
+        const char *s = utf8.constData();
+        const int n = utf8.size();
+
+        LogBatch::Line info;
+        info.offset = quint32(batch.text.size());
+        info.length = quint32(n);
+        info.tsLength = 0;
+        info.msgStart = 0;
+        info.level = LogModel::Unknown;
+        info.module = -1;
+
+        int pos = 0;
+        Token tok;
+        bool have = nextToken(s, n, pos, tok);
+
+        // Zeitstempel: "20261016 22:52:31.938" bzw. "[2026-10-16 22:52:31.938]"
+        if (have && isDigitAt(s, tok)) {
+            int tsEnd = tok.end;
+            int probe = pos;
+            Token second;
+            if (s[tok.start] != '[' || s[tok.end - 1] != ']') {
+                if (nextToken(s, n, probe, second) && isDigitAt(s, second)) {
+                    tsEnd = second.end;
+                    pos = probe;
+                }
+            }
+            info.tsLength = quint16(qMin(tsEnd, 0xffff));
+            info.msgStart = info.tsLength;
+            have = nextToken(s, n, pos, tok);
+        }
+
+        // Level: "INFO" oder "[INFO]"
+        if (have) {
+            const LogModel::Level level = LogModel::parseLevel(stripBrackets(s, tok));
+            if (level != LogModel::Unknown) {
+                info.level = quint8(level);
+                info.msgStart = quint16(qMin(tok.end, 0xffff));
+                have = nextToken(s, n, pos, tok);
+
+                // Modul: "grin_chain::chain" (gefolgt von " - ") oder "[Chain]"
+                if (have) {
+                    const bool bracketed = s[tok.start] == '[' && s[tok.end - 1] == ']';
+                    const bool rustPath = QByteArray::fromRawData(s + tok.start, tok.end - tok.start)
+                                          .contains("::");
+                    if (bracketed || rustPath) {
+                        const QByteArray name = stripBrackets(s, tok);
+                        auto it = moduleIndex.constFind(name);
+                        if (it == moduleIndex.constEnd()) {
+                            it = moduleIndex.insert(QByteArray(name.constData(), name.size()),
+                                                    qint16(batch.modules.size()));
+                            batch.modules.append(QString::fromUtf8(name));
+                        }
+                        info.module = it.value();
+
+                        int msg = tok.end;
+                        int probe = msg;
+                        Token dash;
+                        if (nextToken(s, n, probe, dash) && dash.end - dash.start == 1
+                            && s[dash.start] == '-') {
+                            msg = dash.end;
+                        }
+                        info.msgStart = quint16(qMin(msg, 0xffff));
+                    }
+                }
+            }
+        }
+
+        while (info.msgStart < n && s[info.msgStart] == ' ' && info.msgStart < 0xffff) {
+            ++info.msgStart;
+        }
+
+        batch.text.append(utf8);
+        batch.lines.append(info);
+    }
+
+    emit batchReady(batch);
+}
+
+void LogFilterWorker::scan(const LogFilterJob &job)
+{
+    LogFilterResult result;
+    result.generation = job.generation;
+    result.endSeq = job.firstSeq + job.spans.size();
+    scanRange(job, 0, job.spans.size(), result.visible);
+    emit scanReady(result);
+}
+
+void LogFilterWorker::scanRange(const LogFilterJob &job, int from, int to, QVector<qint64> &visible)
+{
+    for (int i = from; i < to; ++i) {
+        if (spanMatches(job.spans.at(i), job.arena, job.arenaBase, job.filter)) {
+            visible.append(job.firstSeq + i);
+        }
+    }
+}
+
+// ---------- Model ----------
+
+LogModel::LogModel(QObject *parent) :
+    QAbstractListModel(parent)
+{
+    qRegisterMetaType<LogBatch>("LogBatch");
+    qRegisterMetaType<LogFilterJob>("LogFilterJob");
+    qRegisterMetaType<LogFilterResult>("LogFilterResult");
+
+    m_ring.resize(m_capacity);
+
+    m_tokenizer = new LogTokenizer;
+#if QT_CONFIG(thread)
+    m_tokenizer->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_tokenizer, &QObject::deleteLater);
+    connect(this, &LogModel::tokenizeRequested, m_tokenizer, &LogTokenizer::tokenize);
+    connect(m_tokenizer, &LogTokenizer::batchReady, this, &LogModel::onBatchReady);
+    m_filterWorker = new LogFilterWorker;
+    m_filterWorker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_filterWorker, &QObject::deleteLater);
+    connect(this, &LogModel::filterRequested, m_filterWorker, &LogFilterWorker::scan);
+    connect(m_filterWorker, &LogFilterWorker::scanReady, this, &LogModel::onFilterReady);
+    m_thread.start(QThread::LowPriority);
+#else
+    // Ohne Thread-Support gäbe es keinen Event-Loop für den Worker
+    m_tokenizer->setParent(this);
+    connect(m_tokenizer, &LogTokenizer::batchReady, this, &LogModel::onBatchReady);
+    m_sliceTimer.setSingleShot(true);
+    m_sliceTimer.setInterval(0);
+    connect(&m_sliceTimer, &QTimer::timeout, this, &LogModel::tokenizeSlice);
+    m_filterTimer.setSingleShot(true);
+    m_filterTimer.setInterval(0);
+    connect(&m_filterTimer, &QTimer::timeout, this, &LogModel::filterSlice);
+#endif
+}
+
+LogModel::~LogModel()
+{
+#if QT_CONFIG(thread)
+    m_thread.quit();
+    m_thread.wait();
+#endif
+}
+
+int LogModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return filterActive() ? m_visible.size() : m_count;
+}
+
+QVariant LogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount()) {
+        return QVariant();
+    }
+
+    const qint64 seq = filterActive() ? m_visible.at(index.row()) : m_firstSeq + index.row();
+    const Record &r = recordAt(seq);
+    const char *s = m_arena.constData() + (r.offset - m_arenaBase);
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case TextRole:
+        return QString::fromUtf8(s, r.length);
+    case TimestampRole:
+        return QString::fromUtf8(s, r.tsLength);
+    case LevelRole:
+        return QString::fromLatin1(kLevelNames[r.level]);
+    case ModuleRole:
+        return r.module >= 0 ? m_modules.at(r.module) : QString();
+    case MessageRole:
+        return QString::fromUtf8(s + r.msgStart, int(r.length) - r.msgStart);
+    case SeqRole:
+        return seq;
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> LogModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[TextRole] = "text";
+    roles[TimestampRole] = "timestamp";
+    roles[LevelRole] = "level";
+    roles[ModuleRole] = "module";
+    roles[MessageRole] = "message";
+    roles[SeqRole] = "seq";
+    return roles;
+}
+
+void LogModel::appendLines(const QStringList &lines)
+{
+    if (lines.isEmpty()) {
+        return;
+    }
+#if QT_CONFIG(thread)
+    emit tokenizeRequested(lines, m_generation);
+#else
+    m_queued += lines;
+    if (!m_sliceTimer.isActive()) {
+        m_sliceTimer.start();
+    }
+#endif
+}
+
+#if !QT_CONFIG(thread)
+/**
+ * @brief LogModel::tokenizeSlice
+ * Tokenisiert wartende Zeilen in Stücken von kSliceLines, bis das Zeitbudget
+ * aufgebraucht ist; der Rest folgt im nächsten Durchlauf des Event-Loops.
+ */
+void LogModel::tokenizeSlice()
+{
+    QElapsedTimer budget;
+    budget.start();
+    while (!m_queued.isEmpty() && budget.elapsed() < kSliceBudgetMs) {
+        const int n = qMin(kSliceLines, m_queued.size());
+        const QStringList chunk = m_queued.mid(0, n);
+        m_queued.erase(m_queued.begin(), m_queued.begin() + n);
+        m_tokenizer->tokenize(chunk, m_generation);
+    }
+    if (!m_queued.isEmpty()) {
+        m_sliceTimer.start();
+    }
+}
+
+/**
+ * @brief LogModel::filterSlice
+ * Scannt die Momentaufnahme des laufenden Filterwechsels in Stücken von
+ * kSliceScanLines, bis das Zeitbudget aufgebraucht ist.
+ */
+void LogModel::filterSlice()
+{
+    QElapsedTimer budget;
+    budget.start();
+    const int n = m_filterJob.spans.size();
+    while (m_filterPos < n && budget.elapsed() < kSliceBudgetMs) {
+        const int to = qMin(n, m_filterPos + kSliceScanLines);
+        LogFilterWorker::scanRange(m_filterJob, m_filterPos, to, m_filterHits);
+        m_filterPos = to;
+    }
+    if (m_filterPos < n) {
+        m_filterTimer.start();
+        return;
+    }
+
+    LogFilterResult result;
+    result.visible.swap(m_filterHits);
+    result.endSeq = m_filterJob.firstSeq + n;
+    result.generation = m_filterJob.generation;
+    m_filterJob = LogFilterJob();
+    onFilterReady(result);
+}
+#endif
+
+void LogModel::setText(const QString &text)
+{
+    clear();
+
+    QStringList lines = text.split('\n');
+    if (!lines.isEmpty() && lines.last().isEmpty()) {
+        lines.removeLast();
+    }
+    appendLines(lines);
+}
+
+void LogModel::clear()
+{
+    ++m_generation;     // noch laufende Batches verwerfen
+#if !QT_CONFIG(thread)
+    m_queued.clear();
+    m_sliceTimer.stop();
+#endif
+
+    beginResetModel();
+    resetStorage();
+    m_modules.clear();
+    m_moduleIds.clear();
+    // ohne Zeilen braucht ein laufender Filterwechsel keinen Scan mehr
+    ++m_filterGeneration;
+    if (m_filterPending) {
+        m_filter = m_pendingFilter;
+        m_filterPending = false;
+#if !QT_CONFIG(thread)
+        m_filterTimer.stop();
+        m_filterJob = LogFilterJob();
+        m_filterHits.clear();
+#endif
+    }
+    m_filter.moduleId = m_filter.module.isEmpty() ? -1 : -2;
+    endResetModel();
+
+    emit countChanged();
+    emit modulesChanged();
+}
+
+void LogModel::resetStorage()
+{
+    m_head = 0;
+    m_count = 0;
+    m_firstSeq = 0;
+    m_arena.clear();
+    m_arenaBase = 0;
+    m_visible.clear();
+}
+
+void LogModel::setCapacity(int capacity)
+{
+    capacity = qMax(capacity, 100);
+    if (capacity == m_capacity) {
+        return;
+    }
+
+    // Ring in neuer Größe linear neu aufbauen (jüngste Zeilen bleiben)
+    beginResetModel();
+    const int keep = qMin(m_count, capacity);
+    QVector<Record> ring(capacity);
+    const qint64 firstKept = m_firstSeq + (m_count - keep);
+    for (int i = 0; i < keep; ++i) {
+        ring[i] = recordAt(firstKept + i);
+    }
+    m_ring.swap(ring);
+    m_head = 0;
+    m_count = keep;
+    m_firstSeq = firstKept;
+    m_capacity = capacity;
+    compactArena();
+    // seq bleiben gültig: nur verdrängte Zeilen fallen aus dem Filter
+    int drop = 0;
+    while (drop < m_visible.size() && m_visible.at(drop) < m_firstSeq) {
+        ++drop;
+    }
+    m_visible.remove(0, drop);
+    endResetModel();
+
+    emit capacityChanged();
+    emit countChanged();
+}
+
+void LogModel::setMinLevel(int level)
+{
+    if (m_minLevel == level) {
+        return;
+    }
+    m_minLevel = level;
+    emit filterChanged();
+    requestFilter();
+}
+
+void LogModel::setModuleFilter(const QString &module)
+{
+    if (m_moduleFilter == module) {
+        return;
+    }
+    m_moduleFilter = module;
+    emit filterChanged();
+    requestFilter();
+}
+
+void LogModel::setSearchText(const QString &text)
+{
+    if (m_searchText == text) {
+        return;
+    }
+    m_searchText = text;
+    emit filterChanged();
+    requestFilter();
+}
+
+LogModel::Level LogModel::parseLevel(const QByteArray &token)
+{
+    if (token == "INFO") {
+        return Info;
+    }
+    if (token == "WARN" || token == "WARNING") {
+        return Warn;
+    }
+    if (token == "ERROR" || token == "ERR") {
+        return Error;
+    }
+    if (token == "DEBUG") {
+        return Debug;
+    }
+    if (token == "TRACE") {
+        return Trace;
+    }
+    return Unknown;
+}
+
+// ---------- intern ----------
+
+const LogModel::Record &LogModel::recordAt(qint64 seq) const
+{
+    return m_ring.at(int((m_head + (seq - m_firstSeq)) % m_capacity));
+}
+
+bool LogModel::filterActive() const
+{
+    return m_filter.active();
+}
+
+bool LogModel::matches(const Record &r) const
+{
+    return spanMatches(r, m_arena, m_arenaBase, m_filter);
+}
+
+LogFilter LogModel::requestedFilter() const
+{
+    LogFilter f;
+    f.minLevel = m_minLevel;
+    f.module = m_moduleFilter;
+    f.moduleId = m_moduleFilter.isEmpty() ? -1 : m_moduleIds.value(m_moduleFilter, -2);
+    const QByteArray utf8 = m_searchText.toUtf8();
+    f.needle.reserve(utf8.size());
+    for (char c : utf8) {
+        f.needle.append(lowerAscii(c));
+    }
+    return f;
+}
+
+/**
+ * @brief LogModel::requestFilter
+ * Gibt eine Momentaufnahme der Zeilen mit dem gewünschten Filter an den
+ * Worker; onFilterReady() übernimmt nur das Ergebnis des letzten Wechsels.
+ * Ohne aktiven Filter ist nichts zu scannen.
+ */
+void LogModel::requestFilter()
+{
+    const LogFilter f = requestedFilter();
+    ++m_filterGeneration;
+#if !QT_CONFIG(thread)
+    m_filterTimer.stop();
+    m_filterJob = LogFilterJob();
+    m_filterHits.clear();
+#endif
+
+    if (!f.active()) {
+        m_filterPending = false;
+        beginResetModel();
+        m_filter = f;
+        m_visible.clear();
+        endResetModel();
+        emit countChanged();
+        return;
+    }
+
+    LogFilterJob job;
+    job.spans.reserve(m_count);
+    for (qint64 seq = m_firstSeq; seq < m_firstSeq + m_count; ++seq) {
+        job.spans.append(recordAt(seq));
+    }
+    job.arena = m_arena;
+    job.arenaBase = m_arenaBase;
+    job.firstSeq = m_firstSeq;
+    job.filter = f;
+    job.generation = m_filterGeneration;
+
+    m_pendingFilter = f;
+    m_filterPending = true;
+#if QT_CONFIG(thread)
+    emit filterRequested(job);
+#else
+    m_filterJob = job;
+    m_filterPos = 0;
+    m_filterTimer.start();
+#endif
+}
+
+/**
+ * @brief LogModel::onFilterReady
+ * Übernimmt das Scan-Ergebnis: inzwischen verdrängte Zeilen fallen weg,
+ * seit der Momentaufnahme angehängte werden hier geprüft.
+ */
+void LogModel::onFilterReady(const LogFilterResult &result)
+{
+    if (!m_filterPending || result.generation != m_filterGeneration) {
+        return;
+    }
+    m_filterPending = false;
+
+    const LogFilter &f = m_pendingFilter;
+    int drop = 0;
+    while (drop < result.visible.size() && result.visible.at(drop) < m_firstSeq) {
+        ++drop;
+    }
+    QVector<qint64> visible = result.visible.mid(drop);
+    for (qint64 seq = qMax(result.endSeq, m_firstSeq); seq < m_firstSeq + m_count; ++seq) {
+        if (spanMatches(recordAt(seq), m_arena, m_arenaBase, f)) {
+            visible.append(seq);
+        }
+    }
+
+    beginResetModel();
+    m_filter = f;
+    m_visible.swap(visible);
+    endResetModel();
+    emit countChanged();
+}
+
+// Entfernt die n ältesten Zeilen (Zeilensignale nur für sichtbare Zeilen)
+void LogModel::evict(int n)
+{
+    if (n <= 0) {
+        return;
+    }
+
+    const qint64 newFirst = m_firstSeq + n;
+    if (filterActive()) {
+        int drop = 0;
+        while (drop < m_visible.size() && m_visible.at(drop) < newFirst) {
+            ++drop;
+        }
+        if (drop > 0) {
+            beginRemoveRows(QModelIndex(), 0, drop - 1);
+            m_visible.remove(0, drop);
+        }
+        m_head = (m_head + n) % m_capacity;
+        m_count -= n;
+        m_firstSeq = newFirst;
+        if (drop > 0) {
+            endRemoveRows();
+        }
+    } else {
+        beginRemoveRows(QModelIndex(), 0, n - 1);
+        m_head = (m_head + n) % m_capacity;
+        m_count -= n;
+        m_firstSeq = newFirst;
+        endRemoveRows();
+    }
+
+    // Arena erst kompaktieren, wenn mehr als die Hälfte tot ist (amortisiert O(1))
+    if (m_count == 0) {
+        m_arenaBase += m_arena.size();
+        m_arena.clear();
+    } else if ((recordAt(m_firstSeq).offset - m_arenaBase) * 2 > m_arena.size()) {
+        compactArena();
+    }
+}
+
+void LogModel::compactArena()
+{
+    if (m_count == 0) {
+        m_arenaBase += m_arena.size();
+        m_arena.clear();
+        return;
+    }
+    const qint64 dead = recordAt(m_firstSeq).offset - m_arenaBase;
+    if (dead > 0) {
+        m_arena.remove(0, int(dead));
+        m_arenaBase += dead;
+    }
+}
+
+void LogModel::onBatchReady(const LogBatch &batch)
+{
+    if (batch.generation != m_generation || batch.lines.isEmpty()) {
+        return;
+    }
+
+    // Module des Batches auf globale Ids abbilden
+    QVector<qint16> moduleMap(batch.modules.size());
+    bool modulesAdded = false;
+    for (int i = 0; i < batch.modules.size(); ++i) {
+        const QString &name = batch.modules.at(i);
+        auto it = m_moduleIds.constFind(name);
+        if (it == m_moduleIds.constEnd()) {
+            it = m_moduleIds.insert(name, qint16(m_modules.size()));
+            m_modules.append(name);
+            modulesAdded = true;
+            if (name == m_filter.module) {
+                m_filter.moduleId = it.value();
+            }
+            if (m_filterPending && name == m_pendingFilter.module) {
+                m_pendingFilter.moduleId = it.value();
+            }
+        }
+        moduleMap[i] = it.value();
+    }
+
+    // Passt der Batch allein nicht in den Ring, zählen nur die jüngsten Zeilen
+    int first = 0;
+    if (batch.lines.size() > m_capacity) {
+        first = batch.lines.size() - m_capacity;
+    }
+    const int incoming = batch.lines.size() - first;
+    evict(m_count + incoming - m_capacity);
+
+    const qint64 textStart = batch.lines.at(first).offset;
+    const qint64 globalBase = m_arenaBase + m_arena.size() - textStart;
+    m_arena.append(batch.text.constData() + textStart, int(batch.text.size() - textStart));
+
+    QVector<Record> records;
+    records.reserve(incoming);
+    for (int i = first; i < batch.lines.size(); ++i) {
+        const LogBatch::Line &l = batch.lines.at(i);
+        Record r;
+        r.offset = globalBase + l.offset;
+        r.length = l.length;
+        r.tsLength = l.tsLength;
+        r.msgStart = l.msgStart;
+        r.level = l.level;
+        r.module = l.module >= 0 ? moduleMap.at(l.module) : qint16(-1);
+        records.append(r);
+    }
+
+    // Views erfahren nur das Delta (bei Filter: nur passende Zeilen)
+    const bool filtered = filterActive();
+    QVector<qint64> visibleSeqs;
+    if (filtered) {
+        for (int i = 0; i < records.size(); ++i) {
+            if (matches(records.at(i))) {
+                visibleSeqs.append(m_firstSeq + m_count + i);
+            }
+        }
+    }
+
+    const int oldRows = rowCount();
+    const int added = filtered ? visibleSeqs.size() : records.size();
+    if (added > 0) {
+        beginInsertRows(QModelIndex(), oldRows, oldRows + added - 1);
+    }
+    for (const Record &r : records) {
+        m_ring[int((m_head + m_count) % m_capacity)] = r;
+        ++m_count;
+    }
+    m_visible += visibleSeqs;
+    if (added > 0) {
+        endInsertRows();
+    }
+
+    emit countChanged();
+    if (modulesAdded) {
+        emit modulesChanged();
+    }
+}
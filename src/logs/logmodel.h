@@ -0,0 +1,237 @@
+#ifndef LOGMODEL_H
+#define LOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+
+#if QT_CONFIG(thread)
+#include <QThread>
+#else
+#include <QTimer>
+#endif
+
+// Ergebnis der Tokenisierung eines Batches (Worker -> UI-Thread)
+struct LogBatch {
+    struct Line {
+        quint32 offset;     // Start in text
+        quint32 length;
+        quint16 tsLength;   // Länge des Zeitstempels am Zeilenanfang
+        quint16 msgStart;   // Beginn der eigentlichen Nachricht
+        quint8 level;       // LogModel::Level
+        qint16 module;      // Index in modules, -1 = keins
+    };
+
+    QByteArray text;        // UTF-8, Zeilen ohne Trenner hintereinander
+    QVector<Line> lines;
+    QStringList modules;
+    quint64 generation;     // verwirft Batches, die vor clear() eingereicht wurden
+};
+Q_DECLARE_METATYPE(LogBatch)
+
+// Zeile im Ringpuffer: Span in der Arena plus Tokens
+struct LogSpan {
+    qint64 offset;      // global, relativ zu m_arenaBase
+    quint32 length;
+    quint16 tsLength;
+    quint16 msgStart;
+    quint8 level;
+    qint16 module;
+};
+
+// Filter (Mindest-Level, Modul, Suchtext), wie ihn der Scan anwendet
+struct LogFilter {
+    int minLevel = 0;
+    QString module;
+    int moduleId = -1;      // -1 = alle, -2 = Modul noch nicht gesehen
+    QByteArray needle;      // lowercase UTF-8
+
+    bool active() const
+    {
+        return minLevel > 0 || moduleId != -1 || !needle.isEmpty();
+    }
+};
+
+// Momentaufnahme der Zeilen für den Filter-Scan (UI-Thread -> Worker);
+// arena ist implizit geteilt, spans[i] hat die seq firstSeq + i
+struct LogFilterJob {
+    QVector<LogSpan> spans;
+    QByteArray arena;
+    qint64 arenaBase = 0;
+    qint64 firstSeq = 0;
+    LogFilter filter;
+    quint64 generation = 0;
+};
+
+struct LogFilterResult {
+    QVector<qint64> visible;    // seq der passenden Zeilen
+    qint64 endSeq = 0;          // erste nicht gescannte seq
+    quint64 generation = 0;
+};
+Q_DECLARE_METATYPE(LogFilterJob)
+Q_DECLARE_METATYPE(LogFilterResult)
+
+// Zerlegt Zeilen in Zeitstempel / Level / Modul (läuft im Worker-Thread,
+// ohne Thread-Support in Zeitscheiben im UI-Thread)
+class LogTokenizer : public QObject
+{
+    Q_OBJECT
+public slots:
+    void tokenize(const QStringList &lines, quint64 generation);
+
+signals:
+    void batchReady(const LogBatch &batch);
+};
+
+// Wendet einen Filter auf eine Momentaufnahme an (läuft im Worker-Thread,
+// ohne Thread-Support in Zeitscheiben im UI-Thread)
+class LogFilterWorker : public QObject
+{
+    Q_OBJECT
+public:
+    // Zeilen job.spans[from, to) prüfen, passende seq an visible anhängen
+    static void scanRange(const LogFilterJob &job, int from, int to, QVector<qint64> &visible);
+
+public slots:
+    void scan(const LogFilterJob &job);
+
+signals:
+    void scanReady(const LogFilterResult &result);
+};
+
+// Log-Zeilen in einem begrenzten Ringpuffer; der Text aller Zeilen liegt
+// in einer gemeinsamen Arena, jede Zeile ist nur ein kompakter Span.
+// Filter (Mindest-Level, Modul, Suchtext) arbeiten auf den Spans; ein
+// Filterwechsel scannt eine Momentaufnahme im Worker, bis dahin bleibt der
+// bisherige Filter sichtbar.
+class LogModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int totalLines READ totalLines NOTIFY countChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+    Q_PROPERTY(int minLevel READ minLevel WRITE setMinLevel NOTIFY filterChanged)
+    Q_PROPERTY(QString moduleFilter READ moduleFilter WRITE setModuleFilter NOTIFY filterChanged)
+    Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY filterChanged)
+    Q_PROPERTY(QStringList modules READ modules NOTIFY modulesChanged)
+public:
+    enum Level {
+        Unknown = 0, Trace, Debug, Info, Warn, Error
+    };
+    Q_ENUM(Level)
+
+    enum Roles {
+        TextRole = Qt::UserRole + 1,
+        TimestampRole,
+        LevelRole,
+        ModuleRole,
+        MessageRole,
+        SeqRole
+    };
+
+    explicit LogModel(QObject *parent = nullptr);
+    ~LogModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Batch anhängen (Tokenisierung asynchron im Worker)
+    Q_INVOKABLE void appendLines(const QStringList &lines);
+    // Kompletter Dump (z.B. logsReceived): ersetzt den Inhalt
+    Q_INVOKABLE void setText(const QString &text);
+    Q_INVOKABLE void clear();
+
+    int count() const { return rowCount(); }
+    int totalLines() const { return m_count; }
+
+    int capacity() const { return m_capacity; }
+    void setCapacity(int capacity);
+
+    int minLevel() const { return m_minLevel; }
+    void setMinLevel(int level);
+
+    QString moduleFilter() const { return m_moduleFilter; }
+    void setModuleFilter(const QString &module);
+
+    QString searchText() const { return m_searchText; }
+    void setSearchText(const QString &text);
+
+    QStringList modules() const { return m_modules; }
+
+    static Level parseLevel(const QByteArray &token);
+
+signals:
+    void countChanged();
+    void capacityChanged();
+    void filterChanged();
+    void modulesChanged();
+
+    void tokenizeRequested(const QStringList &lines, quint64 generation);
+    void filterRequested(const LogFilterJob &job);
+
+private slots:
+    void onBatchReady(const LogBatch &batch);
+    void onFilterReady(const LogFilterResult &result);
+#if !QT_CONFIG(thread)
+    void tokenizeSlice();
+    void filterSlice();
+#endif
+
+private:
+    typedef LogSpan Record;
+
+    const Record &recordAt(qint64 seq) const;
+    bool filterActive() const;
+    bool matches(const Record &r) const;
+    LogFilter requestedFilter() const;
+    void requestFilter();
+    void evict(int n);
+    void compactArena();
+    void resetStorage();
+
+    // Ringpuffer
+    QVector<Record> m_ring;
+    int m_head{0};              // Index der ältesten Zeile
+    int m_count{0};
+    qint64 m_firstSeq{0};       // laufende Nummer der ältesten Zeile
+    int m_capacity{100000};
+
+    // Arena mit dem Text aller Zeilen
+    QByteArray m_arena;
+    qint64 m_arenaBase{0};
+
+    // Module werden interned
+    QStringList m_modules;
+    QHash<QString, qint16> m_moduleIds;
+
+    // Filter: Properties sind der gewünschte Stand, m_filter der angewendete
+    int m_minLevel{0};
+    QString m_moduleFilter;
+    QString m_searchText;
+    LogFilter m_filter;
+    QVector<qint64> m_visible;  // seq der sichtbaren Zeilen, nur bei aktivem Filter
+    LogFilter m_pendingFilter;  // wird gescannt
+    bool m_filterPending{false};
+    quint64 m_filterGeneration{0};
+
+#if QT_CONFIG(thread)
+    QThread m_thread;
+    LogFilterWorker *m_filterWorker{nullptr};
+#else
+    // WASM single-threaded: wartende Zeilen, abgearbeitet per 0-ms-Timer
+    QStringList m_queued;
+    QTimer m_sliceTimer;
+    // laufender Filter-Scan, ebenso in Zeitscheiben
+    LogFilterJob m_filterJob;
+    int m_filterPos{0};
+    QVector<qint64> m_filterHits;
+    QTimer m_filterTimer;
+#endif
+    LogTokenizer *m_tokenizer{nullptr};
+    quint64 m_generation{0};
+};
+
+#endif // LOGMODEL_H
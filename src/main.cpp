@@ -10,6 +10,7 @@
 #include "nodeforeignapi.h"
 #include "nodeownerapi.h"
 #include "config.h"
+#include "logmodel.h"
 
 #include "blindingfactor.h"
 #include "blockheaderprintable.h"
@@ -42,8 +43,16 @@
 #include "commitment.h"
 #include "output.h"
 #include "geolookup.h"
+#include "chaintimelinemodel.h"
+#include "chainrpc.h"
+#include "jsonrpcbatcher.h"
+#include "ownerrpc.h"
 #include "result.h"
 #include "priceanalysis/priceanalysismanager.h"
+#include "polling/pollscheduler.h"
+#include "pool/poolmodel.h"
+#include "utxo/utxomirror.h"
+#include "utxo/utxomodel.h"
 
 namespace {
 constexpr auto kUmbrelHomeUrl = "http://umbrel.local";
@@ -110,6 +119,12 @@ void registerAllMetaTypes()
     qRegisterMetaType<GeoLookup *>("GeoLookup*");
 
     qmlRegisterType<GrinNodeManager>("Grin", 1, 0, "GrinNodeManager");
+    qmlRegisterType<LogModel>("Grin", 1, 0, "LogModel");
+    qmlRegisterUncreatableType<CandleModel>("Grin", 1, 0, "CandleModel",
+                                            "CandleModel is provided by PriceAnalysisManager");
+    qmlRegisterType<TimeSeries>("Grin", 1, 0, "TimeSeries");
+    qmlRegisterType<ChainTimelineModel>("Grin", 1, 0, "ChainTimelineModel");
+    qmlRegisterType<UtxoModel>("Grin", 1, 0, "UtxoModel");
 
     qRegisterMetaType<QList<PoolEntry> >("QList<PoolEntry>");
     qRegisterMetaType<QList<PeerData> >("QList<PeerData>");
@@ -191,7 +206,17 @@ int main(int argc, char *argv[])
     // ------------------------------------------------------------------------------------
     NodeOwnerApi *nodeOwnerApi = new NodeOwnerApi(ownerUrl, QString(), &app);
     NodeForeignApi *nodeForeignApi = new NodeForeignApi(foreignUrl, QString());
+    // Ein JSON-RPC-Batcher pro Endpunkt, damit gleichzeitige Aufrufe aller
+    // Clients dort in einem Request landen
+    JsonRpcBatcher *ownerRpcBatcher = new JsonRpcBatcher(QUrl(ownerUrl), &app);
+    JsonRpcBatcher *foreignRpcBatcher = new JsonRpcBatcher(QUrl(foreignUrl), &app);
+    OwnerRpc *ownerRpc = new OwnerRpc(ownerRpcBatcher, &app);
+    ChainRpc *chainRpc = new ChainRpc(foreignRpcBatcher, &app);
     PriceAnalysisManager priceAnalysis;
+    PollScheduler *pollScheduler = new PollScheduler(&app);
+    UtxoMirror *utxoMirror = new UtxoMirror(foreignRpcBatcher, chainRpc, &app);
+    PoolModel *poolModel = new PoolModel(foreignRpcBatcher, &app);
+    utxoMirror->setScheduler(pollScheduler);
 
     // ------------------------------------------------------------------------------------
     // QML-Engine
@@ -201,7 +226,12 @@ int main(int argc, char *argv[])
     // Kontext-Properties
     engine.rootContext()->setContextProperty("nodeForeignApi", nodeForeignApi);
     engine.rootContext()->setContextProperty("nodeOwnerApi", nodeOwnerApi);
+    engine.rootContext()->setContextProperty("ownerRpc", ownerRpc);
+    engine.rootContext()->setContextProperty("chainRpc", chainRpc);
     engine.rootContext()->setContextProperty("priceAnalysis", &priceAnalysis);
+    engine.rootContext()->setContextProperty("pollScheduler", pollScheduler);
+    engine.rootContext()->setContextProperty("utxoMirror", utxoMirror);
+    engine.rootContext()->setContextProperty("poolModel", poolModel);
 
     Config config;
     engine.rootContext()->setContextProperty("config", &config);
@@ -0,0 +1,239 @@
+#include "pollscheduler.h"
+
+#include <QGuiApplication>
+#include <QRandomGenerator>
+#include <QStringList>
+
+namespace {
+
+const int kQuantumMs = 1000;        // Raster, auf dem fällige Topics gemeinsam feuern
+const int kSlackMs = kQuantumMs / 2; // bis so viel zu früh wird mitgenommen
+const int kJitterMs = 200;
+
+} // namespace
+
+PollScheduler::PollScheduler(QObject *parent) :
+    QObject(parent),
+    m_phaseMs(QRandomGenerator::global()->bounded(kQuantumMs))
+{
+    m_clock.start();
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &PollScheduler::tick);
+
+    // minimiert / Tab im Hintergrund (WASM): alles ruht
+    if (auto *app = qobject_cast<QGuiApplication *>(QCoreApplication::instance())) {
+        connect(app, &QGuiApplication::applicationStateChanged, this, [this](Qt::ApplicationState state) {
+            setAppVisible(state != Qt::ApplicationHidden && state != Qt::ApplicationSuspended);
+        });
+    }
+}
+
+// ---------- Anmeldung ----------
+
+void PollScheduler::subscribe(const QString &topic, QObject *owner, int freshnessMs, bool visible)
+{
+    if (topic.isEmpty() || !owner || freshnessMs <= 0) {
+        return;
+    }
+
+    Topic &t = m_topics[topic];
+    bool found = false;
+    for (Subscriber &s : t.subscribers) {
+        if (s.owner == owner) {
+            s.freshnessMs = freshnessMs;
+            s.visible = visible;
+            found = true;
+        }
+    }
+    if (!found) {
+        Subscriber s;
+        s.owner = owner;
+        s.freshnessMs = freshnessMs;
+        s.visible = visible;
+        t.subscribers.append(s);
+        watchOwner(owner);
+    }
+    reschedule();
+}
+
+void PollScheduler::setVisible(const QString &topic, QObject *owner, bool visible)
+{
+    const auto it = m_topics.find(topic);
+    if (it == m_topics.end()) {
+        return;
+    }
+    for (Subscriber &s : it->subscribers) {
+        if (s.owner == owner) {
+            s.visible = visible;
+        }
+    }
+    reschedule();
+}
+
+void PollScheduler::unsubscribe(const QString &topic, QObject *owner)
+{
+    const auto it = m_topics.find(topic);
+    if (it == m_topics.end()) {
+        return;
+    }
+    for (int i = it->subscribers.size() - 1; i >= 0; --i) {
+        if (it->subscribers.at(i).owner == owner) {
+            it->subscribers.remove(i);
+        }
+    }
+    if (it->subscribers.isEmpty()) {
+        m_topics.erase(it);
+    }
+    reschedule();
+}
+
+void PollScheduler::watchOwner(QObject *owner)
+{
+    if (m_owners.contains(owner)) {
+        return;
+    }
+    m_owners.insert(owner);
+    connect(owner, &QObject::destroyed, this, [this, owner]() {
+        removeOwner(owner);
+    });
+}
+
+void PollScheduler::removeOwner(QObject *owner)
+{
+    m_owners.remove(owner);
+    for (auto it = m_topics.begin(); it != m_topics.end();) {
+        for (int i = it->subscribers.size() - 1; i >= 0; --i) {
+            if (it->subscribers.at(i).owner == owner) {
+                it->subscribers.remove(i);
+            }
+        }
+        if (it->subscribers.isEmpty()) {
+            it = m_topics.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    reschedule();
+}
+
+void PollScheduler::pollNow(const QString &topic)
+{
+    const auto it = m_topics.find(topic);
+    if (it != m_topics.end()) {
+        it->lastPollMs = m_clock.elapsed();
+        reschedule();
+    }
+    emit poll(topic);
+}
+
+void PollScheduler::markFresh(const QString &topic)
+{
+    const auto it = m_topics.find(topic);
+    if (it == m_topics.end()) {
+        return;
+    }
+    it->lastPollMs = m_clock.elapsed();
+    reschedule();
+}
+
+void PollScheduler::setAppVisible(bool visible)
+{
+    if (m_appVisible == visible) {
+        return;
+    }
+    m_appVisible = visible;
+    emit appVisibleChanged();
+    reschedule();
+}
+
+// ---------- Takt ----------
+
+// Kürzeste Aktualität der sichtbaren Anmelder, auf das Raster aufgerundet
+int PollScheduler::intervalOf(const QString &topic) const
+{
+    const auto it = m_topics.constFind(topic);
+    return it == m_topics.constEnd() ? 0 : effectiveInterval(it.value());
+}
+
+int PollScheduler::effectiveInterval(const Topic &t) const
+{
+    if (!m_appVisible) {
+        return 0;
+    }
+    int interval = 0;
+    for (const Subscriber &s : t.subscribers) {
+        if (s.visible && (interval == 0 || s.freshnessMs < interval)) {
+            interval = s.freshnessMs;
+        }
+    }
+    if (interval == 0) {
+        return 0;
+    }
+    return qMax(1, (interval + kQuantumMs - 1) / kQuantumMs) * kQuantumMs;
+}
+
+// Fälligkeit auf m_clock, -1 = ruht
+qint64 PollScheduler::dueAt(const Topic &t) const
+{
+    const int interval = effectiveInterval(t);
+    if (interval == 0) {
+        return -1;
+    }
+    return t.lastPollMs < 0 ? 0 : t.lastPollMs + interval;
+}
+
+/**
+ * @brief PollScheduler::reschedule
+ * Stellt den Timer auf den ersten Rasterpunkt, an dem ein Topic fällig ist,
+ * plus Jitter. Ohne aktive Topics steht der Timer.
+ * Nach einer Abfrage außerhalb des Rasters (sofort, pollNow) rundet die
+ * nächste Fälligkeit wieder auf das Raster.
+ */
+void PollScheduler::reschedule()
+{
+    const qint64 now = m_clock.elapsed();
+    qint64 next = -1;
+    for (const Topic &t : m_topics) {
+        const qint64 due = dueAt(t);
+        if (due >= 0 && (next < 0 || due < next)) {
+            next = due;
+        }
+    }
+    if (next < 0) {
+        m_timer.stop();
+        return;
+    }
+
+    // veraltet (neu angemeldet, wieder sichtbar): sofort, ab dann wieder im Raster
+    if (next <= now) {
+        m_timer.start(0);
+        return;
+    }
+
+    const qint64 from = next - m_phaseMs;
+    const qint64 slot = m_phaseMs + qMax<qint64>(0, (from + kQuantumMs - 1) / kQuantumMs) * kQuantumMs;
+    const qint64 jitter = QRandomGenerator::global()->bounded(kJitterMs);
+    m_timer.start(int(qMax<qint64>(0, slot + jitter - now)));
+}
+
+void PollScheduler::tick()
+{
+    const qint64 now = m_clock.elapsed();
+    // als Zeitpunkt der Abfrage zählt der Rasterpunkt, sonst verschöbe der
+    // Jitter jede folgende Fälligkeit um ein ganzes Raster
+    const qint64 slot = now - ((now - m_phaseMs) % kQuantumMs + kQuantumMs) % kQuantumMs;
+    QStringList due;
+    for (auto it = m_topics.begin(); it != m_topics.end(); ++it) {
+        const qint64 at = dueAt(it.value());
+        if (at >= 0 && at <= now + kSlackMs) {
+            it->lastPollMs = slot;
+            due.append(it.key());
+        }
+    }
+    reschedule();
+
+    // gemeinsam, damit die Requests im selben Batch-Fenster landen
+    for (const QString &topic : due) {
+        emit poll(topic);
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef POLLSCHEDULER_H
+#define POLLSCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+// Gemeinsamer Takt für alle Abfragen der Views statt eines Timers pro Seite.
+// Views melden Topics an (subscribe) mit gewünschter Aktualität und ob sie
+// gerade sichtbar sind; mehrere Anmeldungen desselben Topics werden
+// zusammengelegt (kürzeste Aktualität der sichtbaren Anmelder gilt).
+// Topics ohne sichtbaren Anmelder ruhen, ebenso alles, solange die App
+// versteckt ist; wird ein Topic wieder sichtbar und ist veraltet, kommt es
+// im nächsten Takt dran.
+// Fällige Topics feuern gemeinsam auf einem Raster von kQuantumMs (mit
+// zufälliger Phase und etwas Jitter pro Takt), damit ihre Requests im
+// selben Moment rausgehen und sich bündeln lassen (JsonRpcBatcher).
+// Abgefragt wird über das Signal poll(topic); wer das Topic bedient,
+// entscheidet die View.
+class PollScheduler : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool appVisible READ appVisible NOTIFY appVisibleChanged)
+
+public:
+    explicit PollScheduler(QObject *parent = nullptr);
+
+    bool appVisible() const
+    {
+        return m_appVisible;
+    }
+
+    // Anmelden bzw. Aktualität/Sichtbarkeit eines Anmelders ändern; Anmelder
+    // verschwinden mit ihrem owner
+    Q_INVOKABLE void subscribe(const QString &topic, QObject *owner, int freshnessMs, bool visible = true);
+    Q_INVOKABLE void setVisible(const QString &topic, QObject *owner, bool visible);
+    Q_INVOKABLE void unsubscribe(const QString &topic, QObject *owner);
+    // Sofort abfragen (z. B. nach Benutzeraktion); zählt als Abfrage
+    Q_INVOKABLE void pollNow(const QString &topic);
+    // Daten kamen auf anderem Weg (Push, Antwort auf eigene Anfrage)
+    Q_INVOKABLE void markFresh(const QString &topic);
+    // Wirksames Intervall, 0 = ruht
+    Q_INVOKABLE int intervalOf(const QString &topic) const;
+
+signals:
+    void poll(const QString &topic);
+    void appVisibleChanged();
+
+private:
+    struct Subscriber {
+        QObject *owner = nullptr;
+        int freshnessMs = 0;
+        bool visible = true;
+    };
+
+    struct Topic {
+        QVector<Subscriber> subscribers;
+        qint64 lastPollMs = -1;     // m_clock, -1 = noch nie
+    };
+
+    int effectiveInterval(const Topic &t) const;
+    qint64 dueAt(const Topic &t) const;
+    void watchOwner(QObject *owner);
+    void removeOwner(QObject *owner);
+    void setAppVisible(bool visible);
+    void reschedule();
+    void tick();
+
+    QHash<QString, Topic> m_topics;
+    QSet<QObject *> m_owners;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_phaseMs = 0;
+    bool m_appVisible = true;
+};
+
+#endif // POLLSCHEDULER_H
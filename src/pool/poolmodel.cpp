@@ -0,0 +1,426 @@
+#include "poolmodel.h"
+
+#include "jsonrpcbatcher.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QSet>
+#include <QSharedPointer>
+#include <QStringList>
+
+namespace {
+
+// Über dem Timeout des Batchers: greift nur, wenn dessen Fehler ausbleibt
+const int kReplyTimeoutMs = 45000;
+
+// Grin-JSON und die Varianten der Foreign-API-Wrapper (camelCase, {hex})
+QJsonValue pick(const QJsonObject &o, const char *a, const char *b)
+{
+    const QJsonValue v = o.value(QLatin1String(a));
+    return v.isUndefined() || v.isNull() ? o.value(QLatin1String(b)) : v;
+}
+
+QString hexOf(const QJsonValue &v)
+{
+    if (v.isObject()) {
+        return v.toObject().value("hex").toString();
+    }
+    return v.toString();
+}
+
+qint64 toInt64(const QJsonValue &v)
+{
+    return v.toVariant().toLongLong();
+}
+
+// fee direkt oder in features {Plain: {fee}} / {HeightLocked: {fee, ...}}
+qint64 kernelFee(const QJsonObject &kernel)
+{
+    if (kernel.contains("fee")) {
+        return toInt64(kernel.value("fee"));
+    }
+    const QJsonObject features = kernel.value("features").toObject();
+    for (auto it = features.constBegin(); it != features.constEnd(); ++it) {
+        const QJsonObject inner = it.value().toObject();
+        if (inner.contains("fee")) {
+            return toInt64(inner.value("fee"));
+        }
+    }
+    return 0;
+}
+
+QString featureName(const QJsonObject &kernel)
+{
+    const QJsonValue features = kernel.value("features");
+    if (features.isObject()) {
+        const QJsonObject o = features.toObject();
+        return o.isEmpty() ? QString() : o.constBegin().key();
+    }
+    return features.toString();
+}
+
+QString normalizeSource(const QJsonValue &value)
+{
+    static const char *const kNames[] = { "PushApi", "Broadcast", "Fluff", "EmbargoExpired", "Deaggregate" };
+    if (value.isUndefined() || value.isNull()) {
+        return QString();
+    }
+    if (value.isObject()) {
+        const QJsonObject o = value.toObject();
+        return o.isEmpty() ? QString() : o.constBegin().key();
+    }
+    bool numeric = value.isDouble();
+    int n = value.toInt();
+    if (!numeric) {
+        n = value.toString().toInt(&numeric);
+    }
+    if (numeric && n >= 0 && n < 5) {
+        return QLatin1String(kNames[n]);
+    }
+    return numeric ? QString::number(n) : value.toString();
+}
+
+QStringList commitList(const QJsonArray &items)
+{
+    QStringList out;
+    for (const QJsonValue &item : items) {
+        const QString commit = hexOf(item.toObject().value("commit"));
+        if (!commit.isEmpty()) {
+            out.append(commit);
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+PoolModel::PoolModel(JsonRpcBatcher *rpc, QObject *parent) :
+    QAbstractListModel(parent),
+    m_rpc(rpc)
+{
+    m_replyTimer.setSingleShot(true);
+    m_replyTimer.setInterval(kReplyTimeoutMs);
+    connect(&m_replyTimer, &QTimer::timeout, this, &PoolModel::onReplyTimeout);
+}
+
+int PoolModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_rows.size();
+}
+
+QVariant PoolModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+
+    const Entry &e = m_rows.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case TxIdRole:
+        return e.item.value("id");
+    case FeeRole:
+        return e.item.value("fee");
+    case InputsRole:
+        return e.item.value("inputs");
+    case OutputsRole:
+        return e.item.value("outputs");
+    case KernelsRole:
+        return e.item.value("kernels");
+    case TxAtRole:
+        return e.item.value("txAt");
+    case SourceRole:
+        return e.item.value("source");
+    case FirstSeenRole:
+        return e.firstSeen;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> PoolModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[TxIdRole] = "txId";
+    roles[FeeRole] = "fee";
+    roles[InputsRole] = "inputs";
+    roles[OutputsRole] = "outputs";
+    roles[KernelsRole] = "kernels";
+    roles[TxAtRole] = "txAt";
+    roles[SourceRole] = "source";
+    roles[FirstSeenRole] = "firstSeen";
+    return roles;
+}
+
+QVariantMap PoolModel::get(int row) const
+{
+    if (row < 0 || row >= m_rows.size()) {
+        return QVariantMap();
+    }
+    QVariantMap item = m_rows.at(row).item;
+    item["observedAt"] = QDateTime::fromMSecsSinceEpoch(m_rows.at(row).firstSeen).toUTC().toString(Qt::ISODateWithMs);
+    return item;
+}
+
+// ---------- Abruf ----------
+
+/**
+ * @brief PoolModel::refresh
+ * get_pool_size, get_stempool_size und get_unconfirmed_transactions gehen
+ * als ein Batch raus. Eine fehlgeschlagene Größe lässt den alten Wert
+ * stehen; nur ein Fehler bei den Transaktionen meldet refreshFailed.
+ */
+void PoolModel::refresh()
+{
+    if (m_busy) {
+        return;
+    }
+    setBusy(true);
+
+    struct Pending {
+        int remaining = 3;
+        bool sizesChanged = false;
+    };
+    QSharedPointer<Pending> pending(new Pending);
+    const int generation = m_generation;
+
+    auto finish = [this, pending, generation]() {
+        if (--pending->remaining > 0 || generation != m_generation) {
+            return;
+        }
+        m_replyTimer.stop();
+        m_calls.clear();
+        if (pending->sizesChanged) {
+            emit sizesChanged();
+        }
+        setBusy(false);
+    };
+    auto sizeInto = [this, pending, generation, finish](int *target) {
+        return [this, pending, generation, finish, target](const QJsonObject &response, const QString &error) {
+            QString err = error;
+            const QJsonValue size = err.isEmpty() ? JsonRpcBatcher::okResult(response, &err) : QJsonValue();
+            if (generation == m_generation && err.isEmpty() && *target != size.toInt()) {
+                *target = size.toInt();
+                pending->sizesChanged = true;
+            }
+            finish();
+        };
+    };
+
+    // Ohne eigene Gruppe: das Batch-Fenster bündelt die drei Aufrufe, und ein
+    // direkt folgender Tip-Abruf (ChainRpc::refreshTipAsync) nimmt sie mit
+    m_calls.append(m_rpc->call("get_pool_size", QJsonArray(), sizeInto(&m_poolSize)));
+    m_calls.append(m_rpc->call("get_stempool_size", QJsonArray(), sizeInto(&m_stempoolSize)));
+    m_calls.append(m_rpc->call("get_unconfirmed_transactions", QJsonArray(), [this, generation, finish](const QJsonObject &response, const QString &error) {
+        QString err = error;
+        const QJsonValue txs = err.isEmpty() ? JsonRpcBatcher::okResult(response, &err) : QJsonValue();
+        if (generation == m_generation) {
+            if (err.isEmpty()) {
+                applySnapshot(txs.toArray());
+            } else {
+                emit refreshFailed(err);
+            }
+        }
+        finish();
+    }));
+    m_replyTimer.start();
+}
+
+void PoolModel::clear()
+{
+    ++m_generation;
+    cancelCalls();
+    setBusy(false);
+    if (!m_rows.isEmpty()) {
+        beginResetModel();
+        m_rows.clear();
+        m_rowOf.clear();
+        endResetModel();
+        emit countChanged();
+    }
+    if (m_poolSize != 0 || m_stempoolSize != 0) {
+        m_poolSize = 0;
+        m_stempoolSize = 0;
+        emit sizesChanged();
+    }
+}
+
+// Laufenden Abruf verwerfen; seine Callbacks kommen nicht mehr
+void PoolModel::cancelCalls()
+{
+    m_replyTimer.stop();
+    for (int id : m_calls) {
+        m_rpc->cancel(id);
+    }
+    m_calls.clear();
+}
+
+void PoolModel::onReplyTimeout()
+{
+    ++m_generation;
+    cancelCalls();
+    setBusy(false);
+    emit refreshFailed(QStringLiteral("pool refresh timed out after %1 s").arg(kReplyTimeoutMs / 1000));
+}
+
+void PoolModel::setBusy(bool busy)
+{
+    if (m_busy == busy) {
+        return;
+    }
+    m_busy = busy;
+    emit busyChanged();
+}
+
+// ---------- Abgleich ----------
+
+/**
+ * @brief PoolModel::applySnapshot
+ * Entfernt verschwundene Zeilen in zusammenhängenden Blöcken (von hinten,
+ * damit die Zeilennummern gültig bleiben) und hängt neue Transaktionen
+ * hinten an. Unveränderte Zeilen lösen kein Signal aus.
+ */
+void PoolModel::applySnapshot(const QJsonArray &transactions)
+{
+    QSet<QByteArray> seen;
+    seen.reserve(transactions.size());
+    QVector<Entry> added;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    for (int i = 0; i < transactions.size(); ++i) {
+        const QJsonObject entry = transactions.at(i).toObject();
+        const QByteArray key = keyOf(entry);
+        if (seen.contains(key)) {
+            continue;
+        }
+        seen.insert(key);
+        if (!m_rowOf.contains(key)) {
+            added.append(Entry{ key, mapEntry(entry, i), now });
+        }
+    }
+
+    bool removed = false;
+    for (int row = m_rows.size() - 1; row >= 0;) {
+        if (seen.contains(m_rows.at(row).key)) {
+            --row;
+            continue;
+        }
+        const int last = row;
+        while (row >= 0 && !seen.contains(m_rows.at(row).key)) {
+            --row;
+        }
+        beginRemoveRows(QModelIndex(), row + 1, last);
+        m_rows.remove(row + 1, last - row);
+        endRemoveRows();
+        removed = true;
+    }
+    if (removed) {
+        m_rowOf.clear();
+        for (int row = 0; row < m_rows.size(); ++row) {
+            m_rowOf.insert(m_rows.at(row).key, row);
+        }
+    }
+
+    if (!added.isEmpty()) {
+        const int first = m_rows.size();
+        beginInsertRows(QModelIndex(), first, first + added.size() - 1);
+        for (const Entry &e : added) {
+            m_rowOf.insert(e.key, m_rows.size());
+            m_rows.append(e);
+        }
+        endInsertRows();
+
+        QVariantList items;
+        items.reserve(added.size());
+        for (int row = first; row < m_rows.size(); ++row) {
+            items.append(get(row));
+        }
+        emit transactionsAdded(items);
+    }
+
+    if (removed || !added.isEmpty()) {
+        emit countChanged();
+    }
+}
+
+// Kernel-Excesses identifizieren eine Transaktion; ohne Kernel der Inhalt
+QByteArray PoolModel::keyOf(const QJsonObject &entry)
+{
+    const QJsonObject tx = entry.value("tx").toObject();
+    const QJsonArray kernels = tx.value("body").toObject().value("kernels").toArray();
+    QByteArray key;
+    for (const QJsonValue &kernel : kernels) {
+        key += hexOf(kernel.toObject().value("excess")).toLatin1();
+        key += ',';
+    }
+    if (!key.isEmpty()) {
+        return key;
+    }
+    return QCryptographicHash::hash(QJsonDocument(entry).toJson(QJsonDocument::Compact), QCryptographicHash::Sha1);
+}
+
+// Felder wie bisher in Transaction.qml (mapPoolEntries)
+QVariantMap PoolModel::mapEntry(const QJsonObject &entry, int fallbackIndex)
+{
+    const QJsonObject tx = entry.value("tx").toObject();
+    const QJsonObject body = tx.value("body").toObject();
+    const QJsonArray inputs = body.value("inputs").toArray();
+    const QJsonArray outputs = body.value("outputs").toArray();
+    const QJsonArray kernels = body.value("kernels").toArray();
+
+    qint64 fee = toInt64(tx.value("fee"));
+    if (fee <= 0) {
+        fee = toInt64(entry.value("fee"));
+    }
+    QStringList excesses;
+    QStringList signatures;
+    QStringList features;
+    qint64 kernelFees = 0;
+    for (const QJsonValue &v : kernels) {
+        const QJsonObject kernel = v.toObject();
+        const QString excess = hexOf(kernel.value("excess"));
+        if (!excess.isEmpty()) {
+            excesses.append(excess);
+        }
+        const QString signature = hexOf(pick(kernel, "excess_sig", "excessSig"));
+        if (!signature.isEmpty()) {
+            signatures.append(signature);
+        }
+        const QString feature = featureName(kernel);
+        if (!feature.isEmpty()) {
+            features.append(feature);
+        }
+        kernelFees += kernelFee(kernel);
+    }
+    if (fee <= 0) {
+        fee = kernelFees;
+    }
+
+    QString id = pick(entry, "id", "tx_id").toString();
+    if (id.isEmpty()) {
+        id = pick(tx, "txId", "tx_id").toString();
+    }
+    if (id.isEmpty()) {
+        id = excesses.isEmpty() ? QStringLiteral("tx-%1").arg(fallbackIndex) : excesses.first();
+    }
+
+    QVariantMap item;
+    item["id"] = id;
+    item["fee"] = double(fee);
+    item["inputs"] = inputs.isEmpty() ? entry.value("inputs").toInt() : inputs.size();
+    item["outputs"] = outputs.isEmpty() ? entry.value("outputs").toInt() : outputs.size();
+    item["kernels"] = kernels.isEmpty() ? entry.value("kernels").toInt() : kernels.size();
+    item["txAt"] = pick(entry, "tx_at", "txAt").toString();
+    item["source"] = normalizeSource(entry.value("src"));
+    item["offset"] = hexOf(tx.value("offset"));
+    item["kernelExcesses"] = excesses;
+    item["kernelSignatures"] = signatures;
+    item["kernelFeatures"] = features;
+    item["inputCommits"] = commitList(inputs);
+    item["outputCommits"] = commitList(outputs);
+    return item;
+}
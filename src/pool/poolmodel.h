@@ -0,0 +1,108 @@
+#ifndef POOLMODEL_H
+#define POOLMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+
+class JsonRpcBatcher;
+
+// Transaktionen im Mempool für Transaction.qml.
+// refresh() holt Pool-, Stempool-Größe und get_unconfirmed_transactions in
+// einem Batch. Jede Transaktion ist über ihre Kernel-Excesses identifiziert;
+// der neue Stand wird gegen den alten abgeglichen, das Modell meldet nur
+// entfernte und neue Zeilen. Bestehende Zeilen behalten Position und
+// firstSeen (Alter), gemappt werden nur neue Einträge.
+// Läuft über den geteilten Batcher von v2/foreign (Endpunkt und Auth folgen
+// dem Controller). Bleibt eine Antwort aus, gibt ein eigener Timeout den
+// Abruf nach kReplyTimeoutMs frei.
+class PoolModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int poolSize READ poolSize NOTIFY sizesChanged)
+    Q_PROPERTY(int stempoolSize READ stempoolSize NOTIFY sizesChanged)
+    Q_PROPERTY(bool busy READ busy NOTIFY busyChanged)
+public:
+    enum Roles {
+        TxIdRole = Qt::UserRole + 1,
+        FeeRole,
+        InputsRole,
+        OutputsRole,
+        KernelsRole,
+        TxAtRole,
+        SourceRole,
+        FirstSeenRole
+    };
+
+    // rpc: Batcher für v2/foreign, geteilt mit den anderen Clients dort
+    explicit PoolModel(JsonRpcBatcher *rpc, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Größen und Transaktionen in einem Round-Trip; läuft schon einer, entfällt der Aufruf
+    Q_INVOKABLE void refresh();
+    // Node gestoppt: alles leeren, laufende Antworten verwerfen
+    Q_INVOKABLE void clear();
+    // Eintrag wie im Verlauf (id, fee, ..., kernelExcesses, observedAt)
+    Q_INVOKABLE QVariantMap get(int row) const;
+
+    int count() const
+    {
+        return m_rows.size();
+    }
+    int poolSize() const
+    {
+        return m_poolSize;
+    }
+    int stempoolSize() const
+    {
+        return m_stempoolSize;
+    }
+    bool busy() const
+    {
+        return m_busy;
+    }
+
+signals:
+    void countChanged();
+    void sizesChanged();
+    void busyChanged();
+    // Neu aufgetauchte Einträge (für den Verlauf)
+    void transactionsAdded(const QVariantList &added);
+    void refreshFailed(const QString &message);
+
+private:
+    struct Entry {
+        QByteArray key;
+        QVariantMap item;
+        qint64 firstSeen = 0;
+    };
+
+    void applySnapshot(const QJsonArray &transactions);
+    void setBusy(bool busy);
+    void cancelCalls();
+    void onReplyTimeout();
+    static QByteArray keyOf(const QJsonObject &entry);
+    static QVariantMap mapEntry(const QJsonObject &entry, int fallbackIndex);
+
+    JsonRpcBatcher *m_rpc;
+    QVector<Entry> m_rows;
+    QHash<QByteArray, int> m_rowOf;     // key -> Zeile
+    int m_poolSize = 0;
+    int m_stempoolSize = 0;
+    bool m_busy = false;
+    int m_generation = 0;
+    QVector<int> m_calls;               // JSON-RPC-ids des laufenden Abrufs
+    QTimer m_replyTimer;
+};
+
+#endif // POOLMODEL_H
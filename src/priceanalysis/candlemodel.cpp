@@ -0,0 +1,80 @@
+#include "candlemodel.h"
+
+#include <algorithm>
+
+CandleModel::CandleModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int CandleModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_candles.size();
+}
+
+int CandleModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : int(ColumnCount);
+}
+
+QVariant CandleModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_candles.size())
+        return QVariant();
+
+    const Candle &c = m_candles.at(index.row());
+
+    // Spalten (Display) für den Mapper, Rollen für QML-Delegates
+    int field = -1;
+    if (role == Qt::DisplayRole || role == Qt::EditRole)
+        field = index.column();
+    else if (role >= TimestampRole && role <= VolumeRole)
+        field = role - TimestampRole;
+
+    switch (field) {
+    case TimestampColumn: return double(c.timestamp);
+    case OpenColumn: return c.open;
+    case HighColumn: return c.high;
+    case LowColumn: return c.low;
+    case CloseColumn: return c.close;
+    case VolumeColumn: return c.volume;
+    default: return QVariant();
+    }
+}
+
+QHash<int, QByteArray> CandleModel::roleNames() const
+{
+    QHash<int, QByteArray> roles = QAbstractTableModel::roleNames();
+    roles.insert(TimestampRole, "timestamp");
+    roles.insert(OpenRole, "open");
+    roles.insert(HighRole, "high");
+    roles.insert(LowRole, "low");
+    roles.insert(CloseRole, "close");
+    roles.insert(VolumeRole, "volume");
+    return roles;
+}
+
+void CandleModel::setCandles(const QVector<Candle> &candles)
+{
+    const int oldCount = m_candles.size();
+
+    beginResetModel();
+    m_candles = candles;
+    endResetModel();
+
+    m_minTs = m_maxTs = m_minPrice = m_maxPrice = 0.0;
+    if (!m_candles.isEmpty()) {
+        m_minTs = double(m_candles.first().timestamp);
+        m_maxTs = double(m_candles.last().timestamp);
+        m_minPrice = m_candles.first().low;
+        m_maxPrice = m_candles.first().high;
+        for (const Candle &c : m_candles) {
+            m_minPrice = std::min(m_minPrice, c.low);
+            m_maxPrice = std::max(m_maxPrice, c.high);
+        }
+    }
+
+    if (oldCount != m_candles.size())
+        emit countChanged();
+    emit rangeChanged();
+}
@@ -0,0 +1,94 @@
+#ifndef CANDLEMODEL_H
+#define CANDLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+
+// Fertig aggregierte OHLC-Kerzen für den Preis-Chart.
+// Tabelle statt Liste, damit HCandlestickModelMapper die Spalten direkt
+// auf eine CandlestickSeries abbilden kann; Rollen für ListView/Repeater.
+class CandleModel : public QAbstractTableModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(double minTimestamp READ minTimestamp NOTIFY rangeChanged)
+    Q_PROPERTY(double maxTimestamp READ maxTimestamp NOTIFY rangeChanged)
+    Q_PROPERTY(double minPrice READ minPrice NOTIFY rangeChanged)
+    Q_PROPERTY(double maxPrice READ maxPrice NOTIFY rangeChanged)
+public:
+    struct Candle {
+        qint64 timestamp;   // Beginn des Buckets, ms seit Epoch
+        double open;
+        double high;
+        double low;
+        double close;
+        double volume;
+    };
+
+    enum Column {
+        TimestampColumn = 0,
+        OpenColumn,
+        HighColumn,
+        LowColumn,
+        CloseColumn,
+        VolumeColumn,
+        ColumnCount
+    };
+    Q_ENUM(Column)
+
+    enum Roles {
+        TimestampRole = Qt::UserRole + 1,
+        OpenRole,
+        HighRole,
+        LowRole,
+        CloseRole,
+        VolumeRole
+    };
+
+    explicit CandleModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    void setCandles(const QVector<Candle> &candles);
+    const QVector<Candle> &candles() const
+    {
+        return m_candles;
+    }
+
+    int count() const
+    {
+        return m_candles.size();
+    }
+    double minTimestamp() const
+    {
+        return m_minTs;
+    }
+    double maxTimestamp() const
+    {
+        return m_maxTs;
+    }
+    double minPrice() const
+    {
+        return m_minPrice;
+    }
+    double maxPrice() const
+    {
+        return m_maxPrice;
+    }
+
+signals:
+    void countChanged();
+    void rangeChanged();
+
+private:
+    QVector<Candle> m_candles;
+    double m_minTs = 0.0;
+    double m_maxTs = 0.0;
+    double m_minPrice = 0.0;
+    double m_maxPrice = 0.0;
+};
+
+#endif // CANDLEMODEL_H
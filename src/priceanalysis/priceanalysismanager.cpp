@@ -10,10 +10,17 @@
 #include <QUrlQuery>
 #include <QDateTime>
 #include <QtGlobal>
+#include <QQmlEngine>
+#include <QRegularExpression>
+#include <algorithm>
+#include <cstring>
 #include <limits>
 
 namespace {
 static const int kHistoryTailCount = 7;
+static const qint64 kHourMs = 60LL * 60 * 1000;
+static const qint64 kDayMs = 24 * kHourMs;
+static const char kStoreMagic[8] = { 'G', 'R', 'N', 'P', 'R', 'C', 0, 1 };
 
 QVariantMap defaultApiConfig()
 {
@@ -25,12 +32,33 @@ QVariantMap defaultApiConfig()
     map.insert("days", QStringLiteral("20"));
     return map;
 }
+
+// ETag-Schlüssel ohne das mitlaufende to, sonst passt If-None-Match nie
+QUrl etagKey(const QUrl &url)
+{
+    QUrlQuery query(url);
+    query.removeAllQueryItems(QStringLiteral("to"));
+    QUrl key(url);
+    key.setQuery(query);
+    return key;
+}
 }
 
 PriceAnalysisManager::PriceAnalysisManager(QObject *parent)
     : QObject(parent)
+    , m_priceSeries(new TimeSeries(this))
+    , m_candles(new CandleModel(this))
     , m_apiConfig(defaultApiConfig())
+    , m_store("PriceAnalysisManager")
 {
+    // Rückgabe aus ohlc() darf nicht vom JS-GC eingesammelt werden
+    QQmlEngine::setObjectOwnership(m_candles, QQmlEngine::CppOwnership);
+    QQmlEngine::setObjectOwnership(m_priceSeries, QQmlEngine::CppOwnership);
+    // m_volumes läuft parallel zur Reihe, QML darf sie nur lesen
+    m_priceSeries->setReadOnly(true);
+
+    // Gespeicherte Historie sofort verfügbar, das Netz liefert nur den Rest
+    loadStore();
     refresh();
 }
 
@@ -39,6 +67,16 @@ void PriceAnalysisManager::refresh()
     if (m_loading)
         return;
 
+    // Cache-Control: max-age der letzten Antwort noch nicht abgelaufen
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if (now < m_freshUntilMs)
+        return;
+
+    // stündliche Historie: vor Beginn der nächsten Stunde kommt nichts dazu
+    const SeriesPyramid &series = m_priceSeries->pyramid();
+    if (!series.isEmpty() && now < (series.timestamps().last() / kHourMs + 1) * kHourMs)
+        return;
+
     m_loading = true;
     emit loadingChanged();
     setError(QString());
@@ -51,9 +89,11 @@ void PriceAnalysisManager::refresh()
     if (!apiKey.isEmpty()) {
         request.setRawHeader("x-cg-pro-api-key", apiKey.toUtf8());
     }
+    if (!m_etag.isEmpty() && m_etagUrl == etagKey(url))
+        request.setRawHeader("If-None-Match", m_etag);
 
     QNetworkReply *reply = m_network.get(request);
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+    connect(reply, &QNetworkReply::finished, this, [this, reply, url]() {
         reply->deleteLater();
 
         m_loading = false;
@@ -64,6 +104,18 @@ void PriceAnalysisManager::refresh()
             return;
         }
 
+        static const QRegularExpression maxAgeRe(QStringLiteral("max-age=(\\d+)"));
+        const QRegularExpressionMatch maxAge = maxAgeRe.match(QString::fromLatin1(reply->rawHeader("Cache-Control")));
+        m_freshUntilMs = maxAge.hasMatch()
+                ? QDateTime::currentMSecsSinceEpoch() + maxAge.captured(1).toLongLong() * 1000
+                : 0;
+
+        // 304: nichts Neues seit der letzten Antwort
+        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 304)
+            return;
+
+        m_etag = reply->rawHeader("ETag");
+        m_etagUrl = etagKey(url);
         parseResponse(reply->readAll());
     });
 }
@@ -80,19 +132,18 @@ void PriceAnalysisManager::parseResponse(const QByteArray &data)
     QJsonObject root = doc.object();
     QJsonArray prices = root.value("prices").toArray();
     if (prices.isEmpty()) {
-        setError(tr("price_err_no_data", "No price data available."));
+        // inkrementeller Abruf ohne neue Punkte ist kein Fehler
+        if (m_priceSeries->count() == 0)
+            setError(tr("price_err_no_data", "No price data available."));
         return;
     }
 
-    m_history.clear();
-    m_recentHistory.clear();
-    m_highestPriceUsd = 0.0;
-    m_lowestPriceUsd = std::numeric_limits<double>::max();
-    m_latestPriceUsd = 0.0;
-    m_latestTimestamp.clear();
-    m_latestVolumeUsd = 0.0;
+    QJsonArray volumes = root.value("total_volumes").toArray();
+    QVector<PricePoint> points;
+    points.reserve(prices.size());
 
-    for (const QJsonValue &entry : prices) {
+    for (int i = 0; i < prices.size(); ++i) {
+        const QJsonValue entry = prices.at(i);
         if (!entry.isArray())
             continue;
 
@@ -100,51 +151,265 @@ void PriceAnalysisManager::parseResponse(const QByteArray &data)
         if (pair.size() < 2)
             continue;
 
-        qint64 timestamp = static_cast<qint64>(pair.at(0).toDouble());
-        double price = pair.at(1).toDouble();
+        PricePoint p;
+        p.timestamp = static_cast<qint64>(pair.at(0).toDouble());
+        p.price = pair.at(1).toDouble();
+        p.volume = 0.0;
 
-        QVariantMap row;
-        row["price"] = price;
-        QDateTime dt = QDateTime::fromMSecsSinceEpoch(timestamp).toUTC();
-        row["timestamp"] = dt.toString(Qt::ISODate);
+        // total_volumes hat dieselben Zeitpunkte wie prices
+        QJsonArray volumePair = volumes.at(i).toArray();
+        if (volumePair.size() >= 2 && static_cast<qint64>(volumePair.at(0).toDouble()) == p.timestamp)
+            p.volume = volumePair.at(1).toDouble();
 
-        m_history.append(row);
+        points.append(p);
+    }
 
-        m_highestPriceUsd = qMax(m_highestPriceUsd, price);
-        if (price < m_lowestPriceUsd)
-            m_lowestPriceUsd = price;
+    if (points.isEmpty() && m_priceSeries->count() == 0) {
+        setError(tr("price_err_no_data", "No price data available."));
+        return;
     }
 
-    if (!m_history.isEmpty()) {
-        QVariantMap latest = m_history.last().toMap();
-        m_latestPriceUsd = latest.value("price").toDouble();
-        m_latestTimestamp = latest.value("timestamp").toString();
+    std::stable_sort(points.begin(), points.end(), [](const PricePoint &a, const PricePoint &b) {
+        return a.timestamp < b.timestamp;
+    });
+    mergePoints(points);
+}
 
-        QJsonArray volumes = root.value("total_volumes").toArray();
-        if (!volumes.isEmpty()) {
-            QJsonArray latestVolumePair = volumes.last().toArray();
-            if (latestVolumePair.size() >= 2)
-                m_latestVolumeUsd = latestVolumePair.at(1).toDouble();
-        }
-    } else {
-        m_lowestPriceUsd = 0.0;
-        setError(tr("price_err_no_data", "No price data available."));
+// Nur Punkte hinter der Stunde des letzten gespeicherten Zeitpunkts kommen
+// dazu, je Stunde der letzte: kurze /range-Abfragen liefern 5-Minuten-Punkte,
+// die Historie bleibt trotzdem stündlich
+void PriceAnalysisManager::mergePoints(const QVector<PricePoint> &points)
+{
+    const SeriesPyramid &series = m_priceSeries->pyramid();
+    const bool initial = series.isEmpty();
+    const qint64 lastHour = initial ? std::numeric_limits<qint64>::min() : series.timestamps().last() / kHourMs;
+
+    QVector<PricePoint> fresh;
+    fresh.reserve(points.size());
+    for (const PricePoint &p : points) {
+        const qint64 hour = p.timestamp / kHourMs;
+        if (hour <= lastHour)
+            continue;
+        if (!fresh.isEmpty() && fresh.last().timestamp / kHourMs == hour)
+            fresh.last() = p;
+        else
+            fresh.append(p);
+    }
+    if (fresh.isEmpty())
         return;
+
+    QVector<SeriesPyramid::Sample> samples;
+    samples.reserve(fresh.size());
+    for (const PricePoint &p : fresh) {
+        samples.append(SeriesPyramid::Sample{ p.timestamp, p.price });
+        m_volumes.append(p.volume);
     }
+    m_priceSeries->appendSamples(samples);
+    if (pruneToWindow())
+        writeStore(storedPoints(), false);
+    else
+        writeStore(fresh, !initial);
 
-    rebuildRecentHistory();
+    updateDerivedStats();
+    emit historyChanged();
+}
+
+// --- Persistenz ------------------------------------------------------
+
+QString PriceAnalysisManager::storeKey() const
+{
+    return QStringLiteral("price-%1-%2")
+            .arg(m_apiConfig.value("coinId", QStringLiteral("grin")).toString(),
+                 m_apiConfig.value("vsCurrency", QStringLiteral("usd")).toString());
+}
+
+// Append-Log (Magic + 24-Byte-Records) je Paar; neue Stunden werden
+// angehängt, nur nach dem Kürzen auf das days-Fenster wird neu geschrieben
+void PriceAnalysisManager::loadStore()
+{
+    m_priceSeries->setSamples({});
+    m_volumes.clear();
+
+    m_store.open(storeKey() + ".bin", "price/" + storeKey(), [this](const uchar *data, qint64 size) {
+        parseStore(data, size);
+    });
+    if (pruneToWindow())
+        writeStore(storedPoints(), false);
+
+    updateDerivedStats();
     emit historyChanged();
 }
 
+void PriceAnalysisManager::parseStore(const uchar *data, qint64 size)
+{
+    if (size < qint64(sizeof(kStoreMagic)) || std::memcmp(data, kStoreMagic, sizeof(kStoreMagic)) != 0)
+        return;
+
+    const int count = int((size - qint64(sizeof(kStoreMagic))) / qint64(sizeof(PricePoint)));
+    QVector<SeriesPyramid::Sample> samples;
+    samples.reserve(count);
+    m_volumes.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        PricePoint p;
+        std::memcpy(&p, data + sizeof(kStoreMagic) + size_t(i) * sizeof(PricePoint), sizeof(PricePoint));
+        if (!samples.isEmpty() && p.timestamp <= samples.last().timestamp)
+            continue;
+        samples.append(SeriesPyramid::Sample{ p.timestamp, p.price });
+        m_volumes.append(p.volume);
+    }
+    m_priceSeries->appendSamples(samples);
+}
+
+// append: nur die neuen Records anhängen; sonst (oder bei leerem/fremdem
+// Inhalt) atomar den ganzen Bestand schreiben
+void PriceAnalysisManager::writeStore(const QVector<PricePoint> &points, bool append)
+{
+    const QByteArray records(reinterpret_cast<const char *>(points.constData()),
+                             points.size() * int(sizeof(PricePoint)));
+
+    if (append && m_store.size() > qint64(sizeof(kStoreMagic)))
+        m_store.append(records);
+    else
+        m_store.rewrite(QByteArray(kStoreMagic, sizeof(kStoreMagic)) + records);
+}
+
+// Punkte vor dem days-Fenster verwerfen; erst ab einem Tag Überhang, damit
+// nicht jede neue Stunde den Speicher neu schreibt
+bool PriceAnalysisManager::pruneToWindow()
+{
+    const qint64 days = m_apiConfig.value("days").toString().toLongLong();
+    const SeriesPyramid &series = m_priceSeries->pyramid();
+    if (days <= 0 || series.isEmpty())
+        return false;
+
+    const qint64 cutoff = series.timestamps().last() - days * kDayMs;
+    if (series.timestamps().first() >= cutoff - kDayMs)
+        return false;
+
+    const int first = series.indexRange(cutoff, series.timestamps().last()).first;
+    QVector<SeriesPyramid::Sample> samples;
+    samples.reserve(series.size() - first);
+    for (int i = first; i < series.size(); ++i)
+        samples.append(SeriesPyramid::Sample{ series.timestamps().at(i), series.values().at(i) });
+    m_volumes.remove(0, first);
+    m_priceSeries->setSamples(samples);
+    return true;
+}
+
+QVector<PriceAnalysisManager::PricePoint> PriceAnalysisManager::storedPoints() const
+{
+    const SeriesPyramid &series = m_priceSeries->pyramid();
+    QVector<PricePoint> points;
+    points.reserve(series.size());
+    for (int i = 0; i < series.size(); ++i)
+        points.append(PricePoint{ series.timestamps().at(i), series.values().at(i), m_volumes.value(i) });
+    return points;
+}
+
+// Kennzahlen, Tail und Cache nach jeder Änderung der Spalten
+void PriceAnalysisManager::updateDerivedStats()
+{
+    m_historyCacheValid = false;
+    m_historyCache.clear();
+
+    m_highestPriceUsd = 0.0;
+    m_lowestPriceUsd = 0.0;
+    m_latestPriceUsd = 0.0;
+    m_latestTimestamp.clear();
+    m_latestVolumeUsd = 0.0;
+    m_dailyHighPriceUsd = 0.0;
+    m_dailyLowPriceUsd = 0.0;
+
+    const SeriesPyramid &series = m_priceSeries->pyramid();
+    if (series.isEmpty()) {
+        rebuildRecentHistory();
+        return;
+    }
+
+    // Min/Max über die Detailstufen statt über alle Punkte
+    const QVector<double> &prices = series.values();
+    int lo = 0;
+    int hi = 0;
+    series.rangeMinMax(0, series.size(), &lo, &hi);
+    m_lowestPriceUsd = prices.at(lo);
+    m_highestPriceUsd = prices.at(hi);
+
+    const int last = series.size() - 1;
+    const qint64 lastTs = series.timestamps().at(last);
+    m_latestPriceUsd = prices.at(last);
+    m_latestTimestamp = QDateTime::fromMSecsSinceEpoch(lastTs).toUTC().toString(Qt::ISODate);
+    m_latestVolumeUsd = m_volumes.value(last);
+
+    // letzte 24 h vor dem jüngsten Punkt
+    const QPair<int, int> day = series.indexRange(lastTs - kDayMs, lastTs);
+    series.rangeMinMax(day.first, day.second, &lo, &hi);
+    m_dailyLowPriceUsd = prices.at(lo);
+    m_dailyHighPriceUsd = prices.at(hi);
+
+    rebuildRecentHistory();
+}
+
+QVariantMap PriceAnalysisManager::pointToVariant(qint64 timestamp, double price)
+{
+    QVariantMap row;
+    row["price"] = price;
+    row["timestamp"] = QDateTime::fromMSecsSinceEpoch(timestamp).toUTC().toString(Qt::ISODate);
+    return row;
+}
+
+// Kompatibilität: komplette Historie als {price, timestamp}-Liste, erst bei Bedarf
+QVariantList PriceAnalysisManager::history() const
+{
+    if (!m_historyCacheValid) {
+        const SeriesPyramid &series = m_priceSeries->pyramid();
+        m_historyCache.clear();
+        m_historyCache.reserve(series.size());
+        for (int i = 0; i < series.size(); ++i)
+            m_historyCache.append(pointToVariant(series.timestamps().at(i), series.values().at(i)));
+        m_historyCacheValid = true;
+    }
+    return m_historyCache;
+}
+
 void PriceAnalysisManager::rebuildRecentHistory()
 {
+    const SeriesPyramid &series = m_priceSeries->pyramid();
     m_recentHistory.clear();
-    int start = qMax(0, m_history.count() - kHistoryTailCount);
-    for (int i = start; i < m_history.count(); ++i) {
-        m_recentHistory.append(m_history.at(i));
+    int start = qMax(0, series.size() - kHistoryTailCount);
+    for (int i = start; i < series.size(); ++i) {
+        m_recentHistory.append(pointToVariant(series.timestamps().at(i), series.values().at(i)));
     }
 }
 
+CandleModel *PriceAnalysisManager::ohlc(int bucketCount, double from, double to)
+{
+    QVector<CandleModel::Candle> out;
+    const SeriesPyramid &series = m_priceSeries->pyramid();
+
+    if (bucketCount > 0 && !series.isEmpty()) {
+        const qint64 first = from > 0 ? static_cast<qint64>(from) : series.timestamps().first();
+        const qint64 last = to > 0 ? static_cast<qint64>(to) : series.timestamps().last();
+        const QPair<int, int> r = series.indexRange(first, last);
+
+        if (r.first < r.second) {
+            // Buckets ab dem ersten Punkt, mindestens ein Tag Spannweite;
+            // High/Low je Kerze aus der Pyramide, Aufwand ~ Anzahl Kerzen
+            const qint64 origin = series.timestamps().at(r.first);
+            const qint64 range = qMax(last - origin, kDayMs);
+            const qint64 bucketMs = qMax<qint64>(1, range / bucketCount);
+            const QVector<SeriesPyramid::Bucket> buckets = series.buckets(origin, last, bucketMs);
+            out.reserve(buckets.size());
+            for (const SeriesPyramid::Bucket &b : buckets)
+                out.append(CandleModel::Candle{ b.timestamp, b.open, b.high, b.low, b.close, m_volumes.value(b.lastIndex) });
+            if (out.size() > bucketCount)
+                out.remove(0, out.size() - bucketCount);
+        }
+    }
+
+    m_candles->setCandles(out);
+    return m_candles;
+}
+
 void PriceAnalysisManager::setError(const QString &message)
 {
     if (m_errorString == message)
@@ -173,8 +438,16 @@ void PriceAnalysisManager::setApiConfig(const QVariantMap &config)
     if (!changed)
         return;
 
+    const QString oldKey = storeKey();
     m_apiConfig = next;
     emit apiConfigChanged();
+
+    // anderes Paar (coinId/vsCurrency): eigene gespeicherte Historie
+    if (storeKey() != oldKey) {
+        m_etag.clear();
+        m_freshUntilMs = 0;
+        loadStore();
+    }
 }
 
 QUrl PriceAnalysisManager::buildRequestUrl() const
@@ -184,22 +457,38 @@ QUrl PriceAnalysisManager::buildRequestUrl() const
     QString coinId = cfg.value("coinId", QStringLiteral("grin")).toString();
     QString endpoint = cfg.value("endpoint", QStringLiteral("market_chart")).toString();
 
+    // m_apiConfig startet mit defaultApiConfig(), days ist also immer gesetzt
+    // und dasselbe Fenster, auf das pruneToWindow() kürzt
+    QString days = cfg.value("days").toString();
+
+    // Gespeicherte Historie deckt das Fenster ab: nur den Rest nachladen
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const QVector<qint64> &stored = m_priceSeries->pyramid().timestamps();
+    const bool incremental = endpoint == QLatin1String("market_chart") && !stored.isEmpty()
+            && now - stored.last() < days.toLongLong() * kDayMs;
+
     QUrl url(QUrl::fromUserInput(baseUrl));
     QString path = url.path();
     if (!path.endsWith('/'))
         path += '/';
     path += QStringLiteral("coins/%1/%2").arg(coinId, endpoint);
+    if (incremental)
+        path += QStringLiteral("/range");
     url.setPath(path);
 
     QUrlQuery query;
     QString vsCurrency = cfg.value("vsCurrency", QStringLiteral("usd")).toString();
     if (!vsCurrency.isEmpty())
         query.addQueryItem(QStringLiteral("vs_currency"), vsCurrency);
-    QString days = cfg.value("days", QStringLiteral("7")).toString();
-    if (!days.isEmpty())
+    if (incremental) {
+        // ab der nächsten vollen Stunde; to läuft mit und zählt nicht zum ETag-Schlüssel
+        query.addQueryItem(QStringLiteral("from"), QString::number((stored.last() / kHourMs + 1) * kHourMs / 1000));
+        query.addQueryItem(QStringLiteral("to"), QString::number(now / 60000 * 60));
+    } else if (!days.isEmpty()) {
         query.addQueryItem(QStringLiteral("days"), days);
+    }
     QString interval = cfg.value("interval").toString();
-    if (!interval.isEmpty())
+    if (!interval.isEmpty() && !incremental)
         query.addQueryItem(QStringLiteral("interval"), interval);
     QString precision = cfg.value("precision").toString();
     if (!precision.isEmpty())
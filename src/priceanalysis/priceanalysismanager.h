@@ -7,6 +7,11 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QUrl>
+#include <QVector>
+
+#include "candlemodel.h"
+#include "timeseries.h"
+#include "storage/appendlogstore.h"
 
 class PriceAnalysisManager : public QObject
 {
@@ -19,6 +24,11 @@ class PriceAnalysisManager : public QObject
     Q_PROPERTY(double highestPriceUsd READ highestPriceUsd NOTIFY historyChanged)
     Q_PROPERTY(double lowestPriceUsd READ lowestPriceUsd NOTIFY historyChanged)
     Q_PROPERTY(double latestVolumeUsd READ latestVolumeUsd NOTIFY historyChanged)
+    Q_PROPERTY(double dailyHighPriceUsd READ dailyHighPriceUsd NOTIFY historyChanged)
+    Q_PROPERTY(double dailyLowPriceUsd READ dailyLowPriceUsd NOTIFY historyChanged)
+    Q_PROPERTY(int pointCount READ pointCount NOTIFY historyChanged)
+    Q_PROPERTY(CandleModel *candles READ candles CONSTANT)
+    Q_PROPERTY(TimeSeries *priceSeries READ priceSeries CONSTANT)
     Q_PROPERTY(QVariantMap apiConfig READ apiConfig WRITE setApiConfig NOTIFY apiConfigChanged)
     Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
     Q_PROPERTY(QString errorString READ errorString NOTIFY errorStringChanged)
@@ -26,13 +36,18 @@ class PriceAnalysisManager : public QObject
 public:
     explicit PriceAnalysisManager(QObject *parent = nullptr);
 
-    QVariantList history() const { return m_history; }
+    QVariantList history() const;
     QVariantList recentHistory() const { return m_recentHistory; }
     double latestPriceUsd() const { return m_latestPriceUsd; }
     QString latestTimestamp() const { return m_latestTimestamp; }
     double highestPriceUsd() const { return m_highestPriceUsd; }
     double lowestPriceUsd() const { return m_lowestPriceUsd; }
     double latestVolumeUsd() const { return m_latestVolumeUsd; }
+    double dailyHighPriceUsd() const { return m_dailyHighPriceUsd; }
+    double dailyLowPriceUsd() const { return m_dailyLowPriceUsd; }
+    int pointCount() const { return m_priceSeries->count(); }
+    CandleModel *candles() const { return m_candles; }
+    TimeSeries *priceSeries() const { return m_priceSeries; }
     QVariantMap apiConfig() const;
     void setApiConfig(const QVariantMap &config);
     bool loading() const { return m_loading; }
@@ -40,6 +55,10 @@ public:
 
     Q_INVOKABLE void refresh();
 
+    // Aggregiert [from, to] (ms, 0 = gesamte Historie) in bucketCount Kerzen,
+    // füllt damit das candles-Modell und gibt es zurück
+    Q_INVOKABLE CandleModel *ohlc(int bucketCount, double from = 0, double to = 0);
+
 signals:
     void apiConfigChanged();
     void historyChanged();
@@ -47,22 +66,52 @@ signals:
     void errorStringChanged();
 
 private:
+    struct PricePoint {
+        qint64 timestamp;
+        double price;
+        double volume;
+    };
+
     void parseResponse(const QByteArray &data);
+    void mergePoints(const QVector<PricePoint> &points);
+    void loadStore();
+    void parseStore(const uchar *data, qint64 size);
+    void writeStore(const QVector<PricePoint> &points, bool append);
+    bool pruneToWindow();
+    QVector<PricePoint> storedPoints() const;
+    QString storeKey() const;
     void rebuildRecentHistory();
+    void updateDerivedStats();
+    static QVariantMap pointToVariant(qint64 timestamp, double price);
     void setError(const QString &message);
     QUrl buildRequestUrl() const;
 
-    QVariantList m_history;
+    // Historie spaltenweise, nach Zeit sortiert: Zeit/Preis in der
+    // Detailstufen-Reihe, Volumen parallel dazu
+    TimeSeries *m_priceSeries;
+    QVector<double> m_volumes;      // 0 wenn unbekannt
+    mutable QVariantList m_historyCache;
+    mutable bool m_historyCacheValid = false;
+
     QVariantList m_recentHistory;
+    CandleModel *m_candles;
     double m_latestPriceUsd = 0.0;
     QString m_latestTimestamp;
     double m_highestPriceUsd = 0.0;
     double m_lowestPriceUsd = 0.0;
     double m_latestVolumeUsd = 0.0;
+    double m_dailyHighPriceUsd = 0.0;
+    double m_dailyLowPriceUsd = 0.0;
     bool m_loading = false;
     QString m_errorString;
     QNetworkAccessManager m_network;
     QVariantMap m_apiConfig;
+    AppendLogStore m_store;         // Magic + PricePoint-Records je coinId/vsCurrency
+
+    // HTTP-Caching der letzten Antwort
+    QByteArray m_etag;
+    QUrl m_etagUrl;                 // Anfrage-URL ohne to
+    qint64 m_freshUntilMs = 0;
 };
 
 #endif // PRICEANALYSISMANAGER_H
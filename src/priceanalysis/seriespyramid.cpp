@@ -0,0 +1,296 @@
+#include "seriespyramid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+static const int kFanoutBits = 3;   // 8 Blöcke der Stufe darunter je Block
+static const int kMaxLevels = 10;   // 8^10 Punkte passen noch in int
+
+inline int blockSize(int level)
+{
+    return 1 << (kFanoutBits * level);
+}
+}
+
+bool SeriesPyramid::append(qint64 timestamp, double value)
+{
+    if (!m_t.isEmpty() && timestamp <= m_t.last())
+        return false;
+
+    m_t.append(timestamp);
+    m_v.append(value);
+
+    const int i = m_t.size() - 1;
+    const Block point{ value, value, i, i };
+    for (int k = 0; k < m_levels.size(); ++k)
+        mergeInto(m_levels[k], i >> (kFanoutBits * (k + 1)), point);
+
+    // neue Stufe, sobald sie mindestens einen vollen Block hätte
+    if (m_levels.size() < kMaxLevels && m_t.size() >= blockSize(m_levels.size() + 1))
+        addLevel();
+    return true;
+}
+
+void SeriesPyramid::clear()
+{
+    m_t.clear();
+    m_v.clear();
+    m_levels.clear();
+}
+
+void SeriesPyramid::reserve(int size)
+{
+    m_t.reserve(size);
+    m_v.reserve(size);
+}
+
+void SeriesPyramid::mergeInto(QVector<Block> &level, int block, const Block &src)
+{
+    if (block == level.size()) {
+        level.append(src);
+        return;
+    }
+
+    Block &b = level[block];
+    if (src.min < b.min) {
+        b.min = src.min;
+        b.minIndex = src.minIndex;
+    }
+    if (src.max > b.max) {
+        b.max = src.max;
+        b.maxIndex = src.maxIndex;
+    }
+}
+
+// Baut die nächsthöhere Stufe einmalig aus der darunterliegenden auf
+void SeriesPyramid::addLevel()
+{
+    QVector<Block> level;
+    if (m_levels.isEmpty()) {
+        level.reserve((m_v.size() >> kFanoutBits) + 1);
+        for (int i = 0; i < m_v.size(); ++i)
+            mergeInto(level, i >> kFanoutBits, Block{ m_v.at(i), m_v.at(i), i, i });
+    } else {
+        const QVector<Block> &below = m_levels.last();
+        level.reserve((below.size() >> kFanoutBits) + 1);
+        for (int c = 0; c < below.size(); ++c)
+            mergeInto(level, c >> kFanoutBits, below.at(c));
+    }
+    m_levels.append(level);
+}
+
+QPair<int, int> SeriesPyramid::indexRange(qint64 from, qint64 to) const
+{
+    const auto begin = std::lower_bound(m_t.constBegin(), m_t.constEnd(), from);
+    const auto end = std::upper_bound(begin, m_t.constEnd(), to);
+    return qMakePair(int(begin - m_t.constBegin()), int(end - m_t.constBegin()));
+}
+
+// Greedy von links: jeweils der größte ausgerichtete Block, der ganz in
+// [i, last) liegt. Höchstens 2·7 Schritte pro Stufe.
+void SeriesPyramid::rangeMinMax(int first, int last, int *minIndex, int *maxIndex) const
+{
+    int lo = first;
+    int hi = first;
+    int i = first;
+    while (i < last) {
+        int k = m_levels.size();
+        while (k > 0 && ((i & (blockSize(k) - 1)) != 0 || qint64(i) + blockSize(k) > last))
+            --k;
+
+        if (k == 0) {
+            if (m_v.at(i) < m_v.at(lo))
+                lo = i;
+            if (m_v.at(i) > m_v.at(hi))
+                hi = i;
+            ++i;
+            continue;
+        }
+
+        const Block &b = m_levels.at(k - 1).at(i >> (kFanoutBits * k));
+        if (b.min < m_v.at(lo))
+            lo = b.minIndex;
+        if (b.max > m_v.at(hi))
+            hi = b.maxIndex;
+        i += blockSize(k);
+    }
+    *minIndex = lo;
+    *maxIndex = hi;
+}
+
+QVector<SeriesPyramid::Sample> SeriesPyramid::minMax(qint64 from, qint64 to, int columns) const
+{
+    QVector<Sample> out;
+    const QPair<int, int> r = indexRange(from, to);
+    if (r.first >= r.second || columns <= 0)
+        return out;
+
+    // weniger Punkte als Spalten: Rohdaten
+    if (r.second - r.first <= 2 * columns) {
+        out.reserve(r.second - r.first);
+        for (int i = r.first; i < r.second; ++i)
+            out.append(Sample{ m_t.at(i), m_v.at(i) });
+        return out;
+    }
+
+    const qint64 t0 = m_t.at(r.first);
+    const qint64 t1 = m_t.at(r.second - 1);
+    const double columnMs = double(t1 - t0 + 1) / columns;
+    out.reserve(2 * columns);
+
+    int begin = r.first;
+    for (int c = 0; c < columns && begin < r.second; ++c) {
+        const qint64 edge = c + 1 == columns ? t1 + 1 : t0 + qint64(std::ceil(columnMs * (c + 1)));
+        const int end = int(std::lower_bound(m_t.constBegin() + begin, m_t.constBegin() + r.second, edge)
+                            - m_t.constBegin());
+        if (end == begin)
+            continue;
+
+        int lo = 0;
+        int hi = 0;
+        rangeMinMax(begin, end, &lo, &hi);
+        const int a = qMin(lo, hi);
+        const int b = qMax(lo, hi);
+        out.append(Sample{ m_t.at(a), m_v.at(a) });
+        if (b != a)
+            out.append(Sample{ m_t.at(b), m_v.at(b) });
+        begin = end;
+    }
+    return out;
+}
+
+// Min/Max-Indizes von `segments` gleich langen Indexabschnitten plus
+// Randpunkte, sortiert und ohne Duplikate
+QVector<int> SeriesPyramid::candidates(int first, int last, int segments) const
+{
+    QVector<int> out;
+    out.reserve(2 * segments + 2);
+    out.append(first);
+
+    const double span = double(last - first) / segments;
+    for (int s = 0; s < segments; ++s) {
+        const int begin = first + int(span * s);
+        const int end = s + 1 == segments ? last : first + int(span * (s + 1));
+        if (end <= begin)
+            continue;
+
+        int lo = 0;
+        int hi = 0;
+        rangeMinMax(begin, end, &lo, &hi);
+        const int a = qMin(lo, hi);
+        const int b = qMax(lo, hi);
+        if (a != out.last())
+            out.append(a);
+        if (b != out.last())
+            out.append(b);
+    }
+    if (out.last() != last - 1)
+        out.append(last - 1);
+    return out;
+}
+
+QVector<SeriesPyramid::Sample> SeriesPyramid::lttb(qint64 from, qint64 to, int threshold) const
+{
+    QVector<Sample> out;
+    const QPair<int, int> r = indexRange(from, to);
+    const int n = r.second - r.first;
+    if (n <= 0 || threshold <= 0)
+        return out;
+
+    if (n <= threshold) {
+        out.reserve(n);
+        for (int i = r.first; i < r.second; ++i)
+            out.append(Sample{ m_t.at(i), m_v.at(i) });
+        return out;
+    }
+    if (threshold < 3) {
+        out.append(Sample{ m_t.at(r.first), m_v.at(r.first) });
+        if (threshold == 2)
+            out.append(Sample{ m_t.at(r.second - 1), m_v.at(r.second - 1) });
+        return out;
+    }
+
+    // statt aller Rohpunkte nur die Extremwerte von 2·threshold Abschnitten
+    QVector<int> cand;
+    if (n <= 4 * threshold) {
+        cand.reserve(n);
+        for (int i = r.first; i < r.second; ++i)
+            cand.append(i);
+    } else {
+        cand = candidates(r.first, r.second, 2 * threshold);
+    }
+
+    const int m = cand.size();
+    if (m <= threshold) {
+        for (int idx : cand)
+            out.append(Sample{ m_t.at(idx), m_v.at(idx) });
+        return out;
+    }
+
+    const qint64 t0 = m_t.at(cand.first());
+    auto x = [&](int c) { return double(m_t.at(cand.at(c)) - t0); };
+    auto y = [&](int c) { return m_v.at(cand.at(c)); };
+
+    out.reserve(threshold);
+    out.append(Sample{ m_t.at(cand.first()), m_v.at(cand.first()) });
+
+    const double every = double(m - 2) / (threshold - 2);
+    int a = 0;
+    for (int i = 0; i < threshold - 2; ++i) {
+        // Schwerpunkt des nächsten Buckets
+        const int avgBegin = int(std::floor((i + 1) * every)) + 1;
+        const int avgEnd = qMin(int(std::floor((i + 2) * every)) + 1, m);
+        double avgX = 0.0;
+        double avgY = 0.0;
+        for (int j = avgBegin; j < avgEnd; ++j) {
+            avgX += x(j);
+            avgY += y(j);
+        }
+        const int avgCount = qMax(1, avgEnd - avgBegin);
+        avgX /= avgCount;
+        avgY /= avgCount;
+
+        // Punkt des aktuellen Buckets mit größter Dreiecksfläche
+        const int rangeBegin = int(std::floor(i * every)) + 1;
+        const int rangeEnd = int(std::floor((i + 1) * every)) + 1;
+        const double ax = x(a);
+        const double ay = y(a);
+        double maxArea = -1.0;
+        int chosen = rangeBegin;
+        for (int j = rangeBegin; j < rangeEnd; ++j) {
+            const double area = std::fabs((ax - avgX) * (y(j) - ay) - (ax - x(j)) * (avgY - ay));
+            if (area > maxArea) {
+                maxArea = area;
+                chosen = j;
+            }
+        }
+        out.append(Sample{ m_t.at(cand.at(chosen)), m_v.at(cand.at(chosen)) });
+        a = chosen;
+    }
+
+    out.append(Sample{ m_t.at(cand.last()), m_v.at(cand.last()) });
+    return out;
+}
+
+QVector<SeriesPyramid::Bucket> SeriesPyramid::buckets(qint64 origin, qint64 to, qint64 bucketMs) const
+{
+    QVector<Bucket> out;
+    if (bucketMs <= 0)
+        return out;
+
+    const QPair<int, int> r = indexRange(origin, to);
+    int begin = r.first;
+    while (begin < r.second) {
+        const qint64 key = origin + (m_t.at(begin) - origin) / bucketMs * bucketMs;
+        const int end = int(std::lower_bound(m_t.constBegin() + begin, m_t.constBegin() + r.second, key + bucketMs)
+                            - m_t.constBegin());
+
+        int lo = 0;
+        int hi = 0;
+        rangeMinMax(begin, end, &lo, &hi);
+        out.append(Bucket{ key, m_v.at(begin), m_v.at(hi), m_v.at(lo), m_v.at(end - 1), end - 1 });
+        begin = end;
+    }
+    return out;
+}
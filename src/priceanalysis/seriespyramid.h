@@ -0,0 +1,71 @@
+#ifndef SERIESPYRAMID_H
+#define SERIESPYRAMID_H
+
+#include <QPair>
+#include <QVector>
+#include <QtGlobal>
+
+// Zeitreihe mit Detailstufen für Charts über lange Zeiträume.
+// Stufe k fasst je 8^k aufeinanderfolgende Rohpunkte zu einem Block
+// (Min/Max samt Index) zusammen; append() aktualisiert nur den letzten
+// Block jeder Stufe. Eine Abfrage zerlegt einen Indexbereich in wenige
+// ausgerichtete Blöcke und kostet damit O(Ausgabe · log n) statt O(n).
+// Zeitstempel müssen streng monoton steigen.
+class SeriesPyramid
+{
+public:
+    struct Sample {
+        qint64 timestamp;   // ms seit Epoch
+        double value;
+    };
+
+    // OHLC über einen Zeitabschnitt
+    struct Bucket {
+        qint64 timestamp;   // Beginn des Abschnitts
+        double open;
+        double high;
+        double low;
+        double close;
+        int lastIndex;      // letzter Rohpunkt (z.B. für das Volumen)
+    };
+
+    // false, wenn der Zeitstempel nicht hinter dem letzten Punkt liegt
+    bool append(qint64 timestamp, double value);
+    void clear();
+    void reserve(int size);
+
+    int size() const { return m_t.size(); }
+    bool isEmpty() const { return m_t.isEmpty(); }
+    const QVector<qint64> &timestamps() const { return m_t; }
+    const QVector<double> &values() const { return m_v; }
+
+    // Indexbereich [first, second) der Punkte mit from <= t <= to
+    QPair<int, int> indexRange(qint64 from, qint64 to) const;
+    // Indizes von Minimum und Maximum in [first, last), last > first
+    void rangeMinMax(int first, int last, int *minIndex, int *maxIndex) const;
+
+    // Min/Max je Pixelspalte (zeitlich gleich breit), nach Zeit sortiert
+    QVector<Sample> minMax(qint64 from, qint64 to, int columns) const;
+    // Largest-Triangle-Three-Buckets über die Min/Max-Kandidaten der Blöcke
+    QVector<Sample> lttb(qint64 from, qint64 to, int threshold) const;
+    // Nicht leere Abschnitte [origin + k·bucketMs, +bucketMs) bis einschließlich to
+    QVector<Bucket> buckets(qint64 origin, qint64 to, qint64 bucketMs) const;
+
+private:
+    struct Block {
+        double min;
+        double max;
+        int minIndex;
+        int maxIndex;
+    };
+
+    static void mergeInto(QVector<Block> &level, int block, const Block &src);
+    void addLevel();
+    QVector<int> candidates(int first, int last, int segments) const;
+
+    QVector<qint64> m_t;
+    QVector<double> m_v;
+    QVector<QVector<Block> > m_levels;  // m_levels[k - 1] = Stufe k, Blockgröße 8^k
+};
+
+#endif // SERIESPYRAMID_H
@@ -0,0 +1,111 @@
+#include "timeseries.h"
+
+#include <limits>
+
+TimeSeries::TimeSeries(QObject *parent)
+    : QObject(parent)
+{
+}
+
+double TimeSeries::minTimestamp() const
+{
+    return m_pyramid.isEmpty() ? 0.0 : double(m_pyramid.timestamps().first());
+}
+
+double TimeSeries::maxTimestamp() const
+{
+    return m_pyramid.isEmpty() ? 0.0 : double(m_pyramid.timestamps().last());
+}
+
+void TimeSeries::appendSamples(const QVector<SeriesPyramid::Sample> &samples)
+{
+    bool added = false;
+    m_pyramid.reserve(m_pyramid.size() + samples.size());
+    for (const SeriesPyramid::Sample &s : samples)
+        added = m_pyramid.append(s.timestamp, s.value) || added;
+    if (added)
+        emit changed();
+}
+
+void TimeSeries::setSamples(const QVector<SeriesPyramid::Sample> &samples)
+{
+    if (m_pyramid.isEmpty() && samples.isEmpty())
+        return;
+
+    m_pyramid.clear();
+    m_pyramid.reserve(samples.size());
+    for (const SeriesPyramid::Sample &s : samples)
+        m_pyramid.append(s.timestamp, s.value);
+    emit changed();
+}
+
+void TimeSeries::append(double timestamp, double value)
+{
+    if (m_readOnly) {
+        qWarning("TimeSeries: append() on a read-only series ignored");
+        return;
+    }
+    if (m_pyramid.append(static_cast<qint64>(timestamp), value))
+        emit changed();
+}
+
+void TimeSeries::clear()
+{
+    if (m_readOnly) {
+        qWarning("TimeSeries: clear() on a read-only series ignored");
+        return;
+    }
+    if (m_pyramid.isEmpty())
+        return;
+
+    m_pyramid.clear();
+    emit changed();
+}
+
+qint64 TimeSeries::fromValue(double from) const
+{
+    return from > 0 ? static_cast<qint64>(from) : std::numeric_limits<qint64>::min();
+}
+
+qint64 TimeSeries::toValue(double to) const
+{
+    return to > 0 ? static_cast<qint64>(to) : std::numeric_limits<qint64>::max();
+}
+
+QVariantList TimeSeries::toVariant(const QVector<SeriesPyramid::Sample> &samples)
+{
+    QVariantList out;
+    out.reserve(samples.size());
+    for (const SeriesPyramid::Sample &s : samples) {
+        QVariantMap row;
+        row["t"] = double(s.timestamp);
+        row["v"] = s.value;
+        out.append(row);
+    }
+    return out;
+}
+
+QVariantList TimeSeries::minMax(double from, double to, int columns) const
+{
+    return toVariant(m_pyramid.minMax(fromValue(from), toValue(to), columns));
+}
+
+QVariantList TimeSeries::lttb(double from, double to, int threshold) const
+{
+    return toVariant(m_pyramid.lttb(fromValue(from), toValue(to), threshold));
+}
+
+QVariantMap TimeSeries::valueRange(double from, double to) const
+{
+    QVariantMap out;
+    const QPair<int, int> r = m_pyramid.indexRange(fromValue(from), toValue(to));
+    if (r.first >= r.second)
+        return out;
+
+    int lo = 0;
+    int hi = 0;
+    m_pyramid.rangeMinMax(r.first, r.second, &lo, &hi);
+    out["min"] = m_pyramid.values().at(lo);
+    out["max"] = m_pyramid.values().at(hi);
+    return out;
+}
@@ -0,0 +1,64 @@
+#ifndef TIMESERIES_H
+#define TIMESERIES_H
+
+#include <QObject>
+#include <QVariant>
+#include <QVariantMap>
+#include <QVector>
+
+#include "seriespyramid.h"
+
+// QML-Hülle um SeriesPyramid, z.B. für Höhe, Difficulty und Peers im
+// StatusView oder den Preis im PriceAnalysisManager. Abfragen liefern
+// [{t, v}] mit t in ms; from/to = 0 bedeutet offenes Ende.
+class TimeSeries : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY changed)
+    Q_PROPERTY(double minTimestamp READ minTimestamp NOTIFY changed)
+    Q_PROPERTY(double maxTimestamp READ maxTimestamp NOTIFY changed)
+    Q_PROPERTY(bool readOnly READ readOnly CONSTANT)
+
+public:
+    explicit TimeSeries(QObject *parent = nullptr);
+
+    int count() const { return m_pyramid.size(); }
+    double minTimestamp() const;
+    double maxTimestamp() const;
+
+    // Reihen, zu denen der Besitzer parallele Spalten führt (z.B. das
+    // Volumen im PriceAnalysisManager), setzen das vor der Übergabe an
+    // QML; append()/clear() aus QML werden dann abgewiesen
+    bool readOnly() const { return m_readOnly; }
+    void setReadOnly(bool readOnly) { m_readOnly = readOnly; }
+
+    const SeriesPyramid &pyramid() const { return m_pyramid; }
+    // Mehrere Punkte auf einmal, changed() nur einmal
+    void appendSamples(const QVector<SeriesPyramid::Sample> &samples);
+    // ersetzt den Inhalt, auch bei readOnly
+    void setSamples(const QVector<SeriesPyramid::Sample> &samples);
+
+    // Punkte, die nicht hinter dem letzten liegen, werden verworfen
+    Q_INVOKABLE void append(double timestamp, double value);
+    Q_INVOKABLE void clear();
+
+    // Min/Max je Pixelspalte, für Linien- und Flächencharts
+    Q_INVOKABLE QVariantList minMax(double from, double to, int columns) const;
+    // höchstens threshold Punkte, formtreu (LTTB)
+    Q_INVOKABLE QVariantList lttb(double from, double to, int threshold) const;
+    // {min, max} der Werte im Bereich, für die Achsen
+    Q_INVOKABLE QVariantMap valueRange(double from, double to) const;
+
+signals:
+    void changed();
+
+private:
+    qint64 fromValue(double from) const;
+    qint64 toValue(double to) const;
+    static QVariantList toVariant(const QVector<SeriesPyramid::Sample> &samples);
+
+    SeriesPyramid m_pyramid;
+    bool m_readOnly = false;
+};
+
+#endif // TIMESERIES_H
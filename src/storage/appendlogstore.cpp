@@ -0,0 +1,191 @@
+#include "appendlogstore.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#ifdef Q_OS_WASM
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QSettings>
+#endif
+
+namespace {
+
+#ifdef Q_OS_WASM
+const int kChunkBytes = 256 * 1024;
+
+QString chunkKey(const QString &webKey, int n)
+{
+    return webKey + "/" + QString::number(n);
+}
+
+QString countKey(const QString &webKey)
+{
+    return webKey + "/chunks";
+}
+#endif
+
+} // namespace
+
+AppendLogStore::AppendLogStore(const char *name) :
+    m_name(name)
+{
+}
+
+/**
+ * @brief AppendLogStore::open
+ * Wechselt auf den Speicher unter fileName bzw. webKey und gibt dessen
+ * Inhalt an parse. Desktop per mmap, sonst per readAll.
+ */
+void AppendLogStore::open(const QString &fileName, const QString &webKey, const Parser &parse)
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    QDir().mkpath(dir);
+    m_path = dir + "/" + fileName;
+    m_webKey = webKey;
+    m_size = 0;
+
+#ifdef Q_OS_WASM
+    m_chunkHashes.clear();
+    m_tail.clear();
+
+    QSettings store(QSettings::WebIndexedDBFormat, QSettings::UserScope,
+                    QCoreApplication::organizationName(), QCoreApplication::applicationName());
+    const int count = store.value(countKey(m_webKey), -1).toInt();
+    if (count < 0) {
+        // altes Format: ein Blob, beim ersten Öffnen in Stücke umschreiben
+        const QByteArray blob = store.value(m_webKey).toByteArray();
+        parse(reinterpret_cast<const uchar *>(blob.constData()), blob.size());
+        if (!blob.isEmpty()) {
+            store.remove(m_webKey);
+            rewrite(blob);
+        }
+        return;
+    }
+
+    QByteArray blob;
+    for (int n = 0; n < count; ++n) {
+        const QByteArray chunk = store.value(chunkKey(m_webKey, n)).toByteArray();
+        m_chunkHashes.append(QCryptographicHash::hash(chunk, QCryptographicHash::Md5));
+        m_tail = chunk;
+        blob += chunk;
+    }
+    m_size = blob.size();
+    parse(reinterpret_cast<const uchar *>(blob.constData()), blob.size());
+#else
+    QFile f(m_path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    m_size = f.size();
+    if (uchar *data = f.map(0, m_size)) {
+        parse(data, m_size);
+        f.unmap(data);
+    } else {
+        const QByteArray all = f.readAll();
+        parse(reinterpret_cast<const uchar *>(all.constData()), all.size());
+    }
+#endif
+}
+
+bool AppendLogStore::append(const QByteArray &records)
+{
+    if (!isOpen()) {
+        return false;
+    }
+    if (records.isEmpty()) {
+        return true;
+    }
+
+#ifdef Q_OS_WASM
+    // das letzte Stück wird aufgefüllt, alle davor bleiben unberührt
+    const int last = qMax(0, int(m_chunkHashes.size()) - 1);
+    if (!writeChunks(m_tail + records, last)) {
+        return false;
+    }
+#else
+    QFile f(m_path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning("%s: cannot append to %s: %s", m_name, qPrintable(m_path), qPrintable(f.errorString()));
+        return false;
+    }
+    if (f.write(records) != records.size()) {
+        qWarning("%s: cannot append to %s: %s", m_name, qPrintable(m_path), qPrintable(f.errorString()));
+        return false;
+    }
+#endif
+    m_size += records.size();
+    return true;
+}
+
+bool AppendLogStore::rewrite(const QByteArray &all)
+{
+    if (!isOpen()) {
+        return false;
+    }
+
+#ifdef Q_OS_WASM
+    if (!writeChunks(all, 0)) {
+        return false;
+    }
+#else
+    QSaveFile f(m_path);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning("%s: cannot write %s: %s", m_name, qPrintable(m_path), qPrintable(f.errorString()));
+        return false;
+    }
+    f.write(all);
+    if (!f.commit()) {
+        qWarning("%s: cannot write %s: %s", m_name, qPrintable(m_path), qPrintable(f.errorString()));
+        return false;
+    }
+#endif
+    m_size = all.size();
+    return true;
+}
+
+#ifdef Q_OS_WASM
+/**
+ * @brief AppendLogStore::writeChunks
+ * data ist der Inhalt ab Stück firstChunk bis zum Ende. Geschrieben werden
+ * nur Stücke, deren Inhalt sich geändert hat; überzählige alte Stücke
+ * werden entfernt.
+ */
+bool AppendLogStore::writeChunks(const QByteArray &data, int firstChunk)
+{
+    QSettings store(QSettings::WebIndexedDBFormat, QSettings::UserScope,
+                    QCoreApplication::organizationName(), QCoreApplication::applicationName());
+
+    int n = firstChunk;
+    for (qint64 pos = 0; pos < data.size(); pos += kChunkBytes, ++n) {
+        const QByteArray chunk = data.mid(pos, kChunkBytes);
+        const QByteArray hash = QCryptographicHash::hash(chunk, QCryptographicHash::Md5);
+        if (n < m_chunkHashes.size() && m_chunkHashes.at(n) == hash) {
+            continue;
+        }
+        store.setValue(chunkKey(m_webKey, n), chunk);
+        if (n < m_chunkHashes.size()) {
+            m_chunkHashes[n] = hash;
+        } else {
+            m_chunkHashes.append(hash);
+        }
+    }
+    for (int stale = n; stale < m_chunkHashes.size(); ++stale) {
+        store.remove(chunkKey(m_webKey, stale));
+    }
+    m_chunkHashes.resize(n);
+    m_tail = n > firstChunk ? data.mid(qint64(n - 1 - firstChunk) * kChunkBytes) : QByteArray();
+    store.setValue(countKey(m_webKey), n);
+    store.sync();
+
+    if (store.status() != QSettings::NoError) {
+        qWarning("%s: cannot write %s", m_name, qPrintable(m_webKey));
+        // Stand unbekannt: beim nächsten Schreiben alle Stücke neu
+        m_chunkHashes.fill(QByteArray());
+        return false;
+    }
+    return true;
+}
+#endif
@@ -0,0 +1,61 @@
+#ifndef APPENDLOGSTORE_H
+#define APPENDLOGSTORE_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+// Gemeinsame Ablage für die Append-Logs von ChainCache, PmmrIndexMap,
+// KernelIndex, UtxoMirror und GeoCache. Das Recordformat kennt nur der
+// Besitzer, der Store sieht Bytes: open() gibt den gespeicherten Inhalt an
+// parse, append() hängt Records an, rewrite() ersetzt alles (Kompaktierung).
+// Desktop: eine Datei im Cache-Verzeichnis, gelesen per mmap, angehängt per
+// QFile und kompaktiert per QSaveFile.
+// WASM: IndexedDB (QSettings::WebIndexedDBFormat) kennt kein Anhängen. Der
+// Inhalt liegt deshalb in Stücken zu kChunkBytes unter <webKey>/<n>;
+// append() schreibt nur das letzte Stück und neue Stücke, rewrite() nur
+// Stücke mit geändertem Inhalt (MD5 je Stück). Ein alter Einzel-Blob unter
+// <webKey> wird beim Öffnen übernommen.
+class AppendLogStore
+{
+public:
+    using Parser = std::function<void(const uchar *data, qint64 size)>;
+
+    // name erscheint in Warnungen
+    explicit AppendLogStore(const char *name);
+
+    // Speicher öffnen und den Inhalt an parse geben; fileName liegt im
+    // Cache-Verzeichnis
+    void open(const QString &fileName, const QString &webKey, const Parser &parse);
+    bool isOpen() const
+    {
+        return !m_webKey.isEmpty();
+    }
+
+    // false, wenn nicht geschrieben werden konnte (Warnung ist ausgegeben)
+    bool append(const QByteArray &records);
+    bool rewrite(const QByteArray &all);
+
+    // Gespeicherte Bytes inkl. überholter Records
+    qint64 size() const
+    {
+        return m_size;
+    }
+
+private:
+#ifdef Q_OS_WASM
+    bool writeChunks(const QByteArray &data, int firstChunk);
+
+    QVector<QByteArray> m_chunkHashes;
+    QByteArray m_tail;                  // Inhalt des letzten Stücks
+#endif
+
+    const char *m_name;
+    QString m_path;
+    QString m_webKey;
+    qint64 m_size = 0;
+};
+
+#endif // APPENDLOGSTORE_H
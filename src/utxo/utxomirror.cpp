@@ -0,0 +1,823 @@
+#include "utxomirror.h"
+
+#include "chainrpc.h"
+#include "jsonrpcbatcher.h"
+#include "polling/pollscheduler.h"
+
+#include <QDebug>
+#include <QSettings>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const quint8 kRecordVersion = 1;
+const qint64 kPageSize = 1000;          // MMR-Positionen je get_unspent_outputs
+const int kPipelineDepth = 8;           // Seiten gleichzeitig unterwegs
+const int kPageAttempts = 3;
+const int kBlocksPerRequest = 100;
+const qint64 kMaxCatchUpBlocks = 10000; // weiter zurück: Erstsync ist schneller
+const int kUndoBlocks = 60;             // wie kReorgHorizon der ChainCache
+const qint64 kBucketBlocks = 1440;      // ein Tag
+const int kMergeThreshold = 4096;
+const qint64 kCompactSlackRecords = 20000;
+const int kFlushDelayMs = 5000;
+const int kTipPollMs = 30000;
+const int kRetryMinMs = 5000;
+const int kRetryMaxMs = 300000;
+const char kTopic[] = "utxo.mirror";
+const char kEnabledKey[] = "utxo/mirrorEnabled";
+
+bool commitLess(const char *a, const char *b)
+{
+    return std::memcmp(a, b, 33) < 0;
+}
+
+} // namespace
+
+UtxoMirror::UtxoMirror(JsonRpcBatcher *rpc, ChainRpc *chain, QObject *parent) :
+    QObject(parent),
+    m_rpc(rpc),
+    m_chain(chain),
+    m_store("UtxoMirror")
+{
+    static_assert(sizeof(Record) == 48, "UtxoMirror::Record must stay 48 bytes");
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushDelayMs);
+    connect(&m_flushTimer, &QTimer::timeout, this, [this]() {
+        flush();
+    });
+    m_retryTimer.setSingleShot(true);
+    connect(&m_retryTimer, &QTimer::timeout, this, &UtxoMirror::retry);
+
+    connect(m_chain, &ChainRpc::chainOpened, this, &UtxoMirror::onChainOpened);
+    connect(m_chain, &ChainRpc::chainLookupFailed, this, [this](const QString &message) {
+        if (m_state == Opening) {
+            fail(message);
+        }
+    });
+    connect(m_chain, &ChainRpc::endpointChanged, this, &UtxoMirror::onEndpointChanged);
+    // Tip-Abrufe der Chain-Ansicht kommen dem Spiegel ohne eigenen RPC zugute
+    connect(m_chain, &ChainRpc::tipRefreshed, this, [this](int, const QVariantMap &tip) {
+        notifyTip(tip.value("height", -1).toInt());
+    });
+
+    if (QSettings().value(kEnabledKey, false).toBool()) {
+        m_enabled = true;
+        QTimer::singleShot(0, this, &UtxoMirror::open);
+    }
+}
+
+UtxoMirror::~UtxoMirror()
+{
+    flush();
+}
+
+void UtxoMirror::setScheduler(PollScheduler *scheduler)
+{
+    m_scheduler = scheduler;
+    if (!m_scheduler) {
+        return;
+    }
+    connect(m_scheduler, &PollScheduler::poll, this, [this](const QString &topic) {
+        if (topic == QLatin1String(kTopic)) {
+            refreshTip();
+        }
+    });
+    if (m_enabled) {
+        m_scheduler->subscribe(kTopic, this, kTipPollMs, true);
+    }
+}
+
+void UtxoMirror::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) {
+        return;
+    }
+    m_enabled = enabled;
+    QSettings().setValue(kEnabledKey, enabled);
+    emit enabledChanged();
+
+    if (enabled) {
+        if (m_scheduler) {
+            m_scheduler->subscribe(kTopic, this, kTipPollMs, true);
+        }
+        open();
+        return;
+    }
+
+    // Abschalten gibt den Speicher frei; die Datei bleibt für später
+    ++m_generation;
+    m_retryTimer.stop();
+    m_retryMs = 0;
+    if (m_scheduler) {
+        m_scheduler->unsubscribe(kTopic, this);
+    }
+    flush();
+    clearSet();
+    m_chainId.clear();
+    m_staging.clear();
+    m_pagesInFlight = 0;
+    setState(Idle);
+    emit statsChanged();
+}
+
+double UtxoMirror::progress() const
+{
+    if (m_state == FullSync) {
+        return m_highestIndex > 0 ? double(m_doneIndexes) / double(m_highestIndex) : 0.0;
+    }
+    return ready() ? 1.0 : 0.0;
+}
+
+// ---------- Abfragen ----------
+
+QVariantMap UtxoMirror::lookup(const QString &commitHex) const
+{
+    const QByteArray commit = QByteArray::fromHex(commitHex.trimmed().toLatin1());
+    const Record *r = commit.size() == 33 ? find(commit) : nullptr;
+    if (!r) {
+        return QVariantMap();
+    }
+    QVariantMap out;
+    out["commit"] = QString::fromLatin1(commit.toHex());
+    out["mmr_index"] = r->mmrIndex;
+    out["block_height"] = r->height;
+    out["output_type"] = (r->flags & CoinbaseFlag) ? QStringLiteral("Coinbase") : QStringLiteral("Transaction");
+    return out;
+}
+
+bool UtxoMirror::contains(const QString &commitHex) const
+{
+    const QByteArray commit = QByteArray::fromHex(commitHex.trimmed().toLatin1());
+    return commit.size() == 33 && find(commit);
+}
+
+QVariantList UtxoMirror::heightDistribution(int bucketBlocks) const
+{
+    const qint64 factor = qMax<qint64>(1, (bucketBlocks + kBucketBlocks / 2) / kBucketBlocks);
+    QVariantList out;
+    qint64 group = -1;
+    Counts sum;
+    for (auto it = m_buckets.constBegin(); it != m_buckets.constEnd(); ++it) {
+        const qint64 g = it.key() / factor;
+        if (g != group && group >= 0) {
+            out.append(QVariantMap{ { "height", group * factor * kBucketBlocks },
+                                    { "count", sum.count }, { "coinbase", sum.coinbase } });
+            sum = Counts();
+        }
+        group = g;
+        sum.count += it->count;
+        sum.coinbase += it->coinbase;
+    }
+    if (group >= 0) {
+        out.append(QVariantMap{ { "height", group * factor * kBucketBlocks },
+                                { "count", sum.count }, { "coinbase", sum.coinbase } });
+    }
+    return out;
+}
+
+void UtxoMirror::notifyTip(int height)
+{
+    m_knownTip = qMax<qint64>(m_knownTip, height);
+    if (m_enabled && m_state == Idle && m_syncedHeight >= 0 && height > m_syncedHeight) {
+        catchUp(height);
+    }
+}
+
+void UtxoMirror::resync()
+{
+    if (!m_enabled) {
+        return;
+    }
+    ++m_generation;
+    m_retryTimer.stop();
+    m_pagesInFlight = 0;
+    setState(Idle);
+    if (m_chainId.isEmpty()) {
+        open();
+    } else {
+        startFullSync();
+    }
+}
+
+// ---------- Transport / Zustand ----------
+
+void UtxoMirror::request(const QString &method, const QJsonArray &params, Done done)
+{
+    const int generation = m_generation;
+    m_rpc->call(method, params, [this, generation, done](const QJsonObject &response, const QString &error) {
+        if (generation != m_generation) {
+            return;
+        }
+        QString err = error;
+        const QJsonValue result = err.isEmpty() ? JsonRpcBatcher::okResult(response, &err) : QJsonValue();
+        done(result, err);
+    });
+}
+
+void UtxoMirror::setState(State state)
+{
+    if (m_state == state) {
+        return;
+    }
+    m_state = state;
+    emit stateChanged();
+}
+
+// Wiederholung nach kRetryMinMs, danach jeweils doppelt so spät
+void UtxoMirror::fail(const QString &message)
+{
+    qWarning() << "UtxoMirror:" << message;
+    ++m_generation;     // restliche Seiten des Laufs verwerfen
+    m_lastError = message;
+    m_staging.clear();
+    m_pagesInFlight = 0;
+    setState(Idle);
+    emit stateChanged();
+
+    if (m_enabled) {
+        m_retryMs = m_retryMs > 0 ? qMin(2 * m_retryMs, kRetryMaxMs) : kRetryMinMs;
+        m_retryTimer.start(m_retryMs);
+    }
+}
+
+void UtxoMirror::retry()
+{
+    if (!m_enabled || m_state != Idle) {
+        return;
+    }
+    if (m_chainId.isEmpty()) {
+        open();
+    } else if (m_syncedHeight < 0) {
+        startFullSync();
+    } else {
+        refreshTip();
+    }
+}
+
+// Chain über ChainRpc bestimmen, weiter in onChainOpened()
+void UtxoMirror::open()
+{
+    if (!m_enabled || m_state != Idle) {
+        return;
+    }
+    setState(Opening);
+    m_chain->lookupChain();
+}
+
+/**
+ * @brief UtxoMirror::onChainOpened
+ * Datei der Chain (Genesis-Hash) laden, dann fortschreiben oder Erstsync.
+ * Kommt auch, wenn die Chain-Ansicht den Genesis neu bestimmt; dann zählt
+ * nur ein Wechsel der Chain.
+ */
+void UtxoMirror::onChainOpened()
+{
+    const QString id = m_chain->chainId();
+    if (!m_enabled || id.isEmpty() || (m_state != Opening && id == m_chainId)) {
+        return;
+    }
+    ++m_generation;     // Läufe gegen die alte Chain verwerfen
+    m_staging.clear();
+    m_pagesInFlight = 0;
+    setState(Idle);
+
+    if (id != m_chainId) {
+        flush();
+        clearSet();
+        m_chainId = id;
+        m_store.open("utxo-" + m_chainId + ".bin", "utxo/mirror-" + m_chainId, [this](const uchar *data, qint64 size) {
+            parse(data, size);
+        });
+        emit statsChanged();
+    }
+
+    if (m_syncedHeight >= 0) {
+        refreshTip();
+    } else {
+        startFullSync();
+    }
+}
+
+// Anderer Node oder andere Auth: laufende Abrufe verwerfen, Chain neu bestimmen
+void UtxoMirror::onEndpointChanged()
+{
+    if (!m_enabled) {
+        return;
+    }
+    ++m_generation;
+    m_retryTimer.stop();
+    m_retryMs = 0;
+    m_staging.clear();
+    m_pagesInFlight = 0;
+    setState(Idle);
+    open();
+}
+
+// ---------- Erstsync ----------
+
+/**
+ * @brief UtxoMirror::startFullSync
+ * Erst der Tip, dann highest_index: so deckt der Scan mindestens alle
+ * Outputs bis zum Tip ab, alles danach kommt über die Blöcke dazu.
+ * Die bisherige Menge bleibt bis zum Abschluss abfragbar.
+ */
+void UtxoMirror::startFullSync()
+{
+    m_lastError.clear();
+    m_staging.clear();
+    m_highestIndex = 0;
+    m_doneIndexes = 0;
+    m_nextIndex = 1;
+    m_pagesInFlight = 0;
+    setState(FullSync);
+
+    request("get_tip", QJsonArray(), [this](const QJsonValue &tip, const QString &error) {
+        if (!error.isEmpty()) {
+            fail(error);
+            return;
+        }
+        const QJsonObject t = tip.toObject();
+        m_syncTipHeight = qint64(t.value("height").toDouble(-1));
+        m_syncTipHash = QByteArray::fromHex(t.value("last_block_pushed").toString().toLatin1());
+
+        request("get_unspent_outputs", QJsonArray{ 1, QJsonValue::Null, 1, false }, [this](const QJsonValue &listing, const QString &error) {
+            if (!error.isEmpty()) {
+                fail(error);
+                return;
+            }
+            m_highestIndex = qint64(listing.toObject().value("highest_index").toDouble(0));
+            m_staging.reserve(int(qMin<qint64>(m_highestIndex / 2, 1 << 24)));
+            if (m_highestIndex <= 0) {
+                finishFullSync();
+                return;
+            }
+            fetchNextPages();
+        });
+    });
+}
+
+void UtxoMirror::fetchNextPages()
+{
+    m_rpc->beginGroup();
+    while (m_pagesInFlight < kPipelineDepth && m_nextIndex <= m_highestIndex) {
+        const qint64 start = m_nextIndex;
+        const qint64 end = qMin(start + kPageSize - 1, m_highestIndex);
+        m_nextIndex = end + 1;
+        fetchPage(start, end, 1);
+    }
+    m_rpc->endGroup();
+    emit stateChanged();
+}
+
+void UtxoMirror::fetchPage(qint64 start, qint64 end, int attempt)
+{
+    ++m_pagesInFlight;
+    const QJsonArray params{ double(start), double(end), double(kPageSize), false };
+    request("get_unspent_outputs", params, [this, start, end, attempt](const QJsonValue &listing, const QString &error) {
+        --m_pagesInFlight;
+        if (!error.isEmpty()) {
+            if (attempt < kPageAttempts) {
+                fetchPage(start, end, attempt + 1);
+            } else {
+                fail(error);
+            }
+            return;
+        }
+
+        for (const QJsonValue &v : listing.toObject().value("outputs").toArray()) {
+            const QJsonObject o = v.toObject();
+            const QByteArray commit = QByteArray::fromHex(o.value("commit").toString().toLatin1());
+            if (commit.size() != 33 || o.value("spent").toBool()) {
+                continue;
+            }
+            m_staging.append(makeRecord(commit, qint64(o.value("mmr_index").toDouble()),
+                                        qint64(o.value("block_height").toDouble()),
+                                        o.value("output_type").toString() == "Coinbase"));
+        }
+        m_doneIndexes += end - start + 1;
+
+        if (m_nextIndex > m_highestIndex && m_pagesInFlight == 0) {
+            finishFullSync();
+        } else {
+            fetchNextPages();
+        }
+    });
+}
+
+void UtxoMirror::finishFullSync()
+{
+    std::sort(m_staging.begin(), m_staging.end(), [](const Record &a, const Record &b) {
+        return commitLess(a.commit, b.commit);
+    });
+    m_staging.erase(std::unique(m_staging.begin(), m_staging.end(), [](const Record &a, const Record &b) {
+        return std::memcmp(a.commit, b.commit, 33) == 0;
+    }), m_staging.end());
+
+    m_base.swap(m_staging);
+    m_staging.clear();
+    m_staging.squeeze();
+    m_delta.clear();
+    m_pending.clear();
+    m_undo.clear();
+    rebuildCounts();
+    m_syncedHeight = m_syncTipHeight;
+    m_syncedHash = m_syncTipHash;
+    flush(true);
+
+    m_retryMs = 0;
+    setState(Idle);
+    emit statsChanged();
+
+    // Blöcke, die während des Scans dazukamen
+    refreshTip();
+}
+
+// ---------- Fortschreiben ----------
+
+void UtxoMirror::refreshTip()
+{
+    if (!m_enabled || m_state != Idle || m_syncedHeight < 0) {
+        return;
+    }
+    request("get_tip", QJsonArray(), [this](const QJsonValue &tip, const QString &error) {
+        if (error.isEmpty() && m_state == Idle) {
+            catchUp(qint64(tip.toObject().value("height").toDouble(-1)));
+        }
+    });
+}
+
+/**
+ * @brief UtxoMirror::catchUp
+ * Holt die Blöcke nach m_syncedHeight in Portionen von kBlocksPerRequest
+ * und wendet sie der Reihe nach an. Ein Block, dessen previous nicht zum
+ * zuletzt angewendeten passt, bedeutet einen Reorg: der oberste Block wird
+ * zurückgenommen und ab seiner Höhe neu geholt, bis die Blöcke wieder
+ * anschließen. Reichen die Undo-Daten nicht, folgt ein neuer Erstsync.
+ */
+void UtxoMirror::catchUp(qint64 tipHeight)
+{
+    m_knownTip = qMax(m_knownTip, tipHeight);
+    if (m_knownTip <= m_syncedHeight) {
+        setState(Idle);
+        return;
+    }
+    if (m_knownTip - m_syncedHeight > kMaxCatchUpBlocks) {
+        startFullSync();
+        return;
+    }
+
+    setState(CatchUp);
+    const qint64 from = m_syncedHeight + 1;
+    const qint64 to = qMin(m_knownTip, from + kBlocksPerRequest - 1);
+    const QJsonArray params{ double(from), double(to), double(to - from + 1), false };
+    request("get_blocks", params, [this](const QJsonValue &listing, const QString &error) {
+        if (!error.isEmpty()) {
+            fail(error);
+            return;
+        }
+        const QJsonArray blocks = listing.toObject().value("blocks").toArray();
+        const qint64 before = m_syncedHeight;
+        bool rolledBack = false;
+        for (const QJsonValue &block : blocks) {
+            if (!applyBlock(block.toObject())) {
+                if (!rollback()) {
+                    qWarning() << "UtxoMirror: reorg below height" << m_syncedHeight + 1 << "- resyncing";
+                    startFullSync();
+                    return;
+                }
+                rolledBack = true;
+                break;
+            }
+        }
+        scheduleFlush();
+        emit statsChanged();
+        m_retryMs = 0;
+
+        // nichts geliefert (Node noch nicht so weit): beim nächsten Tip weiter
+        if (!rolledBack && (m_syncedHeight == before || m_syncedHeight >= m_knownTip)) {
+            setState(Idle);
+            return;
+        }
+        catchUp(m_knownTip);
+    });
+}
+
+bool UtxoMirror::applyBlock(const QJsonObject &block)
+{
+    const QJsonObject header = block.value("header").toObject();
+    const qint64 height = qint64(header.value("height").toDouble(-1));
+    if (height != m_syncedHeight + 1) {
+        return height <= m_syncedHeight;    // schon angewendet: überspringen
+    }
+    const QByteArray previous = QByteArray::fromHex(header.value("previous").toString().toLatin1());
+    if (!m_syncedHash.isEmpty() && previous != m_syncedHash) {
+        return false;
+    }
+
+    Undo undo;
+    undo.height = height;
+    undo.previous = previous;
+    for (const QJsonValue &input : block.value("inputs").toArray()) {
+        const QString hex = input.isObject() ? input.toObject().value("commit").toString() : input.toString();
+        Record spent;
+        if (remove(QByteArray::fromHex(hex.toLatin1()), &spent)) {
+            undo.spent.append(spent);
+        }
+    }
+    for (const QJsonValue &v : block.value("outputs").toArray()) {
+        const QJsonObject o = v.toObject();
+        const QByteArray commit = QByteArray::fromHex(o.value("commit").toString().toLatin1());
+        if (commit.size() != 33) {
+            continue;
+        }
+        if (insert(makeRecord(commit, qint64(o.value("mmr_index").toDouble()), height,
+                              o.value("output_type").toString() == "Coinbase"))) {
+            undo.created.append(commit);
+        }
+    }
+
+    setMarker(height, QByteArray::fromHex(header.value("hash").toString().toLatin1()));
+    m_undo.append(undo);
+    if (m_undo.size() > kUndoBlocks) {
+        m_undo.removeFirst();
+    }
+    return true;
+}
+
+/**
+ * @brief UtxoMirror::rollback
+ * Nimmt den zuletzt angewendeten Block zurück: neue Outputs raus, ausgegebene
+ * wieder rein, Marker auf den Block davor. false, wenn dafür keine
+ * Undo-Daten da sind (tiefer als kUndoBlocks oder seit dem Laden der Datei).
+ */
+bool UtxoMirror::rollback()
+{
+    if (m_undo.isEmpty() || m_undo.last().height != m_syncedHeight) {
+        return false;
+    }
+    const Undo undo = m_undo.takeLast();
+    for (const QByteArray &commit : undo.created) {
+        remove(commit);
+    }
+    for (const Record &r : undo.spent) {
+        insert(r);
+    }
+    setMarker(undo.height - 1, undo.previous);
+    return true;
+}
+
+// ---------- Menge ----------
+
+UtxoMirror::Record UtxoMirror::makeRecord(const QByteArray &commit, qint64 mmrIndex, qint64 height, bool coinbase)
+{
+    Record r;
+    std::memset(&r, 0, sizeof(r));
+    r.version = kRecordVersion;
+    r.flags = coinbase ? CoinbaseFlag : 0;
+    r.mmrIndex = quint64(qMax<qint64>(0, mmrIndex));
+    r.height = quint32(qMax<qint64>(0, height));
+    std::memcpy(r.commit, commit.constData(), qMin(commit.size(), int(sizeof(r.commit))));
+    return r;
+}
+
+QByteArray UtxoMirror::keyOf(const Record &r)
+{
+    return QByteArray(r.commit, int(sizeof(r.commit)));
+}
+
+const UtxoMirror::Record *UtxoMirror::findInBase(const QByteArray &commit) const
+{
+    const char *key = commit.constData();
+    const auto it = std::lower_bound(m_base.constBegin(), m_base.constEnd(), key, [](const Record &r, const char *k) {
+        return commitLess(r.commit, k);
+    });
+    if (it == m_base.constEnd() || std::memcmp(it->commit, key, 33) != 0) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+const UtxoMirror::Record *UtxoMirror::find(const QByteArray &commit) const
+{
+    const auto it = m_delta.constFind(commit);
+    if (it != m_delta.constEnd()) {
+        return (it->flags & RemovedFlag) ? nullptr : &it.value();
+    }
+    return findInBase(commit);
+}
+
+// false, wenn das Commitment schon in der Menge ist
+bool UtxoMirror::insert(const Record &r)
+{
+    const QByteArray key = keyOf(r);
+    if (find(key)) {
+        return false;
+    }
+    m_delta.insert(key, r);
+    account(r, 1);
+    m_pending.append(r);
+    if (m_delta.size() > kMergeThreshold) {
+        merge();
+    }
+    return true;
+}
+
+// false, wenn das Commitment nicht in der Menge ist; sonst der entfernte
+// Record (ohne RemovedFlag) in *out
+bool UtxoMirror::remove(const QByteArray &commit, Record *out)
+{
+    if (commit.size() != 33) {
+        return false;
+    }
+    const Record *existing = find(commit);
+    if (!existing) {
+        return false;
+    }
+    if (out) {
+        *out = *existing;
+    }
+    Record removed = *existing;
+    removed.flags |= RemovedFlag;
+    account(*existing, -1);
+
+    if (findInBase(commit)) {
+        m_delta.insert(commit, removed);
+    } else {
+        m_delta.remove(commit);
+    }
+    m_pending.append(removed);
+    return true;
+}
+
+void UtxoMirror::account(const Record &r, int delta)
+{
+    const bool coinbase = r.flags & CoinbaseFlag;
+    m_count += delta;
+    if (coinbase) {
+        m_coinbaseCount += delta;
+    }
+    const qint64 bucket = qint64(r.height) / kBucketBlocks;
+    Counts &c = m_buckets[bucket];
+    c.count += delta;
+    if (coinbase) {
+        c.coinbase += delta;
+    }
+    if (c.count <= 0) {
+        m_buckets.remove(bucket);
+    }
+}
+
+void UtxoMirror::setMarker(qint64 height, const QByteArray &hash)
+{
+    m_syncedHeight = height;
+    m_syncedHash = hash;
+
+    Record m = makeRecord(hash, height, 0, false);
+    m.flags = MarkerFlag;
+    m_pending.append(m);
+}
+
+// Delta in den sortierten Vektor einarbeiten (zwei sortierte Folgen mischen)
+void UtxoMirror::merge()
+{
+    if (m_delta.isEmpty()) {
+        return;
+    }
+
+    QVector<Record> added;
+    for (const Record &r : m_delta) {
+        if (!(r.flags & RemovedFlag)) {
+            added.append(r);
+        }
+    }
+    std::sort(added.begin(), added.end(), [](const Record &a, const Record &b) {
+        return commitLess(a.commit, b.commit);
+    });
+
+    QVector<Record> kept;
+    kept.reserve(m_base.size());
+    for (const Record &r : m_base) {
+        if (!m_delta.contains(keyOf(r))) {
+            kept.append(r);
+        }
+    }
+
+    QVector<Record> merged(kept.size() + added.size());
+    std::merge(kept.constBegin(), kept.constEnd(), added.constBegin(), added.constEnd(), merged.begin(),
+               [](const Record &a, const Record &b) {
+        return commitLess(a.commit, b.commit);
+    });
+    m_base.swap(merged);
+    m_delta.clear();
+}
+
+void UtxoMirror::rebuildCounts()
+{
+    merge();
+    m_count = 0;
+    m_coinbaseCount = 0;
+    m_buckets.clear();
+    for (const Record &r : m_base) {
+        account(r, 1);
+    }
+}
+
+void UtxoMirror::clearSet()
+{
+    m_base.clear();
+    m_base.squeeze();
+    m_delta.clear();
+    m_pending.clear();
+    m_count = 0;
+    m_coinbaseCount = 0;
+    m_buckets.clear();
+    m_syncedHeight = -1;
+    m_syncedHash.clear();
+    m_knownTip = -1;
+    m_undo.clear();
+}
+
+// ---------- Persistenz ----------
+
+void UtxoMirror::parse(const uchar *data, qint64 size)
+{
+    QHash<QByteArray, Record> live;
+    for (qint64 pos = 0; pos + qint64(sizeof(Record)) <= size; pos += qint64(sizeof(Record))) {
+        Record r;
+        std::memcpy(&r, data + pos, sizeof(Record));
+        if (r.version != kRecordVersion) {
+            break;      // abgeschnittenes Ende oder fremdes Format
+        }
+        if (r.flags & MarkerFlag) {
+            m_syncedHeight = qint64(r.mmrIndex);
+            m_syncedHash = QByteArray(r.commit, 32);
+        } else if (r.flags & RemovedFlag) {
+            live.remove(keyOf(r));
+        } else {
+            live.insert(keyOf(r), r);
+        }
+    }
+
+    m_base.clear();
+    m_base.reserve(live.size());
+    for (const Record &r : live) {
+        m_base.append(r);
+    }
+    std::sort(m_base.begin(), m_base.end(), [](const Record &a, const Record &b) {
+        return commitLess(a.commit, b.commit);
+    });
+    rebuildCounts();
+}
+
+// Sortierte Menge plus Höhenmarker am Ende
+QByteArray UtxoMirror::snapshot() const
+{
+    QByteArray out;
+    out.reserve(int((m_base.size() + 1) * sizeof(Record)));
+    out.append(reinterpret_cast<const char *>(m_base.constData()), int(m_base.size() * sizeof(Record)));
+    if (m_syncedHeight >= 0) {
+        Record m = makeRecord(m_syncedHash, m_syncedHeight, 0, false);
+        m.flags = MarkerFlag;
+        out.append(reinterpret_cast<const char *>(&m), int(sizeof(m)));
+    }
+    return out;
+}
+
+void UtxoMirror::scheduleFlush()
+{
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+/**
+ * @brief UtxoMirror::flush
+ * Hängt die gesammelten Änderungen an. Enthält die Datei deutlich mehr
+ * Records als die Menge selbst, wird sie als Snapshot neu geschrieben.
+ */
+void UtxoMirror::flush(bool compact)
+{
+    m_flushTimer.stop();
+    if (m_chainId.isEmpty() || m_syncedHeight < 0 || (m_pending.isEmpty() && !compact)) {
+        return;
+    }
+    const qint64 storedRecords = m_store.size() / qint64(sizeof(Record));
+    compact = compact || storedRecords + m_pending.size() > 2 * qint64(m_count) + kCompactSlackRecords;
+
+    bool written = false;
+    if (compact) {
+        merge();
+        written = m_store.rewrite(snapshot());
+    } else {
+        written = m_store.append(QByteArray(reinterpret_cast<const char *>(m_pending.constData()),
+                                            int(m_pending.size() * sizeof(Record))));
+    }
+    if (!written) {
+        return;
+    }
+    m_pending.clear();
+}
@@ -0,0 +1,216 @@
+#ifndef UTXOMIRROR_H
+#define UTXOMIRROR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+
+#include <functional>
+
+#include "storage/appendlogstore.h"
+
+class ChainRpc;
+class JsonRpcBatcher;
+class PollScheduler;
+
+// Optionaler lokaler Spiegel der kompletten UTXO-Menge.
+// Erstsync: get_unspent_outputs über feste MMR-Indexbereiche, mehrere
+// Seiten gleichzeitig (der Batcher bündelt sie). Danach pro Block aus den
+// Inputs/Outputs von get_blocks fortgeschrieben. Für die letzten
+// kUndoBlocks Blöcke (Reorg-Horizont der ChainCache) bleiben ausgegebene und
+// neue Outputs im Speicher; passt previous nicht zum zuletzt angewendeten
+// Block (Reorg), werden Blöcke damit zurückgenommen, erst ein tieferer Reorg
+// (oder einer direkt nach dem Start) führt zum neuen Erstsync.
+// Im Speicher: nach Commitment sortierter Vektor fester 48-Byte-Records
+// plus kleines Delta (Hash) für Änderungen seit dem letzten Merge.
+// Anzahl, Coinbase-Anteil und Verteilung je kBucketBlocks Höhen werden
+// laufend mitgezählt, Abfragen brauchen also keinen RPC.
+// Gespeichert werden dieselben Records im AppendLogStore: Snapshot plus
+// angehängte Änderungen (Entfernt- und Höhenmarker-Records), kompaktiert
+// wie ChainCache. Pro Chain (Genesis-Hash) ein Speicher; die Chain kommt
+// von ChainRpc, Endpunkt und Auth vom geteilten Batcher. Fehlgeschlagene
+// Läufe werden mit wachsendem Abstand wiederholt.
+class UtxoMirror : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(bool syncing READ syncing NOTIFY stateChanged)
+    Q_PROPERTY(bool ready READ ready NOTIFY stateChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY stateChanged)
+    Q_PROPERTY(QString lastError READ lastError NOTIFY stateChanged)
+    Q_PROPERTY(int syncedHeight READ syncedHeight NOTIFY statsChanged)
+    Q_PROPERTY(int count READ count NOTIFY statsChanged)
+    Q_PROPERTY(int coinbaseCount READ coinbaseCount NOTIFY statsChanged)
+public:
+    // rpc: Batcher für v2/foreign, geteilt mit chain
+    UtxoMirror(JsonRpcBatcher *rpc, ChainRpc *chain, QObject *parent = nullptr);
+    ~UtxoMirror() override;
+
+    // Neue Blöcke über den gemeinsamen Takt prüfen (solange aktiv)
+    void setScheduler(PollScheduler *scheduler);
+
+    bool enabled() const
+    {
+        return m_enabled;
+    }
+    void setEnabled(bool enabled);
+
+    bool syncing() const
+    {
+        return m_state == FullSync || m_state == CatchUp;
+    }
+    bool ready() const
+    {
+        return m_syncedHeight >= 0 && m_state != FullSync;
+    }
+    double progress() const;
+    QString lastError() const
+    {
+        return m_lastError;
+    }
+    int syncedHeight() const
+    {
+        return int(m_syncedHeight);
+    }
+    int count() const
+    {
+        return m_count;
+    }
+    int coinbaseCount() const
+    {
+        return m_coinbaseCount;
+    }
+
+    // { commit, mmr_index, block_height, output_type } oder leer
+    Q_INVOKABLE QVariantMap lookup(const QString &commitHex) const;
+    Q_INVOKABLE bool contains(const QString &commitHex) const;
+    // [{ height, count, coinbase }] je bucketBlocks Höhen (auf kBucketBlocks gerundet)
+    Q_INVOKABLE QVariantList heightDistribution(int bucketBlocks = 1440) const;
+    // Neuer Tip bekannt (Push-Event, Chain-Ansicht): Blöcke nachziehen
+    Q_INVOKABLE void notifyTip(int height);
+    Q_INVOKABLE void resync();
+
+signals:
+    void enabledChanged();
+    void stateChanged();
+    void statsChanged();
+
+private:
+    enum State {
+        Idle, Opening, FullSync, CatchUp
+    };
+
+    enum Flag : quint8 {
+        CoinbaseFlag = 1,
+        RemovedFlag = 2,        // Änderung: Output wurde ausgegeben
+        MarkerFlag = 4          // synchronisierte Höhe; commit = Blockhash
+    };
+
+    // Fester Record im Speicher und auf Platte
+    struct Record {
+        quint64 mmrIndex;       // Marker: Höhe
+        quint32 height;
+        quint8 version;
+        quint8 flags;
+        char commit[33];
+        char reserved;
+    };
+
+    struct Counts {
+        int count = 0;
+        int coinbase = 0;
+    };
+
+    // Was ein angewendeter Block geändert hat, zum Zurücknehmen
+    struct Undo {
+        qint64 height;
+        QByteArray previous;            // Hash des Blocks davor
+        QVector<Record> spent;          // ausgegebene Outputs wie vor dem Block
+        QVector<QByteArray> created;    // neu eingefügte Commitments
+    };
+
+    typedef std::function<void(const QJsonValue &result, const QString &error)> Done;
+
+    void request(const QString &method, const QJsonArray &params, Done done);
+    void setState(State state);
+    void fail(const QString &message);
+
+    void open();
+    void onChainOpened();
+    void onEndpointChanged();
+    void retry();
+    void startFullSync();
+    void fetchNextPages();
+    void fetchPage(qint64 start, qint64 end, int attempt);
+    void finishFullSync();
+    void refreshTip();
+    void catchUp(qint64 tipHeight);
+    bool applyBlock(const QJsonObject &block);
+    bool rollback();
+
+    const Record *find(const QByteArray &commit) const;
+    const Record *findInBase(const QByteArray &commit) const;
+    bool insert(const Record &r);
+    bool remove(const QByteArray &commit, Record *removed = nullptr);
+    void account(const Record &r, int delta);
+    void setMarker(qint64 height, const QByteArray &hash);
+    void merge();
+    void rebuildCounts();
+    void clearSet();
+
+    static Record makeRecord(const QByteArray &commit, qint64 mmrIndex, qint64 height, bool coinbase);
+    static QByteArray keyOf(const Record &r);
+
+    void parse(const uchar *data, qint64 size);
+    QByteArray snapshot() const;
+    void scheduleFlush();
+    void flush(bool compact = false);
+
+    JsonRpcBatcher *m_rpc;
+    ChainRpc *m_chain;
+    PollScheduler *m_scheduler{nullptr};
+    bool m_enabled{false};
+    State m_state{Idle};
+    QString m_lastError;
+    int m_generation{0};        // verwirft Antworten nach resync()/Abschalten
+    QTimer m_retryTimer;
+    int m_retryMs{0};           // nächster Abstand, 0 = kein Fehler seit dem letzten Erfolg
+
+    // UTXO-Menge
+    QVector<Record> m_base;                 // nach Commitment sortiert
+    QHash<QByteArray, Record> m_delta;      // Zugänge bzw. RemovedFlag für Einträge aus m_base
+    int m_count{0};
+    int m_coinbaseCount{0};
+    QMap<qint64, Counts> m_buckets;         // Höhe / kBucketBlocks -> Anzahl
+    qint64 m_syncedHeight{-1};
+    QByteArray m_syncedHash;                // Hash des zuletzt angewendeten Blocks
+
+    // Erstsync
+    QVector<Record> m_staging;
+    qint64 m_highestIndex{0};
+    qint64 m_nextIndex{1};
+    qint64 m_doneIndexes{0};
+    int m_pagesInFlight{0};
+    qint64 m_syncTipHeight{-1};
+    QByteArray m_syncTipHash;
+
+    // Fortschreiben
+    qint64 m_knownTip{-1};
+    QVector<Undo> m_undo;                   // höchstens kUndoBlocks, jüngster hinten
+
+    // Persistenz
+    QString m_chainId;
+    QVector<Record> m_pending;
+    QTimer m_flushTimer;
+    AppendLogStore m_store;
+};
+
+#endif // UTXOMIRROR_H
@@ -0,0 +1,508 @@
+#include "utxomodel.h"
+
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QtAlgorithms>
+
+#include <algorithm>
+
+namespace {
+
+inline void setBit(QVector<quint64> &bits, int row)
+{
+    bits[row >> 6] |= quint64(1) << (row & 63);
+}
+
+inline bool testBit(const QVector<quint64> &bits, int row)
+{
+    return (bits.at(row >> 6) >> (row & 63)) & 1;
+}
+
+bool isHex(const QByteArray &s)
+{
+    for (char c : s) {
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isDigits(const QByteArray &s)
+{
+    for (char c : s) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+qint64 toIndex(const QVariant &v)
+{
+    bool ok = false;
+    const qint64 n = v.toLongLong(&ok);
+    return ok ? n : -1;
+}
+
+#if !QT_CONFIG(thread)
+const int kSliceRows = 2000;        // Zeilen pro Einlese-Schritt
+const int kSliceBudgetMs = 8;       // danach kommt der Event-Loop wieder dran
+#endif
+
+} // namespace
+
+// ---------- Worker ----------
+
+void UtxoFilterWorker::setOutputs(const QVariantList &outputs, const UtxoQuery &query)
+{
+    m_pendingOutputs = outputs;
+    m_outputsPending = true;
+    m_query = query;
+    schedule();
+}
+
+void UtxoFilterWorker::setQuery(const UtxoQuery &query)
+{
+    m_query = query;
+    schedule();
+}
+
+// Bereits eingereihte Anfragen werden noch übernommen, bevor run() rechnet;
+// beim Tippen wird so nur die jeweils letzte ausgewertet.
+void UtxoFilterWorker::schedule()
+{
+    if (m_runPending) {
+        return;
+    }
+    m_runPending = true;
+    QMetaObject::invokeMethod(this, "run", Qt::QueuedConnection);
+}
+
+void UtxoFilterWorker::run()
+{
+    m_runPending = false;
+#if QT_CONFIG(thread)
+    if (m_outputsPending) {
+        QSharedPointer<UtxoIndex> index = beginIndex(m_pendingOutputs);
+        readRows(*index, 0, index->raw.size());
+        finishIndex(*index);
+        m_index = index;
+        m_pendingOutputs.clear();
+        m_outputsPending = false;
+    }
+#else
+    if (m_outputsPending) {
+        // eine neue Seite verwirft einen halb eingelesenen Index
+        m_building = beginIndex(m_pendingOutputs);
+        m_buildRow = 0;
+        m_pendingOutputs.clear();
+        m_outputsPending = false;
+    }
+    if (m_building && !buildSlice()) {
+        schedule();
+        return;
+    }
+#endif
+
+    UtxoResult result;
+    result.index = m_index;
+    result.generation = m_query.generation;
+    if (m_index) {
+        result.rows = evaluate(*m_index, m_query);
+    }
+    emit resultReady(result);
+}
+
+#if !QT_CONFIG(thread)
+/**
+ * @brief UtxoFilterWorker::buildSlice
+ * Liest Zeilen von m_building in Stücken von kSliceRows ein, bis das
+ * Zeitbudget aufgebraucht ist. true, wenn der Index fertig ist.
+ */
+bool UtxoFilterWorker::buildSlice()
+{
+    QElapsedTimer budget;
+    budget.start();
+    const int n = m_building->raw.size();
+    while (m_buildRow < n && budget.elapsed() < kSliceBudgetMs) {
+        const int to = qMin(n, m_buildRow + kSliceRows);
+        readRows(*m_building, m_buildRow, to);
+        m_buildRow = to;
+    }
+    if (m_buildRow < n) {
+        return false;
+    }
+    finishIndex(*m_building);
+    m_index = m_building;
+    m_building.clear();
+    return true;
+}
+#endif
+
+/**
+ * @brief UtxoFilterWorker::beginIndex
+ * Legt den Index für outputs an. Danach liest readRows() die Zeilen ein und
+ * finishIndex() baut den Commitment-Index, die beiden Sortierreihenfolgen
+ * samt Rang; die Bitmaps für Typ und Spent entstehen beim Einlesen.
+ */
+QSharedPointer<UtxoIndex> UtxoFilterWorker::beginIndex(const QVariantList &outputs)
+{
+    QSharedPointer<UtxoIndex> index(new UtxoIndex);
+    index->raw = outputs;
+
+    const int n = outputs.size();
+    const int words = (n + 63) / 64;
+    index->records.reserve(n);
+    for (QVector<quint64> &bits : index->typeBits) {
+        bits.fill(0, words);
+    }
+    index->spentBits.fill(0, words);
+    return index;
+}
+
+// Zeilen [from, to) einlesen; to ist höchstens raw.size()
+void UtxoFilterWorker::readRows(UtxoIndex &index, int from, int to)
+{
+    for (int row = from; row < to; ++row) {
+        const QVariantMap output = index.raw.at(row).toMap();
+
+        UtxoRecord r;
+        r.commit = UtxoModel::commitHex(output).toLatin1().toLower();
+        r.mmrIndex = toIndex(output.value("mmr_index"));
+        r.height = toIndex(output.value("block_height"));
+        r.mmrText = r.mmrIndex >= 0 ? QByteArray::number(r.mmrIndex) : QByteArray();
+        r.heightText = r.height >= 0 ? QByteArray::number(r.height) : QByteArray();
+
+        const QString type = output.value("output_type").toString();
+        r.type = type == "Coinbase" ? UtxoModel::Coinbase
+                 : type == "Transaction" ? UtxoModel::Plain : UtxoModel::Unknown;
+        r.spent = output.value("spent").toBool();
+
+        setBit(index.typeBits[r.type], row);
+        if (r.spent) {
+            setBit(index.spentBits, row);
+        }
+        index.records.append(r);
+    }
+}
+
+void UtxoFilterWorker::finishIndex(UtxoIndex &index)
+{
+    const int n = index.records.size();
+    const QVector<UtxoRecord> &recs = index.records;
+    index.byCommit.resize(n);
+    for (int row = 0; row < n; ++row) {
+        index.byCommit[row] = row;
+    }
+    index.order[UtxoModel::ByMmrIndex] = index.byCommit;
+    index.order[UtxoModel::ByHeight] = index.byCommit;
+
+    std::sort(index.byCommit.begin(), index.byCommit.end(), [&recs](int a, int b) {
+        return recs.at(a).commit < recs.at(b).commit;
+    });
+    std::stable_sort(index.order[UtxoModel::ByMmrIndex].begin(), index.order[UtxoModel::ByMmrIndex].end(),
+                     [&recs](int a, int b) {
+        if (recs.at(a).mmrIndex != recs.at(b).mmrIndex) {
+            return recs.at(a).mmrIndex > recs.at(b).mmrIndex;
+        }
+        return recs.at(a).height > recs.at(b).height;
+    });
+    std::stable_sort(index.order[UtxoModel::ByHeight].begin(), index.order[UtxoModel::ByHeight].end(),
+                     [&recs](int a, int b) {
+        if (recs.at(a).height != recs.at(b).height) {
+            return recs.at(a).height > recs.at(b).height;
+        }
+        return recs.at(a).mmrIndex > recs.at(b).mmrIndex;
+    });
+
+    for (int key = 0; key < 2; ++key) {
+        index.rank[key].resize(n);
+        for (int pos = 0; pos < n; ++pos) {
+            index.rank[key][index.order[key].at(pos)] = pos;
+        }
+    }
+}
+
+/**
+ * @brief UtxoFilterWorker::evaluate
+ * Typ und Spent werden als Bitmap verknüpft. Ohne Suchtext liefert ein Lauf
+ * über die vorsortierte Reihenfolge das Ergebnis; mit Suchtext kommen die
+ * Kandidaten aus dem Commitment-Präfixbereich (binäre Suche) bzw. aus den
+ * Dezimaltexten und werden nach ihrem Rang sortiert.
+ */
+QVector<int> UtxoFilterWorker::evaluate(const UtxoIndex &index, const UtxoQuery &query)
+{
+    const int n = index.records.size();
+    const int words = (n + 63) / 64;
+    const int key = query.sortKey == UtxoModel::ByHeight ? UtxoModel::ByHeight : UtxoModel::ByMmrIndex;
+
+    QVector<quint64> mask(words, ~quint64(0));
+    if (query.type >= 0 && query.type < 3) {
+        mask = index.typeBits[query.type];
+    }
+    if (query.spent != UtxoModel::AnySpent) {
+        const bool wantSpent = query.spent == UtxoModel::SpentOnly;
+        for (int w = 0; w < words; ++w) {
+            mask[w] &= wantSpent ? index.spentBits.at(w) : ~index.spentBits.at(w);
+        }
+    }
+
+    QVector<int> rows;
+    if (query.search.isEmpty()) {
+        const QVector<int> &order = index.order[key];
+        rows.reserve(n);
+        for (int pos = 0; pos < n; ++pos) {
+            const int row = order.at(query.descending ? pos : n - 1 - pos);
+            if (testBit(mask, row)) {
+                rows.append(row);
+            }
+        }
+        return rows;
+    }
+
+    QVector<quint64> hits(words, 0);
+    if (isHex(query.search)) {
+        const QByteArray &prefix = query.search;
+        const QVector<UtxoRecord> &recs = index.records;
+        auto lo = std::lower_bound(index.byCommit.constBegin(), index.byCommit.constEnd(), prefix,
+                                   [&recs](int row, const QByteArray &p) {
+            return recs.at(row).commit < p;
+        });
+        for (auto it = lo; it != index.byCommit.constEnd() && recs.at(*it).commit.startsWith(prefix); ++it) {
+            setBit(hits, *it);
+        }
+    }
+    if (isDigits(query.search)) {
+        for (int row = 0; row < n; ++row) {
+            const UtxoRecord &r = index.records.at(row);
+            if (r.mmrText.contains(query.search) || r.heightText.contains(query.search)) {
+                setBit(hits, row);
+            }
+        }
+    }
+
+    for (int w = 0; w < words; ++w) {
+        quint64 bits = hits.at(w) & mask.at(w);
+        while (bits) {
+            const int bit = qCountTrailingZeroBits(bits);
+            rows.append(w * 64 + bit);
+            bits &= bits - 1;
+        }
+    }
+
+    const QVector<int> &rank = index.rank[key];
+    const bool descending = query.descending;
+    std::sort(rows.begin(), rows.end(), [&rank, descending](int a, int b) {
+        return descending ? rank.at(a) < rank.at(b) : rank.at(a) > rank.at(b);
+    });
+    return rows;
+}
+
+// ---------- Model ----------
+
+UtxoModel::UtxoModel(QObject *parent) :
+    QAbstractListModel(parent)
+{
+    qRegisterMetaType<UtxoIndexPtr>("UtxoIndexPtr");
+    qRegisterMetaType<UtxoQuery>("UtxoQuery");
+    qRegisterMetaType<UtxoResult>("UtxoResult");
+
+    m_worker = new UtxoFilterWorker;
+#if QT_CONFIG(thread)
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+#else
+    // Ohne Thread-Support läuft der Worker im UI-Thread und liest große
+    // Seiten in Zeitscheiben ein
+    m_worker->setParent(this);
+#endif
+    connect(this, &UtxoModel::outputsRequested, m_worker, &UtxoFilterWorker::setOutputs);
+    connect(this, &UtxoModel::queryRequested, m_worker, &UtxoFilterWorker::setQuery);
+    connect(m_worker, &UtxoFilterWorker::resultReady, this, &UtxoModel::onResultReady);
+#if QT_CONFIG(thread)
+    m_thread.start(QThread::LowPriority);
+#endif
+}
+
+UtxoModel::~UtxoModel()
+{
+#if QT_CONFIG(thread)
+    m_thread.quit();
+    m_thread.wait();
+#endif
+}
+
+int UtxoModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_rows.size();
+}
+
+QVariant UtxoModel::data(const QModelIndex &index, int role) const
+{
+    if (!m_index || !index.isValid() || index.row() < 0 || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+
+    const int row = m_rows.at(index.row());
+    const UtxoRecord &r = m_index->records.at(row);
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case CommitRole:
+        return QString::fromLatin1(r.commit);
+    case OutputTypeRole:
+        return m_index->raw.at(row).toMap().value("output_type").toString();
+    case BlockHeightRole:
+        return r.height;
+    case MmrIndexRole:
+        return r.mmrIndex;
+    case SpentRole:
+        return r.spent;
+    case ProofHashRole:
+        return m_index->raw.at(row).toMap().value("proof_hash").toString();
+    }
+    return QVariant();
+}
+
+QHash<int, QByteArray> UtxoModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[CommitRole] = "commit";
+    roles[OutputTypeRole] = "outputType";
+    roles[BlockHeightRole] = "blockHeight";
+    roles[MmrIndexRole] = "mmrIndex";
+    roles[SpentRole] = "spent";
+    roles[ProofHashRole] = "proofHash";
+    return roles;
+}
+
+void UtxoModel::setOutputs(const QVariantList &outputs)
+{
+    emit outputsRequested(outputs, currentQuery());
+    emit busyChanged();
+}
+
+void UtxoModel::clear()
+{
+    const UtxoQuery query = currentQuery();
+
+    beginResetModel();
+    m_index.clear();
+    m_rows.clear();
+    m_shownGeneration = m_pendingGeneration;
+    endResetModel();
+
+    emit outputsRequested(QVariantList(), query);
+    emit countChanged();
+    emit busyChanged();
+}
+
+QVariantMap UtxoModel::get(int row) const
+{
+    if (!m_index || row < 0 || row >= m_rows.size()) {
+        return QVariantMap();
+    }
+    return m_index->raw.at(m_rows.at(row)).toMap();
+}
+
+// commit als String oder Objekt mit hex/commitment (wie in den API-Antworten)
+QString UtxoModel::commitHex(const QVariantMap &output)
+{
+    const QVariant commit = output.value("commit");
+    if (commit.typeId() == QMetaType::QVariantMap) {
+        const QVariantMap m = commit.toMap();
+        if (m.contains("hex")) {
+            return m.value("hex").toString();
+        }
+        return m.value("commitment").toString();
+    }
+    return commit.toString();
+}
+
+void UtxoModel::setSearchText(const QString &text)
+{
+    if (m_searchText == text) {
+        return;
+    }
+    m_searchText = text;
+    requery();
+}
+
+void UtxoModel::setTypeFilter(int type)
+{
+    if (m_typeFilter == type) {
+        return;
+    }
+    m_typeFilter = type;
+    requery();
+}
+
+void UtxoModel::setSpentFilter(int filter)
+{
+    if (m_spentFilter == filter) {
+        return;
+    }
+    m_spentFilter = filter;
+    requery();
+}
+
+void UtxoModel::setSortKey(int key)
+{
+    if (m_sortKey == key) {
+        return;
+    }
+    m_sortKey = key;
+    requery();
+}
+
+void UtxoModel::setDescending(bool descending)
+{
+    if (m_descending == descending) {
+        return;
+    }
+    m_descending = descending;
+    requery();
+}
+
+// ---------- intern ----------
+
+UtxoQuery UtxoModel::currentQuery()
+{
+    UtxoQuery query;
+    query.search = m_searchText.trimmed().toLower().toLatin1();
+    query.type = m_typeFilter;
+    query.spent = m_spentFilter;
+    query.sortKey = m_sortKey;
+    query.descending = m_descending;
+    query.generation = ++m_pendingGeneration;
+    return query;
+}
+
+void UtxoModel::requery()
+{
+    emit filterChanged();
+    emit queryRequested(currentQuery());
+    emit busyChanged();
+}
+
+// Nur das Ergebnis der letzten Anfrage wird übernommen, Index und Zeilen
+// zusammen, damit der View nie einen halben Stand sieht.
+void UtxoModel::onResultReady(const UtxoResult &result)
+{
+    if (result.generation != m_pendingGeneration) {
+        return;
+    }
+
+    beginResetModel();
+    m_index = result.index;
+    m_rows = result.rows;
+    m_shownGeneration = result.generation;
+    endResetModel();
+
+    emit countChanged();
+    emit busyChanged();
+}
@@ -0,0 +1,205 @@
+#ifndef UTXOMODEL_H
+#define UTXOMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QSharedPointer>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QVector>
+
+#if QT_CONFIG(thread)
+#include <QThread>
+#endif
+
+// Kompakte Sicht auf eine Ausgabe (nur was Filter und Sortierung brauchen)
+struct UtxoRecord {
+    QByteArray commit;      // Hex, lowercase
+    QByteArray mmrText;     // Dezimaltext für die Suche
+    QByteArray heightText;
+    qint64 mmrIndex;        // -1 = unbekannt
+    qint64 height;
+    quint8 type;            // UtxoModel::OutputType
+    bool spent;
+};
+
+// Unveränderlicher Index über eine Seite Ausgaben; wird im Worker gebaut
+// und danach von Worker und UI-Thread nur gelesen.
+struct UtxoIndex {
+    QVariantList raw;               // Originalobjekte (Details, Proof-Hash)
+    QVector<UtxoRecord> records;
+    QVector<int> byCommit;          // Zeilen nach Commitment sortiert (Präfixsuche)
+    QVector<int> order[2];          // Zeilen je Sortierschlüssel, absteigend
+    QVector<int> rank[2];           // Position jeder Zeile in order
+    QVector<quint64> typeBits[3];   // Bitmap je OutputType
+    QVector<quint64> spentBits;
+};
+typedef QSharedPointer<const UtxoIndex> UtxoIndexPtr;
+
+struct UtxoQuery {
+    QByteArray search;      // lowercase, getrimmt
+    int type;               // -1 = alle
+    int spent;              // UtxoModel::SpentFilter
+    int sortKey;            // UtxoModel::SortKey
+    bool descending;
+    quint64 generation;
+};
+
+struct UtxoResult {
+    UtxoIndexPtr index;
+    QVector<int> rows;      // sichtbare Zeilen in Anzeigereihenfolge
+    quint64 generation;
+};
+Q_DECLARE_METATYPE(UtxoIndexPtr)
+Q_DECLARE_METATYPE(UtxoQuery)
+Q_DECLARE_METATYPE(UtxoResult)
+
+// Baut Indizes und wertet Filter aus (läuft im Worker-Thread, ohne
+// Thread-Support in Zeitscheiben im UI-Thread).
+// Anfragen, die schon von einer neueren überholt wurden, entfallen.
+class UtxoFilterWorker : public QObject
+{
+    Q_OBJECT
+public slots:
+    void setOutputs(const QVariantList &outputs, const UtxoQuery &query);
+    void setQuery(const UtxoQuery &query);
+
+signals:
+    void resultReady(const UtxoResult &result);
+
+private slots:
+    void run();
+
+private:
+    static QSharedPointer<UtxoIndex> beginIndex(const QVariantList &outputs);
+    static void readRows(UtxoIndex &index, int from, int to);
+    static void finishIndex(UtxoIndex &index);
+    static QVector<int> evaluate(const UtxoIndex &index, const UtxoQuery &query);
+    void schedule();
+#if !QT_CONFIG(thread)
+    bool buildSlice();
+#endif
+
+    UtxoIndexPtr m_index;
+    QVariantList m_pendingOutputs;
+    bool m_outputsPending{false};
+    UtxoQuery m_query;
+    bool m_runPending{false};
+#if !QT_CONFIG(thread)
+    // WASM single-threaded: Index im Aufbau, eingelesen bis m_buildRow
+    QSharedPointer<UtxoIndex> m_building;
+    int m_buildRow{0};
+#endif
+};
+
+// Ausgaben einer UTXO-Seite für Utxo.qml. Suche, Typ-/Spent-Filter und
+// Sortierung laufen im Worker; das Ergebnis wird als Ganzes getauscht.
+// Der Delegate liest nur die Rollen der sichtbaren Zeilen, get(row) liefert
+// das Originalobjekt für den Details-Dialog.
+// Suche: Commitment-Präfix (sortierter Index) sowie Teilstring in MMR-Index
+// und Blockhöhe.
+class UtxoModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int totalCount READ totalCount NOTIFY countChanged)
+    Q_PROPERTY(bool busy READ busy NOTIFY busyChanged)
+    Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY filterChanged)
+    Q_PROPERTY(int typeFilter READ typeFilter WRITE setTypeFilter NOTIFY filterChanged)
+    Q_PROPERTY(int spentFilter READ spentFilter WRITE setSpentFilter NOTIFY filterChanged)
+    Q_PROPERTY(int sortKey READ sortKey WRITE setSortKey NOTIFY filterChanged)
+    Q_PROPERTY(bool descending READ descending WRITE setDescending NOTIFY filterChanged)
+public:
+    enum OutputType {
+        Coinbase = 0, Plain, Unknown
+    };
+    Q_ENUM(OutputType)
+
+    enum SpentFilter {
+        AnySpent = 0, UnspentOnly, SpentOnly
+    };
+    Q_ENUM(SpentFilter)
+
+    enum SortKey {
+        ByMmrIndex = 0, ByHeight
+    };
+    Q_ENUM(SortKey)
+
+    enum Roles {
+        CommitRole = Qt::UserRole + 1,
+        OutputTypeRole,
+        BlockHeightRole,
+        MmrIndexRole,
+        SpentRole,
+        ProofHashRole
+    };
+
+    explicit UtxoModel(QObject *parent = nullptr);
+    ~UtxoModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Neue Seite (onUnspentOutputsUpdated); Index und Filter asynchron
+    Q_INVOKABLE void setOutputs(const QVariantList &outputs);
+    Q_INVOKABLE void clear();
+    // Originalobjekt der sichtbaren Zeile row
+    Q_INVOKABLE QVariantMap get(int row) const;
+
+    int count() const { return m_rows.size(); }
+    int totalCount() const { return m_index ? m_index->records.size() : 0; }
+    bool busy() const { return m_pendingGeneration != m_shownGeneration; }
+
+    QString searchText() const { return m_searchText; }
+    void setSearchText(const QString &text);
+
+    // -1 = alle, sonst OutputType
+    int typeFilter() const { return m_typeFilter; }
+    void setTypeFilter(int type);
+
+    int spentFilter() const { return m_spentFilter; }
+    void setSpentFilter(int filter);
+
+    int sortKey() const { return m_sortKey; }
+    void setSortKey(int key);
+
+    bool descending() const { return m_descending; }
+    void setDescending(bool descending);
+
+    static QString commitHex(const QVariantMap &output);
+
+signals:
+    void countChanged();
+    void busyChanged();
+    void filterChanged();
+
+    void outputsRequested(const QVariantList &outputs, const UtxoQuery &query);
+    void queryRequested(const UtxoQuery &query);
+
+private slots:
+    void onResultReady(const UtxoResult &result);
+
+private:
+    UtxoQuery currentQuery();
+    void requery();
+
+    UtxoIndexPtr m_index;
+    QVector<int> m_rows;
+
+    QString m_searchText;
+    int m_typeFilter{-1};
+    int m_spentFilter{AnySpent};
+    int m_sortKey{ByMmrIndex};
+    bool m_descending{true};
+
+    quint64 m_pendingGeneration{0};
+    quint64 m_shownGeneration{0};
+
+#if QT_CONFIG(thread)
+    QThread m_thread;
+#endif
+    UtxoFilterWorker *m_worker{nullptr};
+};
+
+#endif // UTXOMODEL_H
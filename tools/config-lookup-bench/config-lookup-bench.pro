@@ -0,0 +1,18 @@
+# Microbenchmark für Config::value (siehe main.cpp)
+# Start:  qmake && make && ./config-lookup-bench ~/.grin/main/grin-server.toml
+
+QT = core
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+INCLUDEPATH += \
+    ../../src/config
+
+SOURCES += \
+    main.cpp \
+    ../../src/config/config.cpp \
+    ../../src/config/tomldocument.cpp
+
+HEADERS += \
+    ../../src/config/config.h \
+    ../../src/config/tomldocument.h
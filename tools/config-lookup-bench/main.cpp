@@ -0,0 +1,212 @@
+// Misst die Kosten von Config::value() auf einer echten grin-server.toml:
+// "vorher" parst wie der alte Config::value() bei jedem Aufruf den ganzen
+// Text (parseTomlFlatKeys), "nachher" ist der gecachte TomlDocument-Index.
+// Zusätzlich: eine Zeile ändern per setText() und per setValue().
+//
+// Start:  config-lookup-bench [grin-server.toml] [runden]
+// Ohne Pfad wird ~/.grin/main/grin-server.toml verwendet.
+
+#include "config.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QStringList>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// ---------- Config::value() vor dem Index-Cache ----------
+
+QString stripTomlComment(const QString &line)
+{
+    bool inStr = false;
+    bool escape = false;
+    QString out;
+    out.reserve(line.size());
+    for (int i = 0; i < line.size(); ++i) {
+        QChar c = line[i];
+        if (escape) {
+            out += c;
+            escape = false;
+            continue;
+        }
+        if (c == '\\') {
+            out += c;
+            escape = true;
+            continue;
+        }
+        if (c == '\"') {
+            inStr = !inStr;
+            out += c;
+            continue;
+        }
+        if (c == '#' && !inStr) {
+            break;
+        }
+        out += c;
+    }
+    return out;
+}
+
+int findEqualOutsideQuotes(const QString &line)
+{
+    bool inStr = false;
+    bool escape = false;
+    for (int i = 0; i < line.size(); ++i) {
+        QChar c = line[i];
+        if (escape) {
+            escape = false;
+            continue;
+        }
+        if (c == '\\') {
+            escape = true;
+            continue;
+        }
+        if (c == '\"') {
+            inStr = !inStr;
+            continue;
+        }
+        if (c == '=' && !inStr) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+QString unescapeTomlString(QString s)
+{
+    s.replace("\\\"", "\"");
+    s.replace("\\\\", "\\");
+    s.replace("\\n", "\n");
+    s.replace("\\r", "\r");
+    s.replace("\\t", "\t");
+    return s;
+}
+
+bool isQuoted(const QString &v)
+{
+    return v.size() >= 2 && v.startsWith('\"') && v.endsWith('\"');
+}
+
+QHash<QString, QString> parseTomlFlatKeys(const QString &text)
+{
+    QHash<QString, QString> map;
+    QStringList curTable;
+
+    const QStringList lines = text.split('\n');
+    for (const QString &raw : lines) {
+        QString line = stripTomlComment(raw).trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+        if (line.startsWith('[') && line.endsWith(']')) {
+            bool isArrayTable = (line.size() >= 4 && line.startsWith("[[") && line.endsWith("]]"));
+            QString inside = isArrayTable ? line.mid(2, line.size() - 4) : line.mid(1, line.size() - 2);
+            curTable = inside.trimmed().split('.', Qt::SkipEmptyParts);
+            continue;
+        }
+        int eq = findEqualOutsideQuotes(line);
+        if (eq < 0) {
+            continue;
+        }
+        QString k = line.left(eq).trimmed();
+        QString v = line.mid(eq + 1).trimmed();
+        if (k.isEmpty()) {
+            continue;
+        }
+        QStringList parts = curTable;
+        for (const QString &p : k.split('.', Qt::SkipEmptyParts)) {
+            parts << p;
+        }
+        map.insert(parts.join('.'), isQuoted(v) ? unescapeTomlString(v.mid(1, v.size() - 2)) : v);
+    }
+    return map;
+}
+
+QString baselineValue(const QString &text, const QString &key)
+{
+    return parseTomlFlatKeys(text).value(key);
+}
+
+// ---------- Messung ----------
+
+// Median über runs Durchläufe, je Durchlauf alle Keys einmal; Ergebnis in µs pro Lookup
+template<typename F>
+double measure(const QStringList &keys, int runs, F lookup)
+{
+    QVector<double> samples;
+    samples.reserve(runs);
+    volatile int sink = 0;
+    for (int r = 0; r < runs; ++r) {
+        QElapsedTimer t;
+        t.start();
+        for (const QString &key : keys) {
+            sink += lookup(key).size();
+        }
+        samples.append(double(t.nsecsElapsed()) / 1000.0 / keys.size());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples.at(samples.size() / 2);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    const QString path = args.size() > 1 ? args.at(1) : QDir::homePath() + "/.grin/main/grin-server.toml";
+    const int runs = args.size() > 2 ? qMax(1, args.at(2).toInt()) : 20;
+
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        std::fprintf(stderr, "cannot open %s\n", qPrintable(path));
+        return 1;
+    }
+    const QString text = QTextStream(&f).readAll();
+
+    Config config;
+    config.setText(text);
+    const QStringList keys = config.valuesWithPrefix(QString()).keys();
+    if (keys.isEmpty()) {
+        std::fprintf(stderr, "no keys in %s\n", qPrintable(path));
+        return 1;
+    }
+
+    std::printf("%s: %d lines, %d keys, %d runs (median)\n", qPrintable(path),
+                int(text.count('\n')), int(keys.size()), runs);
+
+    const double before = measure(keys, runs, [&text](const QString &key) {
+        return baselineValue(text, key);
+    });
+    const double after = measure(keys, runs, [&config](const QString &key) {
+        return config.value(key, QString()).toString();
+    });
+    std::printf("%-28s %12.2f us/lookup\n", "value() before (re-parse)", before);
+    std::printf("%-28s %12.2f us/lookup\n", "value() after (cached)", after);
+    std::printf("%-28s %12.1fx\n", "speedup", after > 0 ? before / after : 0.0);
+
+    // Eine Zeile ändern, danach erster Lookup (Neuaufbau des Index)
+    const QString key = keys.first();
+    QString edited = text;
+    const int at = edited.indexOf(key.section('.', -1));
+    const int eol = at >= 0 ? edited.indexOf('\n', at) : -1;
+    edited.insert(eol >= 0 ? eol : edited.size(), QStringLiteral(" # bench"));
+    QElapsedTimer t;
+    t.start();
+    config.setText(edited);
+    config.value(key, QString());
+    std::printf("%-28s %12.2f us\n", "setText() + first lookup", double(t.nsecsElapsed()) / 1000.0);
+
+    t.restart();
+    config.setValue(key, config.value(key, QString()));
+    config.value(key, QString());
+    std::printf("%-28s %12.2f us\n", "setValue() + lookup", double(t.nsecsElapsed()) / 1000.0);
+    return 0;
+}
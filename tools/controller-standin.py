@@ -0,0 +1,349 @@
+#!/usr/bin/env python3
+"""
+Lokaler Stand-in fuer den Grin-Node-Controller (nur zum Entwickeln/Testen der UI).
+
+Bedient die Endpunkte, die GrinNodeManager nutzt:
+  GET  /status
+  GET  /logs/<kind>?n=100
+  GET  /logs/<kind>/tail?cursor=<byte-offset>&n=100[&follow=0]
+  GET  /events[?since=<sequenz>][&follow=0]
+  POST /start/<kind>, /stop/<kind>, /restart/<kind>, /delete/<kind>
+
+/logs/<kind>/tail antwortet als text/event-stream: jedes Event traegt die neuen
+Zeilen als data:-Zeilen und als id den Byte-Offset dahinter. Mit "Accept: text/plain"
+(ohne text/event-stream) gibt es chunked text/plain plus X-Log-Cursor-Header.
+gzip wird verwendet, wenn der Client es per Accept-Encoding anbietet.
+
+/events ist ebenfalls text/event-stream: status, tip, peer und pool mit
+"<epoche>:<sequenz>" als id und JSON als data. Die Epoche wird bei jedem
+Start neu gewuerfelt, die Sequenz zaehlt darin fortlaufend. Fortgesetzt wird
+ab Last-Event-ID bzw. since=; stammt die id aus einer anderen Epoche, liegt
+die Nummer nicht mehr im Puffer (EVENT_BUFFER Events) oder hinter der letzten
+vergebenen, kommt zuerst ein "reset"-Event.
+
+Start:  python3 tools/controller-standin.py --port 8080 --lines-per-sec 20
+Dann in der App die Controller-URL auf http://localhost:8080/ setzen.
+"""
+
+import argparse
+import json
+import os
+import random
+import tempfile
+import threading
+import time
+import zlib
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import urlparse, parse_qs
+
+KINDS = ("rust", "grinpp")
+LEVELS = ("INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR")
+MODULES = ("grin_servers::common::adapters", "grin_chain::chain", "grin_p2p::peers",
+           "grin_pool::pool", "grin_servers::grin::sync::syncer")
+EVENT_BUFFER = 1000
+
+
+class NodeState:
+    def __init__(self, log_dir):
+        self.lock = threading.Lock()
+        self.cond = threading.Condition(self.lock)
+        self.running = {k: False for k in KINDS}
+        self.started_at = {k: 0.0 for k in KINDS}
+        self.log_paths = {k: os.path.join(log_dir, "%s.log" % k) for k in KINDS}
+        for p in self.log_paths.values():
+            open(p, "wb").close()
+        self.height = 2_900_000
+        self.pool_size = 0
+        self.events = []        # (seq, type, json)
+        self.next_seq = 1
+        self.epoch = os.urandom(4).hex()
+
+    def status(self):
+        with self.lock:
+            nodes = {}
+            for k in KINDS:
+                nodes[k] = {"running": self.running[k]}
+                if self.running[k]:
+                    nodes[k]["uptimeSec"] = int(time.time() - self.started_at[k])
+            return {"nodes": nodes}
+
+    def set_running(self, kind, running):
+        with self.lock:
+            self.running[kind] = running
+            self.started_at[kind] = time.time()
+        self.publish("status", self.status())
+
+    def publish(self, etype, payload):
+        with self.cond:
+            self.events.append((self.next_seq, etype, json.dumps(payload)))
+            self.next_seq += 1
+            del self.events[:-EVENT_BUFFER]
+            self.cond.notify_all()
+
+    def events_since(self, since):
+        """Events nach since; None, wenn since nicht mehr im Puffer liegt
+        oder von vor einem Neustart stammt (groesser als die letzte Nummer)."""
+        if since > self.next_seq - 1:
+            return None
+        if self.events and since < self.events[0][0] - 1:
+            return None
+        return [e for e in self.events if e[0] > since]
+
+    def append_log(self, kind, line):
+        with self.cond:
+            with open(self.log_paths[kind], "ab") as f:
+                f.write(line.encode("utf-8") + b"\n")
+            self.cond.notify_all()
+
+    def size(self, kind):
+        return os.path.getsize(self.log_paths[kind])
+
+    def read_from(self, kind, offset):
+        with open(self.log_paths[kind], "rb") as f:
+            f.seek(offset)
+            data = f.read()
+        # nur vollstaendige Zeilen ausliefern
+        end = data.rfind(b"\n")
+        return data[:end + 1] if end >= 0 else b""
+
+    def tail_offset(self, kind, n):
+        with open(self.log_paths[kind], "rb") as f:
+            data = f.read()
+        if n <= 0:
+            return len(data)
+        pos = len(data)
+        for _ in range(n + 1):
+            pos = data.rfind(b"\n", 0, pos)
+            if pos < 0:
+                return 0
+        return pos + 1
+
+
+def network_events(state):
+    """Peers kommen und gehen, Transaktionen landen im Pool."""
+    while True:
+        time.sleep(random.uniform(2.0, 8.0))
+        if random.random() < 0.5:
+            state.publish("peer", {
+                "addr": "10.0.%d.%d:3414" % (random.randint(0, 255), random.randint(0, 255)),
+                "connected": random.random() < 0.6})
+        else:
+            state.pool_size += random.randint(1, 3)
+            state.publish("pool", {"size": state.pool_size})
+
+
+def log_writer(state, rate):
+    interval = 1.0 / max(rate, 0.1)
+    while True:
+        time.sleep(interval)
+        for kind in KINDS:
+            if not state.running[kind]:
+                continue
+            ts = time.strftime("%Y%m%d %H:%M:%S", time.gmtime()) + ".%03d" % random.randint(0, 999)
+            if random.random() < 0.02:
+                state.height += 1
+                state.pool_size = max(0, state.pool_size - random.randint(0, 5))
+                state.publish("tip", {"height": state.height, "node": kind})
+                state.publish("pool", {"size": state.pool_size})
+            msg = "%s %s %s - Received block at height %d from peer 10.0.%d.%d" % (
+                ts, random.choice(LEVELS), random.choice(MODULES), state.height,
+                random.randint(0, 255), random.randint(0, 255))
+            state.append_log(kind, msg)
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    state = None
+
+    def log_message(self, fmt, *args):
+        pass
+
+    def send_json(self, obj, code=200):
+        body = json.dumps(obj).encode("utf-8")
+        self.send_response(code)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def do_GET(self):
+        url = urlparse(self.path)
+        parts = [p for p in url.path.split("/") if p]
+        query = parse_qs(url.query)
+
+        if parts == ["status"]:
+            return self.send_json(self.state.status())
+
+        if len(parts) == 2 and parts[0] == "logs" and parts[1] in KINDS:
+            n = int(query.get("n", ["100"])[0])
+            kind = parts[1]
+            data = self.state.read_from(kind, self.state.tail_offset(kind, n))
+            self.send_response(200)
+            self.send_header("Content-Type", "text/plain; charset=utf-8")
+            self.send_header("Content-Length", str(len(data)))
+            self.end_headers()
+            self.wfile.write(data)
+            return
+
+        if len(parts) == 3 and parts[0] == "logs" and parts[1] in KINDS and parts[2] == "tail":
+            return self.stream_tail(parts[1], query)
+
+        if parts == ["events"]:
+            return self.stream_events(query)
+
+        self.send_json({"error": "not found"}, 404)
+
+    def do_POST(self):
+        length = int(self.headers.get("Content-Length", "0") or 0)
+        if length:
+            self.rfile.read(length)
+        parts = [p for p in urlparse(self.path).path.split("/") if p]
+        if len(parts) == 2 and parts[1] in KINDS:
+            action, kind = parts
+            if action in ("start", "restart"):
+                self.state.set_running(kind, True)
+            elif action == "stop":
+                self.state.set_running(kind, False)
+            elif action != "delete":
+                return self.send_json({"error": "unknown action"}, 404)
+            return self.send_json({"ok": True, "action": action, "node": kind})
+        self.send_json({"error": "not found"}, 404)
+
+    # ---------------------------------------------------------------
+    # Streaming
+    # ---------------------------------------------------------------
+    def stream_tail(self, kind, query):
+        cursor = int(query.get("cursor", ["-1"])[0])
+        n = int(query.get("n", ["100"])[0])
+        follow = query.get("follow", ["1"])[0] != "0"
+        sse = "text/event-stream" in self.headers.get("Accept", "")
+        use_gzip = "gzip" in self.headers.get("Accept-Encoding", "")
+
+        if cursor < 0 or cursor > self.state.size(kind):
+            cursor = self.state.tail_offset(kind, n)
+
+        self.send_response(200)
+        self.send_header("Content-Type", "text/event-stream" if sse else "text/plain; charset=utf-8")
+        self.send_header("Cache-Control", "no-cache")
+        self.send_header("Transfer-Encoding", "chunked")
+        self.send_header("X-Log-Cursor", str(cursor))
+        if use_gzip:
+            self.send_header("Content-Encoding", "gzip")
+        self.end_headers()
+
+        gz = zlib.compressobj(6, zlib.DEFLATED, 31) if use_gzip else None
+
+        def write_chunk(raw, final=False):
+            if gz is not None:
+                raw = gz.compress(raw) + (gz.flush() if final else gz.flush(zlib.Z_SYNC_FLUSH))
+            if raw:
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(raw), raw))
+            if final:
+                self.wfile.write(b"0\r\n\r\n")
+            self.wfile.flush()
+
+        idle_deadline = time.time() + 25
+        try:
+            while True:
+                data = self.state.read_from(kind, cursor)
+                if data:
+                    cursor += len(data)
+                    if sse:
+                        lines = data.rstrip(b"\n").split(b"\n")
+                        payload = b"event: lines\nid: %d\n" % cursor
+                        payload += b"".join(b"data: " + l + b"\n" for l in lines) + b"\n"
+                    else:
+                        payload = data
+                    write_chunk(payload)
+                    idle_deadline = time.time() + 25
+                    if not follow:
+                        break
+                elif not follow or time.time() > idle_deadline:
+                    break
+                else:
+                    if sse:
+                        write_chunk(b": keep-alive\n\n")
+                    with self.state.cond:
+                        self.state.cond.wait(1.0)
+            write_chunk(b"", final=True)
+        except (BrokenPipeError, ConnectionResetError):
+            pass
+
+
+    def stream_events(self, query):
+        # "<epoche>:<sequenz>"; aeltere Clients schicken nur die Sequenz
+        epoch, _, seq = (self.headers.get("Last-Event-ID") or query.get("since", ["-1"])[0]).rpartition(":")
+        since = int(seq)
+        follow = query.get("follow", ["1"])[0] != "0"
+
+        self.send_response(200)
+        self.send_header("Content-Type", "text/event-stream")
+        self.send_header("Cache-Control", "no-cache")
+        self.send_header("Transfer-Encoding", "chunked")
+        self.end_headers()
+
+        def write_chunk(raw, final=False):
+            if raw:
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(raw), raw))
+            if final:
+                self.wfile.write(b"0\r\n\r\n")
+            self.wfile.flush()
+
+        with self.state.lock:
+            if since < 0:
+                since = self.state.next_seq - 1
+            elif (epoch and epoch != self.state.epoch) or self.state.events_since(since) is None:
+                # Neustart oder Luecke: Client muss neu laden, danach geht es ab hier weiter
+                write_chunk(b"event: reset\nid: %s:%d\ndata: {}\n\n"
+                            % (self.state.epoch.encode(), self.state.next_seq - 1))
+                since = self.state.next_seq - 1
+
+        idle_deadline = time.time() + 25
+        try:
+            while True:
+                with self.state.cond:
+                    pending = self.state.events_since(since) or []
+                    if not pending and time.time() <= idle_deadline:
+                        self.state.cond.wait(1.0)
+                        pending = self.state.events_since(since) or []
+                if pending:
+                    epoch_id = self.state.epoch.encode()
+                    payload = b"".join(b"event: %s\nid: %s:%d\ndata: %s\n\n"
+                                       % (t.encode(), epoch_id, seq, data.encode()) for seq, t, data in pending)
+                    since = pending[-1][0]
+                    write_chunk(payload)
+                    idle_deadline = time.time() + 25
+                    if not follow:
+                        break
+                elif time.time() > idle_deadline:
+                    break
+                elif follow:
+                    write_chunk(b": keep-alive\n\n")
+            write_chunk(b"", final=True)
+        except (BrokenPipeError, ConnectionResetError):
+            pass
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--port", type=int, default=8080)
+    ap.add_argument("--lines-per-sec", type=float, default=10.0)
+    ap.add_argument("--running", choices=KINDS, default="rust",
+                    help="Node, der beim Start als laufend gemeldet wird")
+    args = ap.parse_args()
+
+    state = NodeState(tempfile.mkdtemp(prefix="grin-standin-"))
+    state.set_running(args.running, True)
+    Handler.state = state
+
+    threading.Thread(target=log_writer, args=(state, args.lines_per_sec), daemon=True).start()
+    threading.Thread(target=network_events, args=(state,), daemon=True).start()
+
+    server = ThreadingHTTPServer(("127.0.0.1", args.port), Handler)
+    print("controller stand-in on http://127.0.0.1:%d/ (logs in %s)"
+          % (args.port, os.path.dirname(state.log_paths["rust"])))
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
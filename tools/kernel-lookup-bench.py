@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Misst die Latenz von get_kernel (v2/foreign) abhaengig von der Breite des
+Hoehenbereichs - als Grundlage fuer den KernelIndex in ChainRpc.
+
+Fuer einen bekannten Kernel (Excess + Hoehe) wird [hoehe - breite, hoehe]
+fuer jede Breite mehrfach abgefragt. Breite 0 entspricht dem Pfad mit
+Index-Treffer (findKernelAsync fragt genau eine Hoehe ab), "tip" dem Pfad
+ohne Index (min_height = 0, max_height = null).
+
+Start:  python3 tools/kernel-lookup-bench.py --url http://localhost:8080/v2/foreign
+Ohne --excess/--height wird der erste Kernel des Blocks tip - 100 verwendet.
+"""
+
+import argparse
+import json
+import statistics
+import time
+import urllib.request
+
+
+def rpc(url, method, params):
+    body = json.dumps({"jsonrpc": "2.0", "id": 1, "method": method, "params": params}).encode()
+    req = urllib.request.Request(url, data=body, headers={"Content-Type": "application/json"})
+    with urllib.request.urlopen(req, timeout=600) as resp:
+        reply = json.loads(resp.read())
+    if "error" in reply:
+        raise RuntimeError(reply["error"])
+    result = reply.get("result", {})
+    if "Err" in result:
+        raise RuntimeError(result["Err"])
+    return result.get("Ok")
+
+
+def pick_kernel(url):
+    tip = rpc(url, "get_tip", [])["height"]
+    height = max(0, tip - 100)
+    block = rpc(url, "get_block", [height, None, None])
+    return block["kernels"][0]["excess"], height
+
+
+def measure(url, excess, low, high, runs):
+    samples = []
+    for _ in range(runs):
+        start = time.perf_counter()
+        located = rpc(url, "get_kernel", [excess, low, high])
+        samples.append((time.perf_counter() - start) * 1000.0)
+        if not located:
+            raise RuntimeError("kernel not found in [%s, %s]" % (low, high))
+    return statistics.median(samples), max(samples)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--url", default="http://localhost:8080/v2/foreign")
+    parser.add_argument("--excess")
+    parser.add_argument("--height", type=int)
+    parser.add_argument("--runs", type=int, default=5)
+    parser.add_argument("--widths", default="0,10,100,1000,10000,100000")
+    args = parser.parse_args()
+
+    excess, height = args.excess, args.height
+    if not excess or height is None:
+        excess, height = pick_kernel(args.url)
+    print("kernel %s at height %d, %d runs each" % (excess, height, args.runs))
+    print("%10s %12s %12s" % ("width", "median ms", "max ms"))
+
+    for width in [int(w) for w in args.widths.split(",")]:
+        low = max(0, height - width)
+        median, worst = measure(args.url, excess, low, height, args.runs)
+        print("%10d %12.1f %12.1f" % (height - low, median, worst))
+
+    median, worst = measure(args.url, excess, 0, None, args.runs)
+    print("%10s %12.1f %12.1f" % ("tip", median, worst))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,79 @@
+// Prüft, dass setValue() einen Text aus einem Textfeld nur dann unquoted
+// schreibt, wenn er ein gültiger TOML-Skalar ist, und dass das Ergebnis
+// beim erneuten Einlesen denselben Wert liefert.
+//
+// Start:  tomldocument-test   (Exit-Code 0 = alle Fälle bestanden)
+
+#include "tomldocument.h"
+
+#include <QCoreApplication>
+#include <QString>
+
+#include <cstdio>
+
+namespace {
+
+const char kInput[] =
+    "# Grin server config\n"
+    "[server]\n"
+    "api_http_addr = \"127.0.0.1:3413\"\n"
+    "p2p_port = 3414 # inline comment\n"
+    "ratio = 1.5\n";
+
+struct Case {
+    const char *text;       // neuer Wert aus dem Textfeld
+    bool quoted;            // erwartet beim erneuten Einlesen
+    const char *literal;    // erwartete Zeile in toString()
+};
+
+int failures = 0;
+
+void check(bool ok, const Case &c, const char *what)
+{
+    if (!ok) {
+        std::fprintf(stderr, "FAIL %-12s %s\n", c.text, what);
+        ++failures;
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const Case cases[] = {
+        { "abc def", true, "p2p_port = \"abc def\" # inline comment" },
+        { "1.2.3", true, "p2p_port = \"1.2.3\" # inline comment" },
+        { "foo=bar", true, "p2p_port = \"foo=bar\" # inline comment" },
+        { "", true, "p2p_port = \"\" # inline comment" },
+        { "3415", false, "p2p_port = 3415 # inline comment" },
+        { "1_000", false, "p2p_port = 1_000 # inline comment" },
+        { "true", false, "p2p_port = true # inline comment" },
+    };
+
+    for (const Case &c : cases) {
+        TomlDocument doc;
+        doc.setText(QString::fromUtf8(kInput));
+        check(doc.setValue("server.p2p_port", QString::fromUtf8(c.text)), c, "setValue failed");
+
+        const QString out = doc.toString();
+        check(out.contains(QString::fromUtf8(c.literal)), c, "unexpected literal");
+        check(out.contains("api_http_addr = \"127.0.0.1:3413\"\n")
+              && out.contains("ratio = 1.5"), c, "other lines changed");
+
+        TomlDocument reread;
+        reread.setText(out);
+        const TomlDocument::Value *v = reread.find("server.p2p_port");
+        check(v != nullptr, c, "key lost");
+        if (v) {
+            check(v->text == QString::fromUtf8(c.text), c, "value differs after reread");
+            check(v->quoted == c.quoted, c, "quoting differs after reread");
+        }
+        const TomlDocument::Value *ratio = reread.find("server.ratio");
+        check(ratio && ratio->text == "1.5" && !ratio->quoted, c, "neighbour key changed");
+    }
+
+    std::printf("%s (%d failures)\n", failures == 0 ? "PASS" : "FAIL", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+# Round-Trip-Test für TomlDocument::setValue (siehe main.cpp)
+# Start:  qmake && make && ./tomldocument-test   (Exit-Code 0 = bestanden)
+
+QT = core
+CONFIG += console c++17
+CONFIG -= app_bundle
+
+INCLUDEPATH += \
+    ../../src/config
+
+SOURCES += \
+    main.cpp \
+    ../../src/config/tomldocument.cpp
+
+HEADERS += \
+    ../../src/config/tomldocument.h